@@ -0,0 +1,295 @@
+#include "H9ConvolutionReverb.h"
+#include "Audio/H9Resampler.h"
+#include "Core/H9Trace.h"
+
+namespace
+{
+    constexpr float trimFloor    = 1.0e-4f;   // -80 dB below the peak
+    constexpr float targetEnergy = 0.1f;      // per channel — near the FDN's level
+    constexpr float silenceFloor = 1.0e-5f;
+
+    bool isSilent(const float* data, int numSamples) noexcept
+    {
+        const auto range = juce::FloatVectorOperations::findMinAndMax(data, numSamples);
+        return range.getStart() > -silenceFloor && range.getEnd() < silenceFloor;
+    }
+}
+
+// ── Shared state ─────────────────────────────────────────────────────────────
+// Outlives the reverb if a job is still running when the plugin is deleted.
+
+struct H9ConvolutionReverb::Shared
+{
+    juce::CriticalSection lock;
+    H9ConvolutionReverb* owner { nullptr };      // cleared by ~H9ConvolutionReverb
+    std::unique_ptr<Response> completed;         // guarded by lock
+};
+
+// ── Background job ───────────────────────────────────────────────────────────
+
+class H9ConvolutionReverb::Job
+{
+public:
+    Job(std::shared_ptr<Shared> s, juce::File f, float g, double rate, int gen)
+        : shared(std::move(s)), file(std::move(f)), gain(g), targetRate(rate), generation(gen) {}
+
+    void run(const H9JobToken& token)
+    {
+        H9_TRACE_SCOPE("impulse response load");
+
+        auto ir = read();
+        if (ir.getNumSamples() == 0 || token.isCancelled())
+            return;
+
+        shape(ir);
+        if (ir.getNumSamples() == 0 || token.isCancelled())
+            return;
+
+        auto response = std::make_unique<Response>(ir, generation);
+        if (token.isCancelled())
+            return;
+
+        const juce::ScopedLock sl(shared->lock);
+        if (shared->owner != nullptr)
+        {
+            shared->completed = std::move(response);
+            shared->owner->triggerAsyncUpdate();
+        }
+    }
+
+private:
+    std::shared_ptr<Shared> shared;
+    juce::File file;
+    float  gain;
+    double targetRate;
+    int    generation;
+
+    juce::AudioBuffer<float> read() const
+    {
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(file));
+        if (reader == nullptr || reader->lengthInSamples <= 0 || reader->sampleRate <= 0.0)
+            return {};
+
+        const int channels = juce::jlimit(1, H9PartitionedConvolver::maxChannels, (int)reader->numChannels);
+        const int length   = (int)juce::jmin(reader->lengthInSamples,
+                                             (juce::int64)(maxSeconds * reader->sampleRate) + 1);
+
+        juce::AudioBuffer<float> ir(channels, length);
+        reader->read(&ir, 0, length, 0, true, channels > 1);
+
+        if (targetRate > 0.0 && H9Resampler::needsConversion(reader->sampleRate, targetRate))
+            ir = H9Resampler::process(ir, reader->sampleRate, targetRate);
+
+        return ir;
+    }
+
+    // Cuts the inaudible end (it would cost partitions for nothing), then
+    // scales to the target energy and the manifest's gain
+    void shape(juce::AudioBuffer<float>& ir) const
+    {
+        const float peak = ir.getMagnitude(0, ir.getNumSamples());
+        if (peak <= 0.0f)
+        {
+            ir.setSize(ir.getNumChannels(), 0);
+            return;
+        }
+
+        int end = 0;
+        for (int c = 0; c < ir.getNumChannels(); ++c)
+        {
+            const float* d = ir.getReadPointer(c);
+            for (int i = ir.getNumSamples(); --i >= end;)
+                if (std::abs(d[i]) > trimFloor * peak)
+                {
+                    end = i + 1;
+                    break;
+                }
+        }
+        ir.setSize(ir.getNumChannels(), end, true);
+
+        double energy = 0.0;
+        for (int c = 0; c < ir.getNumChannels(); ++c)
+            for (int i = 0; i < end; ++i)
+                energy += (double)ir.getSample(c, i) * ir.getSample(c, i);
+        energy /= ir.getNumChannels();
+
+        ir.applyGain(gain * (float)std::sqrt(targetEnergy / juce::jmax(1.0e-12, energy)));
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(Job)
+};
+
+// ── H9ConvolutionReverb ──────────────────────────────────────────────────────
+
+H9ConvolutionReverb::H9ConvolutionReverb()
+    : shared(std::make_shared<Shared>())
+{
+    shared->owner = this;
+}
+
+H9ConvolutionReverb::~H9ConvolutionReverb()
+{
+    {
+        const juce::ScopedLock sl(shared->lock);
+        shared->owner = nullptr;
+    }
+    token.cancel();
+    cancelPendingUpdate();
+}
+
+void H9ConvolutionReverb::prepare(double sr, int maxBlockSize)
+{
+    wetBus.setSize(2, juce::jmax(1, maxBlockSize));
+    wet.reset(sr, 0.05);
+    reset();
+
+    if (sampleRate.exchange(sr) != sr && file.existsAsFile())
+        startJob();
+}
+
+void H9ConvolutionReverb::load(const juce::File& newFile, float newGain)
+{
+    if (newFile == file && newGain == gain && loadedRate == sampleRate.load())
+        return;
+
+    file = newFile;
+    gain = newGain;
+    startJob();
+}
+
+void H9ConvolutionReverb::startJob()
+{
+    const int generation = ++requested;
+    loadedRate = sampleRate.load();
+
+    token.cancel();
+    token = {};
+
+    if (!file.existsAsFile())
+    {
+        infoSeconds.store(0.0);
+        infoPartitions.store(0);
+        infoSegments.store(0);
+        return;
+    }
+
+    auto job = std::make_shared<Job>(shared, file, gain, loadedRate, generation);
+    jobs->submit(H9JobSystem::Priority::user, "impulse response load", token,
+                 [job](const H9JobToken& t) { job->run(t); });
+}
+
+void H9ConvolutionReverb::handleAsyncUpdate()
+{
+    std::unique_ptr<Response> response;
+    {
+        const juce::ScopedLock sl(shared->lock);
+        response = std::move(shared->completed);
+    }
+
+    if (response == nullptr || response->generation != requested.load())
+        return;
+
+    const auto& c = response->convolver;
+    infoSeconds.store(loadedRate > 0.0 ? c.getLength() / loadedRate : 0.0);
+    infoPartitions.store(c.getNumPartitions());
+    infoSegments.store(c.getNumSegments());
+
+    responses.publish(std::move(response));
+}
+
+H9ConvolutionReverb::Info H9ConvolutionReverb::getInfo() const
+{
+    return { infoSeconds.load(), infoPartitions.load(), infoSegments.load() };
+}
+
+double H9ConvolutionReverb::getTailSeconds() const
+{
+    const double seconds = infoSeconds.load();
+    const double rate    = sampleRate.load();
+    if (seconds <= 0.0 || rate <= 0.0)
+        return 0.0;
+
+    return seconds + H9PartitionedConvolver::partitionSizes[H9PartitionedConvolver::numSizes - 1] / rate;
+}
+
+// ── Audio thread ─────────────────────────────────────────────────────────────
+
+bool H9ConvolutionReverb::beginBlock() noexcept
+{
+    bool changed = false;
+    responses.acquire(changed);
+
+    // A new response starts from silence
+    if (changed)
+    {
+        cleared = true;
+        quietSamples = 0;
+    }
+
+    return isReady();
+}
+
+bool H9ConvolutionReverb::isReady() const noexcept
+{
+    auto* r = responses.get();
+    return r != nullptr && r->generation == requested.load(std::memory_order_relaxed);
+}
+
+void H9ConvolutionReverb::reset() noexcept
+{
+    if (auto* r = responses.get())
+        r->convolver.reset();
+
+    cleared = true;
+    quietSamples = 0;
+    wet.setCurrentAndTargetValue(wet.getTargetValue());
+}
+
+void H9ConvolutionReverb::process(float* left, float* right, int numSamples) noexcept
+{
+    auto* r = responses.get();
+    if (r == nullptr || numSamples <= 0)
+        return;
+
+    auto& convolver = r->convolver;
+
+    if (wet.getTargetValue() <= 0.0f && !wet.isSmoothing())
+    {
+        if (!cleared)
+            reset();
+        return;
+    }
+
+    const bool silent = isSilent(left, numSamples) && (right == nullptr || isSilent(right, numSamples));
+    if (silent && quietSamples > convolver.getTailSamples())
+    {
+        wet.skip(numSamples);
+        return;
+    }
+
+    quietSamples = silent ? juce::jmin(quietSamples + numSamples, convolver.getTailSamples() + 1) : 0;
+    cleared = false;
+
+    // Chunked by the wet bus, like the processor's pad bus
+    const int chunk = wetBus.getNumSamples();
+    auto* wetL = wetBus.getWritePointer(0);
+    auto* wetR = wetBus.getWritePointer(1);
+
+    for (int pos = 0; pos < numSamples; pos += chunk)
+    {
+        const int n = juce::jmin(chunk, numSamples - pos);
+        convolver.process(left + pos, right != nullptr ? right + pos : nullptr,
+                          wetL, right != nullptr ? wetR : nullptr, n);
+
+        for (int i = 0; i < n; ++i)
+        {
+            const float g = wet.getNextValue();
+            left[pos + i] += g * wetL[i];
+            if (right != nullptr)
+                right[pos + i] += g * wetR[i];
+        }
+    }
+}
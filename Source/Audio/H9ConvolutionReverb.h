@@ -0,0 +1,102 @@
+#pragma once
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_events/juce_events.h>
+#include "Audio/H9PartitionedConvolver.h"
+#include "Core/H9JobSystem.h"
+#include "Core/H9ObjectHandoff.h"
+
+// ── H9ConvolutionReverb ─────────────────────────────────────────────────────
+// Convolution with a pack's impulse response, the Atmosphere reverb's
+// alternative to H9FdnReverb. load() reads the file as a user-priority job
+// on H9JobSystem, converts it to the host rate, trims its silent tail,
+// normalises it to roughly the algorithmic reverb's level and partitions
+// it into an H9PartitionedConvolver, which is handed to the audio thread
+// through H9ObjectHandoff. Only the newest request is used; until it is
+// ready (or when it fails) isReady() is false and the processor falls back
+// to the FDN.
+//
+// process() adds the wet signal to its input. It returns straight away
+// while wet is zero, and while the input has been silent for longer than
+// the response.
+
+class H9ConvolutionReverb : private juce::AsyncUpdater
+{
+public:
+    static constexpr double maxSeconds = 8.0;   // longer responses are cut
+
+    struct Info
+    {
+        double seconds    { 0.0 };   // 0 = no response loaded
+        int    partitions { 0 };     // FFT partitions, all sizes
+        int    segments   { 0 };
+    };
+
+    H9ConvolutionReverb();
+    ~H9ConvolutionReverb() override;
+
+    // Non-RT. Reloads the response if the rate has changed.
+    void prepare(double sampleRate, int maxBlockSize);
+
+    // ── Message thread ──────────────────────────────────────────────────────
+
+    // A file that doesn't exist unloads. `gain` applies on top of the
+    // normalisation (pack manifests set it).
+    void load(const juce::File& file, float gain);
+    void collectGarbage() { responses.collectGarbage(); }
+
+    Info getInfo() const;   // any thread — the response in use once ready
+
+    // Any thread: how long output can last after the input stops — the
+    // response plus one 4096-sample partition. 0 with no response.
+    double getTailSeconds() const;
+
+    // ── Audio thread ────────────────────────────────────────────────────────
+
+    // Adopts a newly loaded response; returns isReady()
+    bool beginBlock() noexcept;
+    bool isReady() const noexcept;
+
+    void setWetLevel(float wetLevel) noexcept { wet.setTargetValue(juce::jmax(0.0f, wetLevel)); }
+    void reset() noexcept;
+
+    // `right` may be nullptr for a mono bus
+    void process(float* left, float* right, int numSamples) noexcept;
+
+private:
+    struct Response
+    {
+        Response(const juce::AudioBuffer<float>& ir, int g) : convolver(ir), generation(g) {}
+
+        H9PartitionedConvolver convolver;
+        const int generation;
+    };
+
+    struct Shared;
+    class Job;
+
+    std::shared_ptr<Shared> shared;
+    juce::SharedResourcePointer<H9JobSystem> jobs;
+    H9JobToken token;
+
+    // Message thread
+    juce::File  file;
+    float       gain { 1.0f };
+    double      loadedRate { 0.0 };
+
+    std::atomic<double> sampleRate { 0.0 };
+    std::atomic<int>    requested  { 0 };    // generation the audio thread should use
+    std::atomic<double> infoSeconds { 0.0 };
+    std::atomic<int>    infoPartitions { 0 }, infoSegments { 0 };
+
+    // Audio thread
+    H9ObjectHandoff<Response> responses;
+    juce::AudioBuffer<float> wetBus;
+    juce::SmoothedValue<float> wet { 0.0f };
+    bool cleared      { true };
+    int  quietSamples { 0 };   // consecutive silent input samples
+
+    void startJob();
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE(H9ConvolutionReverb)
+};
@@ -0,0 +1,259 @@
+#include "H9DiskStreamer.h"
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  I/O scheduler — one thread per process
+// ═══════════════════════════════════════════════════════════════════════════════
+
+H9DiskIoScheduler::H9DiskIoScheduler()
+    : juce::Thread("HALO9 disk streaming")
+{
+    startThread(juce::Thread::Priority::high);
+}
+
+H9DiskIoScheduler::~H9DiskIoScheduler()
+{
+    stopThread(2000);
+}
+
+void H9DiskIoScheduler::add(H9DiskStreams* c)
+{
+    const juce::ScopedLock sl(lock);
+    clients.addIfNotAlreadyThere(c);
+}
+
+void H9DiskIoScheduler::remove(H9DiskStreams* c)
+{
+    const juce::ScopedLock sl(lock);
+    clients.removeFirstMatchingValue(c);
+}
+
+void H9DiskIoScheduler::run()
+{
+    while (!threadShouldExit())
+    {
+        bool busy = false;
+        {
+            const juce::ScopedLock sl(lock);
+
+            // Serve the stream closest to running dry, one chunk at a time,
+            // until every stream is topped up
+            for (;;)
+            {
+                H9DiskStreams* best = nullptr;
+                int bestStream = -1;
+                juce::int64 bestBuffered = std::numeric_limits<juce::int64>::max();
+
+                for (auto* c : clients)
+                {
+                    for (int i = 0; i < (int)c->streams.size(); ++i)
+                    {
+                        const auto buffered = c->getBufferedFrames(i);
+                        if (buffered >= 0 && buffered < bestBuffered)
+                        {
+                            best = c;
+                            bestStream = i;
+                            bestBuffered = buffered;
+                        }
+                    }
+                    busy = busy || c->anyActive();
+                }
+
+                if (best == nullptr || threadShouldExit() || !best->fill(bestStream))
+                    break;
+            }
+        }
+
+        // Heads cover the first few thousand frames, so a short poll is
+        // plenty; idle instances cost a wake-up every 10 ms
+        wait(busy ? 1 : 10);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  Per-sampler streams
+// ═══════════════════════════════════════════════════════════════════════════════
+
+H9DiskStreams::H9DiskStreams(int numStreams)
+{
+    for (int i = 0; i < numStreams; ++i)
+        streams.push_back(std::make_unique<Stream>());
+
+    scheduler->add(this);
+}
+
+H9DiskStreams::~H9DiskStreams()
+{
+    scheduler->remove(this);
+}
+
+// ── Audio thread ─────────────────────────────────────────────────────────────
+
+void H9DiskStreams::start(int index, const H9StreamSource* source, int firstFrame) noexcept
+{
+    auto& s = *streams[(size_t)index];
+
+    s.source.store(source, std::memory_order_relaxed);
+    s.readFrame.store(firstFrame, std::memory_order_relaxed);
+    const auto gen = s.generation.fetch_add(1, std::memory_order_release) + 1;
+    s.writeState.store(pack(gen, firstFrame), std::memory_order_release);
+    s.active.store(true, std::memory_order_release);
+}
+
+void H9DiskStreams::stop(int index) noexcept
+{
+    auto& s = *streams[(size_t)index];
+    s.active.store(false, std::memory_order_release);
+    s.generation.fetch_add(1, std::memory_order_release);
+}
+
+int H9DiskStreams::read(int index, int frame, int maxFrames, float* left, float* right) noexcept
+{
+    auto& s = *streams[(size_t)index];
+
+    const auto state = s.writeState.load(std::memory_order_acquire);
+    if ((state >> frameBits) != (s.generation.load(std::memory_order_relaxed) & 0xffffffu))
+        return 0;
+
+    const auto written = (juce::int64)(state & frameMask);
+    const int n = (int)juce::jlimit((juce::int64)0, (juce::int64)maxFrames, written - frame);
+
+    const int slot  = frame % ringFrames;
+    const int first = juce::jmin(n, ringFrames - slot);
+
+    juce::FloatVectorOperations::copy(left,  s.ring.getReadPointer(0, slot), first);
+    juce::FloatVectorOperations::copy(right, s.ring.getReadPointer(1, slot), first);
+    if (n > first)
+    {
+        juce::FloatVectorOperations::copy(left  + first, s.ring.getReadPointer(0), n - first);
+        juce::FloatVectorOperations::copy(right + first, s.ring.getReadPointer(1), n - first);
+    }
+    return n;
+}
+
+void H9DiskStreams::consumed(int index, int frame) noexcept
+{
+    streams[(size_t)index]->readFrame.store(frame, std::memory_order_release);
+}
+
+void H9DiskStreams::reportUnderrun(int index, int frames) noexcept
+{
+    auto& s = *streams[(size_t)index];
+    s.underrunEvents.store(s.underrunEvents.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    s.underrunFrames.store(s.underrunFrames.load(std::memory_order_relaxed) + frames, std::memory_order_relaxed);
+}
+
+// ── Stats ────────────────────────────────────────────────────────────────────
+
+H9DiskStreams::Stats H9DiskStreams::getStreamStats(int index) const noexcept
+{
+    auto& s = *streams[(size_t)index];
+
+    Stats st;
+    st.activeStreams  = s.active.load(std::memory_order_relaxed) ? 1 : 0;
+    st.underrunEvents = s.underrunEvents.load(std::memory_order_relaxed);
+    st.underrunFrames = s.underrunFrames.load(std::memory_order_relaxed);
+    st.bytesRead      = s.bytesRead.load(std::memory_order_relaxed);
+    return st;
+}
+
+H9DiskStreams::Stats H9DiskStreams::getStats() const noexcept
+{
+    Stats total;
+    for (int i = 0; i < (int)streams.size(); ++i)
+    {
+        const auto st = getStreamStats(i);
+        total.activeStreams  += st.activeStreams;
+        total.underrunEvents += st.underrunEvents;
+        total.underrunFrames += st.underrunFrames;
+        total.bytesRead      += st.bytesRead;
+    }
+    return total;
+}
+
+// ── I/O thread ───────────────────────────────────────────────────────────────
+
+bool H9DiskStreams::anyActive() const noexcept
+{
+    for (auto& s : streams)
+        if (s->active.load(std::memory_order_relaxed))
+            return true;
+    return false;
+}
+
+juce::int64 H9DiskStreams::getBufferedFrames(int index) const noexcept
+{
+    auto& s = *streams[(size_t)index];
+    if (!s.active.load(std::memory_order_acquire))
+        return -1;
+
+    const auto* source = s.source.load(std::memory_order_acquire);
+    if (source == nullptr)
+        return -1;
+
+    const auto written = (juce::int64)(s.writeState.load(std::memory_order_acquire) & frameMask);
+    const auto played  = s.readFrame.load(std::memory_order_acquire);
+    const auto next    = juce::jmax(written, played);
+
+    const auto limit = juce::jmin(played + ringFrames, (juce::int64)source->frames);
+    if (limit - next < juce::jmin((juce::int64)chunkFrames, source->frames - next) || next >= source->frames)
+        return -1;   // full, or the whole sample is already buffered
+
+    return next - played;
+}
+
+bool H9DiskStreams::fill(int index)
+{
+    auto& s = *streams[(size_t)index];
+
+    // Snapshot generation / source consistently — the audio thread may be
+    // restarting this stream right now
+    const auto  gen = s.generation.load(std::memory_order_acquire);
+    const auto* src = s.source.load(std::memory_order_acquire);
+    if (src == nullptr || s.generation.load(std::memory_order_acquire) != gen
+        || !s.active.load(std::memory_order_acquire))
+        return false;
+
+    const auto state = s.writeState.load(std::memory_order_acquire);
+    if ((state >> frameBits) != (gen & 0xffffffu))
+        return false;
+
+    const auto played = s.readFrame.load(std::memory_order_acquire);
+    auto from = juce::jmax((juce::int64)(state & frameMask), played);   // skip frames lost to an underrun
+    const auto limit = juce::jmin(played + ringFrames, (juce::int64)src->frames);
+    const int n = (int)juce::jmin((juce::int64)chunkFrames, limit - from);
+    if (n <= 0 || src->input == nullptr)
+        return false;
+
+    s.readBuffer.resize((size_t)n);
+    const int channels = juce::jlimit(1, 2, src->channels);
+
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        const int srcCh = juce::jmin(ch, channels - 1);
+        const auto offset = src->dataOffset
+                          + ((juce::int64)srcCh * src->frames + from) * (juce::int64)sizeof(float);
+
+        if (ch == 0 || srcCh != 0)
+        {
+            // A failed read publishes silence rather than stalling the voice
+            const int bytes = src->input->setPosition(offset)
+                            ? juce::jmax(0, src->input->read(s.readBuffer.data(), n * (int)sizeof(float)))
+                            : 0;
+            if (bytes < n * (int)sizeof(float))
+                std::fill(s.readBuffer.begin() + bytes / (int)sizeof(float), s.readBuffer.end(), 0.0f);
+            s.bytesRead.store(s.bytesRead.load(std::memory_order_relaxed) + bytes, std::memory_order_relaxed);
+        }
+
+        const int slot  = (int)(from % ringFrames);
+        const int first = juce::jmin(n, ringFrames - slot);
+        juce::FloatVectorOperations::copy(s.ring.getWritePointer(ch, slot), s.readBuffer.data(), first);
+        if (n > first)
+            juce::FloatVectorOperations::copy(s.ring.getWritePointer(ch), s.readBuffer.data() + first, n - first);
+    }
+
+    // Publish only if the voice wasn't restarted / stopped meanwhile
+    auto expected = state;
+    s.writeState.compare_exchange_strong(expected, pack(gen, from + n),
+                                         std::memory_order_release, std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,134 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+
+// ── Direct-from-disk playback ───────────────────────────────────────────────
+// Pads of a streaming kit keep only their first `preloadFrames` resident;
+// the rest is read from the sample's raw host-rate file (an H9ResampleCache
+// entry) into a per-voice ring buffer as soon as the voice starts.
+//
+//   audio thread   start() / stop() / read() / consumed() — wait-free
+//   I/O thread     one per process (H9DiskIoScheduler); each pass refills
+//                  the stream, across every plugin instance, with the
+//                  fewest frames buffered ahead of its play head
+//
+// A voice that catches up with its ring plays silence for the missing
+// frames and the shortfall is counted per voice (underrun accounting).
+
+// Where the streamed part of a pad lives. Owned by H9PadSample; deleted only
+// under the scheduler's source lock.
+struct H9StreamSource
+{
+    juce::File  file;
+    juce::int64 dataOffset { 0 };   // byte offset of channel 0, frame 0
+    int         frames     { 0 };   // frames per channel (whole sample)
+    int         channels   { 1 };   // planar float32
+
+    // Opened by the loader and read only by the I/O thread. Holding it open
+    // also keeps a pruned or replaced cache entry readable.
+    std::unique_ptr<juce::FileInputStream> input;
+};
+
+class H9DiskStreams;
+
+class H9DiskIoScheduler : private juce::Thread
+{
+public:
+    H9DiskIoScheduler();
+    ~H9DiskIoScheduler() override;
+
+    void add(H9DiskStreams*);
+    void remove(H9DiskStreams*);
+
+    // Held by the I/O thread while it touches stream sources, and by
+    // samplers while they delete sample sets that own them
+    juce::CriticalSection& getSourceLock() noexcept { return lock; }
+
+private:
+    juce::CriticalSection lock;
+    juce::Array<H9DiskStreams*> clients;
+
+    void run() override;
+
+    JUCE_DECLARE_NON_COPYABLE(H9DiskIoScheduler)
+};
+
+class H9DiskStreams
+{
+public:
+    static constexpr int ringFrames  = 32768;
+    static constexpr int chunkFrames = 4096;
+
+    explicit H9DiskStreams(int numStreams);
+    ~H9DiskStreams();
+
+    juce::CriticalSection& getSourceLock() noexcept { return scheduler->getSourceLock(); }
+
+    // ── Audio thread ────────────────────────────────────────────────────────
+
+    // Begins streaming `source` from `firstFrame` (the end of the resident head)
+    void start(int stream, const H9StreamSource* source, int firstFrame) noexcept;
+    void stop(int stream) noexcept;
+
+    // Copies up to `maxFrames` frames starting at `frame` into left / right.
+    // Returns how many were buffered (0 → underrun if the sample isn't over).
+    int read(int stream, int frame, int maxFrames, float* left, float* right) noexcept;
+
+    // Everything before `frame` has been played; the ring may reuse it
+    void consumed(int stream, int frame) noexcept;
+
+    void reportUnderrun(int stream, int frames) noexcept;
+
+    // ── Any thread ──────────────────────────────────────────────────────────
+
+    struct Stats
+    {
+        int         activeStreams  { 0 };
+        juce::int64 underrunEvents { 0 };
+        juce::int64 underrunFrames { 0 };
+        juce::int64 bytesRead      { 0 };
+    };
+
+    Stats getStats() const noexcept;
+    Stats getStreamStats(int stream) const noexcept;
+
+private:
+    friend class H9DiskIoScheduler;
+
+    // writeState packs (generation << 40 | next frame to be written), so a
+    // stale I/O write for a stopped / restarted voice can never publish
+    static constexpr int frameBits = 40;
+    static constexpr juce::uint64 frameMask = ((juce::uint64)1 << frameBits) - 1;
+
+    struct Stream
+    {
+        std::atomic<const H9StreamSource*> source { nullptr };
+        std::atomic<juce::uint32> generation { 0 };
+        std::atomic<bool>         active     { false };
+        std::atomic<juce::uint64> writeState { 0 };
+        std::atomic<juce::int64>  readFrame  { 0 };
+
+        std::atomic<juce::int64> underrunEvents { 0 };
+        std::atomic<juce::int64> underrunFrames { 0 };
+        std::atomic<juce::int64> bytesRead      { 0 };
+
+        juce::AudioBuffer<float> ring { 2, ringFrames };
+
+        std::vector<float> readBuffer;   // I/O thread only
+    };
+
+    std::vector<std::unique_ptr<Stream>> streams;
+    juce::SharedResourcePointer<H9DiskIoScheduler> scheduler;
+
+    static juce::uint64 pack(juce::uint32 generation, juce::int64 frame) noexcept
+    {
+        return ((juce::uint64)(generation & 0xffffffu) << frameBits) | ((juce::uint64)frame & frameMask);
+    }
+
+    // I/O thread, under the source lock: frames buffered ahead of the play
+    // head, or -1 if the stream needs nothing
+    juce::int64 getBufferedFrames(int stream) const noexcept;
+    bool fill(int stream);
+    bool anyActive() const noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE(H9DiskStreams)
+};
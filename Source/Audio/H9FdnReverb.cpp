@@ -0,0 +1,268 @@
+#include "H9FdnReverb.h"
+
+namespace
+{
+    using namespace H9Simd;
+
+    // Line lengths, spread so no two share a short common period. The 4- and
+    // 8-line tiers take every fourth / second entry, so each tier covers the
+    // same range.
+    constexpr float lineMs[H9FdnReverb::maxLines] = {
+        23.1f, 25.7f, 28.3f, 31.1f, 33.9f, 36.7f, 39.8f, 42.9f,
+        46.3f, 49.9f, 53.6f, 57.4f, 61.6f, 66.2f, 71.8f, 77.9f
+    };
+
+    constexpr float depthMs      = 0.12f;     // delay modulation, either side
+    constexpr float dampHz       = 6000.0f;   // corner of the in-loop lowpass
+    constexpr float minDecaySecs = 0.2f;
+    constexpr float maxDecaySecs = 4.0f;
+    constexpr float silenceFloor = 1.0e-5f;   // -100 dB
+
+    bool isSilent(const float* data, int numSamples) noexcept
+    {
+        const auto range = juce::FloatVectorOperations::findMinAndMax(data, numSamples);
+        return range.getStart() > -silenceFloor && range.getEnd() < silenceFloor;
+    }
+}
+
+H9FdnReverb::H9FdnReverb()
+{
+    prepare(sampleRate);
+}
+
+void H9FdnReverb::prepare(double sr)
+{
+    sampleRate = sr;
+    depth      = depthMs * 0.001f * (float)sr;
+    dampCoeff  = std::exp(-juce::MathConstants<float>::twoPi * juce::jmin(dampHz, 0.4f * (float)sr) / (float)sr);
+    inputGain  = 0.35f;
+
+    const int longest = (int)std::ceil(lineMs[maxLines - 1] * 0.001 * sr + depth) + 2;
+    const int frames  = juce::nextPowerOfTwo(longest);
+
+    // One spare frame so the ring can start on a cache line
+    storage.assign((size_t)(frames + 1) * frameSize, 0.0f);
+    const auto misalign = reinterpret_cast<std::uintptr_t>(storage.data()) % (frameSize * sizeof(float));
+    ring     = storage.data() + (misalign == 0 ? 0 : (frameSize * sizeof(float) - misalign) / sizeof(float));
+    ringMask = frames - 1;
+    writePos = 0;
+
+    wet.reset(sr, 0.05);
+    updateLines();
+    updateGains();
+    reset();
+}
+
+void H9FdnReverb::reset() noexcept
+{
+    cleared = false;
+    clearTail();
+    wet.setCurrentAndTargetValue(wet.getTargetValue());
+}
+
+void H9FdnReverb::clearTail() noexcept
+{
+    if (!cleared)
+    {
+        std::fill(storage.begin(), storage.end(), 0.0f);
+        damped.fill(0.0f);
+        cleared = true;
+    }
+
+    quietSamples = ringMask + 1;
+}
+
+void H9FdnReverb::setLines(int n) noexcept
+{
+    n = n <= 4 ? 4 : n <= 8 ? 8 : 16;
+    if (n == numLines)
+        return;
+
+    numLines = n;
+    updateLines();
+    updateGains();
+    clearTail();
+}
+
+void H9FdnReverb::setParameters(float newRoomSize, float wetLevel) noexcept
+{
+    newRoomSize = juce::jlimit(0.0f, 1.0f, newRoomSize);
+    if (newRoomSize != roomSize)
+    {
+        roomSize = newRoomSize;
+        updateGains();
+    }
+
+    wet.setTargetValue(juce::jmax(0.0f, wetLevel));
+}
+
+void H9FdnReverb::updateLines() noexcept
+{
+    const int stride = maxLines / numLines;
+
+    for (int i = 0; i < numLines; ++i)
+    {
+        delay[(size_t)i] = std::round(lineMs[i * stride + stride / 2] * 0.001f * (float)sampleRate);
+
+        // Slightly different rates and spread phases keep the lines from
+        // moving in step
+        const float rate  = 0.3f + 0.07f * (float)i;
+        const float step  = juce::MathConstants<float>::twoPi * rate / (float)sampleRate;
+        const float phase = juce::MathConstants<float>::twoPi * 0.618f * (float)i;
+        lfoStepSin[(size_t)i] = std::sin(step);
+        lfoStepCos[(size_t)i] = std::cos(step);
+        lfoSin[(size_t)i]     = std::sin(phase);
+        lfoCos[(size_t)i]     = std::cos(phase);
+    }
+}
+
+float H9FdnReverb::getDecaySeconds(float room) noexcept
+{
+    return minDecaySecs + (maxDecaySecs - minDecaySecs) * juce::jlimit(0.0f, 1.0f, room);
+}
+
+// Each pass through a line loses its share of 60 dB over the decay time.
+// 1/sqrt(N) makes the Hadamard mix orthogonal, so the mix itself neither
+// adds nor removes energy.
+void H9FdnReverb::updateGains() noexcept
+{
+    const float decaySecs = getDecaySeconds(roomSize);
+    const float scale     = 1.0f / std::sqrt((float)numLines);
+
+    for (int i = 0; i < numLines; ++i)
+        gain[(size_t)i] = scale * std::pow(10.0f, -3.0f * delay[(size_t)i] / (decaySecs * (float)sampleRate));
+}
+
+// ── Processing ──────────────────────────────────────────────────────────────
+
+void H9FdnReverb::process(float* left, float* right, int numSamples) noexcept
+{
+    if (numSamples <= 0)
+        return;
+
+    if (wet.getTargetValue() <= 0.0f && !wet.isSmoothing())
+    {
+        clearTail();
+        return;
+    }
+
+    if (quietSamples > ringMask && isSilent(left, numSamples)
+        && (right == nullptr || isSilent(right, numSamples)))
+    {
+        wet.skip(numSamples);
+        return;
+    }
+
+    const float peak = numLines == 16 ? run<4>(left, right, numSamples)
+                     : numLines == 8  ? run<2>(left, right, numSamples)
+                                      : run<1>(left, right, numSamples);
+    cleared = false;
+    quietSamples = peak < silenceFloor ? juce::jmin(quietSamples + numSamples, ringMask + 1) : 0;
+
+    // The LFO rotation drifts off the unit circle by rounding; pull it back
+    for (int i = 0; i < numLines; ++i)
+    {
+        const float r = 1.0f / std::sqrt(lfoSin[(size_t)i] * lfoSin[(size_t)i] + lfoCos[(size_t)i] * lfoCos[(size_t)i]);
+        lfoSin[(size_t)i] *= r;
+        lfoCos[(size_t)i] *= r;
+    }
+}
+
+// Returns the largest |sample| written into the ring
+template <int Vecs>
+float H9FdnReverb::run(float* left, float* right, int numSamples) noexcept
+{
+    Vec dl[Vecs], g[Vecs], z[Vecs], s[Vecs], c[Vecs], stepS[Vecs], stepC[Vecs];
+    for (int v = 0; v < Vecs; ++v)
+    {
+        const int o = v * lanes;
+        dl[v]    = vload(delay.data() + o);
+        g[v]     = vload(gain.data() + o);
+        z[v]     = vload(damped.data() + o);
+        s[v]     = vload(lfoSin.data() + o);
+        c[v]     = vload(lfoCos.data() + o);
+        stepS[v] = vload(lfoStepSin.data() + o);
+        stepC[v] = vload(lfoStepCos.data() + o);
+    }
+
+    const Vec depthV  = vset(depth);
+    const Vec dampV   = vset(dampCoeff);
+    const Vec inScale = vset(inputGain);
+    Vec peak = vset(0.0f);
+
+    alignas(16) float pos[lanes], frac[lanes], tapA[lanes], tapB[lanes], out[lanes];
+    int w = writePos;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        Vec x[Vecs];
+
+        for (int v = 0; v < Vecs; ++v)
+        {
+            // Fractional read: the lanes sit at different ring positions
+            vstore(pos, vadd(dl[v], vmul(depthV, s[v])));
+            for (int l = 0; l < lanes; ++l)
+            {
+                const int d    = (int)pos[l];
+                const int p0   = (w - d) & ringMask;
+                const int p1   = (p0 - 1) & ringMask;
+                const int line = v * lanes + l;
+                frac[l] = pos[l] - (float)d;
+                tapA[l] = ring[p0 * frameSize + line];
+                tapB[l] = ring[p1 * frameSize + line];
+            }
+
+            const Vec a   = vload(tapA);
+            const Vec tap = vadd(a, vmul(vload(frac), vsub(vload(tapB), a)));
+            z[v] = vadd(tap, vmul(dampV, vsub(z[v], tap)));
+            x[v] = vhadamard4(vmul(g[v], z[v]));
+
+            const Vec nextS = vadd(vmul(s[v], stepC[v]), vmul(c[v], stepS[v]));
+            c[v] = vsub(vmul(c[v], stepC[v]), vmul(s[v], stepS[v]));
+            s[v] = nextS;
+        }
+
+        // Across registers: H(N) = H(N/4) ⊗ H(4)
+        for (int span = 1; span < Vecs; span *= 2)
+            for (int v = 0; v < Vecs; v += 2 * span)
+                for (int j = v; j < v + span; ++j)
+                {
+                    const Vec t = x[j];
+                    x[j]        = vadd(t, x[j + span]);
+                    x[j + span] = vsub(t, x[j + span]);
+                }
+
+        // Rows 0 and 1 of the mix: all lines, and alternating signs
+        vstore(out, x[0]);
+        const float wetGain = wet.getNextValue();
+        const float inL = left[i];
+        const float inR = right != nullptr ? right[i] : inL;
+        left[i] += wetGain * out[0];
+        if (right != nullptr)
+            right[i] += wetGain * out[1];
+
+        // Left into even lines, right into odd
+        const Vec in = vmul(inScale, vsetLanes(inL, inR, inL, inR));
+        float* frame = ring + w * frameSize;
+        for (int v = 0; v < Vecs; ++v)
+        {
+            x[v] = vadd(x[v], in);
+            vstore(frame + v * lanes, x[v]);
+            peak = vmax(peak, vabs(x[v]));
+        }
+
+        w = (w + 1) & ringMask;
+    }
+
+    writePos = w;
+    for (int v = 0; v < Vecs; ++v)
+    {
+        const int o = v * lanes;
+        vstore(damped.data() + o, z[v]);
+        vstore(lfoSin.data() + o, s[v]);
+        vstore(lfoCos.data() + o, c[v]);
+    }
+
+    vstore(out, peak);
+    return juce::jmax(juce::jmax(out[0], out[1]), juce::jmax(out[2], out[3]));
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "Audio/H9Simd.h"
+
+// ── H9FdnReverb ─────────────────────────────────────────────────────────────
+// Feedback delay network reverb for the Atmosphere macro, in three CPU
+// tiers: 4, 8 or 16 delay lines. Every sample each line is read at a
+// slowly modulated fractional delay, damped by a one-pole lowpass, scaled
+// for the decay time and mixed back into all lines through a normalised
+// Hadamard matrix — 4-point transforms within a SIMD register, butterflies
+// across registers. The left output is the sum of the lines and the right
+// the alternating-sign sum, which are the first two rows of that same
+// transform, so they come for free.
+//
+// The lines share one contiguous ring, one 64-byte frame per sample with a
+// float per line: the feedback writes for a sample are whole-register
+// stores into a single cache line.
+//
+// process() adds the wet signal to its input. It returns straight away
+// while wet is zero (the tail is cleared once wet reaches it), and while
+// the input is silent after the tail has decayed below -100 dB.
+
+class H9FdnReverb
+{
+public:
+    static constexpr int maxLines = 16;
+
+    H9FdnReverb();
+
+    // Non-RT. Sizes the delay ring for the rate and clears the tail.
+    void prepare(double sampleRate);
+    void reset() noexcept;
+
+    // ── Audio thread ────────────────────────────────────────────────────────
+
+    // 4, 8 or 16. Changing it clears the tail.
+    void setLines(int numLines) noexcept;
+    int  getLines() const noexcept { return numLines; }
+
+    // roomSize 0 … 1 sets the decay time (0.2 s → 4 s to -60 dB);
+    // wetLevel is smoothed over 50 ms
+    void setParameters(float roomSize, float wetLevel) noexcept;
+
+    // Any thread: the decay time to -60 dB at room size `room`
+    static float getDecaySeconds(float room) noexcept;
+
+    // `right` may be nullptr for a mono bus
+    void process(float* left, float* right, int numSamples) noexcept;
+
+private:
+    static constexpr int lanes     = H9Simd::lanes;
+    static constexpr int maxVecs   = maxLines / lanes;
+    static constexpr int frameSize = maxLines;   // floats per ring frame
+
+    double sampleRate { 44100.0 };
+    int    numLines   { 8 };
+    float  roomSize   { -1.0f };
+
+    // Ring of frames, frameSize-aligned inside `storage`
+    std::vector<float> storage;
+    float* ring      { nullptr };
+    int    ringMask  { 0 };   // frames - 1
+    int    writePos  { 0 };
+
+    // Per line, in the order the current tier uses them
+    alignas(16) std::array<float, maxLines> delay {};      // samples, centre of the modulation
+    alignas(16) std::array<float, maxLines> gain {};       // decay per pass, with the matrix scale
+    alignas(16) std::array<float, maxLines> damped {};     // one-pole state
+    alignas(16) std::array<float, maxLines> lfoSin {}, lfoCos {};
+    alignas(16) std::array<float, maxLines> lfoStepSin {}, lfoStepCos {};
+
+    float depth      { 0.0f };   // modulation, samples
+    float dampCoeff  { 0.0f };
+    float inputGain  { 0.0f };
+
+    juce::SmoothedValue<float> wet { 0.0f };
+    bool cleared      { true };   // ring all zeros since the last reset
+    int  quietSamples { 0 };      // consecutive samples written below the silence floor
+
+    void updateLines() noexcept;
+    void updateGains() noexcept;
+    void clearTail() noexcept;
+
+    template <int Vecs>
+    float run(float* left, float* right, int numSamples) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE(H9FdnReverb)
+};
@@ -0,0 +1,344 @@
+#include "H9GranularEngine.h"
+#include "Audio/H9Simd.h"
+
+namespace
+{
+    using namespace H9Simd;
+
+    // Frames kept clear past a grain's last read: a whole register beyond
+    // the window's end, plus the interpolation tap
+    constexpr int guardFrames = lanes + 1;
+
+    constexpr float tukeyTaper = 0.5f;    // fraction of the grain in the cosine ends
+    constexpr float gaussSigma = 0.15f;   // of the grain length
+
+    float windowAt(H9GranularEngine::Window w, double x) noexcept
+    {
+        using W = H9GranularEngine::Window;
+        const double pi = juce::MathConstants<double>::pi;
+
+        switch (w)
+        {
+            case W::gauss:
+            {
+                // Shifted and rescaled so both ends reach exactly zero
+                const double edge = std::exp(-0.5 * std::pow(0.5 / gaussSigma, 2.0));
+                const double g    = std::exp(-0.5 * std::pow((x - 0.5) / gaussSigma, 2.0));
+                return (float)juce::jmax(0.0, (g - edge) / (1.0 - edge));
+            }
+
+            case W::tukey:
+            {
+                const double half = 0.5 * tukeyTaper;
+                const double d    = juce::jmin(x, 1.0 - x);
+                return d >= half ? 1.0f : (float)(0.5 - 0.5 * std::cos(pi * d / half));
+            }
+
+            case W::hann:
+            default:
+                return (float)(0.5 - 0.5 * std::cos(2.0 * pi * x));
+        }
+    }
+}
+
+// ── Setup ────────────────────────────────────────────────────────────────────
+
+H9GranularEngine::H9GranularEngine()
+{
+    for (int w = 0; w < numWindows; ++w)
+    {
+        auto& t = tables[(size_t)w];
+        t.assign((size_t)tableSize + 2, 0.0f);
+
+        double power = 0.0;
+        for (int i = 1; i < tableSize; ++i)
+        {
+            t[(size_t)i] = windowAt((Window)w, (double)i / tableSize);
+            power += (double)t[(size_t)i] * t[(size_t)i];
+        }
+        windowPower[(size_t)w] = (float)(power / tableSize);
+    }
+
+    pool.resize((size_t)maxVoices * grainsPerVoice);
+    prepare(sampleRate);
+}
+
+void H9GranularEngine::prepare(double sr)
+{
+    sampleRate = sr > 0.0 ? sr : 44100.0;
+    for (int v = 0; v < maxVoices; ++v)
+        stopVoice(v);
+
+    for (auto& v : voices)
+        v.dropped = v.grainSamples = 0;
+
+    setSettings(settings);
+}
+
+// ── Audio thread ─────────────────────────────────────────────────────────────
+
+void H9GranularEngine::setSettings(const Settings& s) noexcept
+{
+    settings.density = juce::jlimit(0.5f, 4000.0f, s.density);
+    settings.sizeMs  = juce::jlimit(minSizeMs, 2000.0f, s.sizeMs);
+    settings.scan    = juce::jlimit(0.01f, 4.0f, s.scan);
+    settings.spray   = juce::jlimit(0.0f, 1.0f, s.spray);
+    settings.spread  = juce::jlimit(0.0f, 1.0f, s.spread);
+    settings.window  = (Window)juce::jlimit(0, numWindows - 1, (int)s.window);
+
+    interval    = sampleRate / settings.density;
+    grainLength = juce::jmax(lanes, juce::roundToInt(settings.sizeMs * 0.001 * sampleRate));
+    window      = tables[(size_t)settings.window].data();
+
+    // Overlapping grains of unrelated phase add in power: hold the cloud's
+    // RMS near the sample's. Sparse clouds keep every grain at full level.
+    const double overlap = settings.density * grainLength / sampleRate;
+    cloudGain = 1.0f / std::sqrt(juce::jmax(1.0f, (float)overlap * windowPower[(size_t)settings.window]));
+}
+
+void H9GranularEngine::startVoice(int voice, double increment, float gain) noexcept
+{
+    auto& v = voices[(size_t)voice];
+    v.scheduling = true;
+    v.elapsed    = 0;
+    v.increment  = juce::jmax(1.0e-3, increment);
+    v.gain       = gain;
+    v.nextOnset  = 0.0;
+    v.numGrains  = 0;
+
+    // Every hit scatters differently
+    seed   = seed * 1664525u + 1013904223u;
+    v.random = seed != 0 ? seed : 1u;
+}
+
+void H9GranularEngine::stopVoice(int voice) noexcept
+{
+    auto& v = voices[(size_t)voice];
+    v.scheduling = false;
+    v.numGrains  = 0;
+}
+
+bool H9GranularEngine::render(int voice, const Source& src, float* left, float* right,
+                              int numSamples) noexcept
+{
+    auto& v = voices[(size_t)voice];
+    Grain* grains = pool.data() + (size_t)voice * grainsPerVoice;
+
+    if (src.length < minSourceFrames)
+    {
+        stopVoice(voice);
+        return false;
+    }
+
+    schedule(v, grains, src, numSamples);
+
+    const bool  unitRate  = v.increment == 1.0;
+    const float increment = (float)v.increment;
+
+    for (int k = 0; k < v.numGrains;)
+    {
+        auto& g = grains[k];
+        v.grainSamples += (juce::uint64)(unitRate
+            ? renderGrain<true>(g, src, increment, left, right, numSamples)
+            : renderGrain<false>(g, src, increment, left, right, numSamples));
+
+        if (g.age >= g.length)
+            g = grains[--v.numGrains];   // finished: the last grain takes its place
+        else
+            ++k;
+    }
+
+    return v.scheduling || v.numGrains > 0;
+}
+
+// Starts the grains due in the next `numSamples` and moves the voice on
+void H9GranularEngine::schedule(VoiceState& v, Grain* grains, const Source& src,
+                                int numSamples) noexcept
+{
+    const double scanStep    = settings.scan * v.increment;   // source frames per output sample
+    const double sprayFrames = settings.spray * maxSprayMs * 0.001 * sampleRate * v.increment;
+    const int    room        = src.length - guardFrames;
+    const float  halfPi      = juce::MathConstants<float>::halfPi;
+
+    // Positions come from whole sample counts, never from sums carried
+    // across blocks, so grains land on the same frames at any block size
+    while (v.scheduling && v.nextOnset < (double)(v.elapsed + numSamples))
+    {
+        const auto   at    = (juce::int64)v.nextOnset;
+        const int    onset = (int)(at - v.elapsed);
+        const double head  = scanStep * (double)at;
+        if (head >= src.length)
+        {
+            v.scheduling = false;
+            break;
+        }
+
+        v.nextOnset += interval * (0.5 + nextRandom(v.random));
+
+        if (v.numGrains == grainsPerVoice)
+        {
+            ++v.dropped;
+            continue;
+        }
+
+        // A grain longer than the sample is cut to fit
+        int length = grainLength;
+        if (length * v.increment > room)
+            length = juce::jmax(lanes, (int)(room / v.increment));
+        const double span = length * v.increment;
+
+        const double jitter = (2.0 * nextRandom(v.random) - 1.0) * sprayFrames;
+        const double start  = juce::jlimit(0.0, juce::jmax(0.0, room - span), head + jitter);
+
+        // Equal power, unity at the centre
+        const float pan   = 0.5f + settings.spread * (nextRandom(v.random) - 0.5f);
+        const float level = juce::MathConstants<float>::sqrt2 * cloudGain * v.gain;
+
+        auto& g = grains[v.numGrains++];
+        g.start     = (int)start;   // whole frames: rate-1 grains copy straight through
+        g.length    = length;
+        g.age       = 0;
+        g.phaseStep = (float)tableSize / (float)length;
+        g.gainL     = level * std::cos(pan * halfPi);
+        g.gainR     = level * std::sin(pan * halfPi);
+        g.delay     = onset;
+    }
+
+    v.elapsed += numSamples;
+    if (scanStep * (double)v.elapsed >= src.length)
+        v.scheduling = false;
+}
+
+// Adds one grain from its delay to the end of the block or of its window,
+// four samples at a time; lanes past the window's end read zero from the
+// table guard. Returns the samples rendered.
+template <bool unitRate>
+int H9GranularEngine::renderGrain(Grain& g, const Source& src, float increment,
+                                  float* left, float* right, int numSamples) noexcept
+{
+    alignas(16) float w0[lanes], w1[lanes], wFrac[lanes];
+    alignas(16) float l0[lanes], l1[lanes], r0[lanes], r1[lanes], sFrac[lanes], tmp[lanes];
+
+    const bool  stereoSource = src.right != src.left;
+    const float end   = (float)tableSize;
+    const float step  = g.phaseStep;
+    const int   last  = src.length - 2;
+
+    const Vec gainL = vset(right != nullptr ? g.gainL : 0.5f * (g.gainL + g.gainR));
+    const Vec gainR = vset(g.gainR);
+    const Vec half  = vset(0.5f);
+
+    int age = g.age;
+    const int first = g.delay;
+    g.delay = 0;
+
+    int i = first;
+    for (; i < numSamples && age < g.length; i += lanes)
+    {
+        const int count = juce::jmin(lanes, numSamples - i);
+
+        for (int l = 0; l < lanes; ++l)
+        {
+            const float p = juce::jmin(end, (float)(age + l) * step);
+            const int   k = (int)p;
+            w0[l]    = window[k];
+            w1[l]    = window[k + 1];
+            wFrac[l] = p - (float)k;
+        }
+
+        const Vec a = vload(w0);
+        const Vec w = vadd(a, vmul(vsub(vload(w1), a), vload(wFrac)));
+
+        Vec sL, sR;
+        if constexpr (unitRate)
+        {
+            const int base = g.start + age;
+            sL = vload(src.left + base);
+            sR = stereoSource ? vload(src.right + base) : sL;
+        }
+        else
+        {
+            for (int l = 0; l < lanes; ++l)
+            {
+                const float p = (float)(age + l) * increment;
+                const int   k = (int)p;
+                const int   f = juce::jmin(last, g.start + k);
+                sFrac[l] = p - (float)k;
+                l0[l] = src.left[f];
+                l1[l] = src.left[f + 1];
+                r0[l] = src.right[f];
+                r1[l] = src.right[f + 1];
+            }
+
+            const Vec f  = vload(sFrac);
+            const Vec x0 = vload(l0);
+            sL = vadd(x0, vmul(vsub(vload(l1), x0), f));
+
+            const Vec y0 = vload(r0);
+            sR = stereoSource ? vadd(y0, vmul(vsub(vload(r1), y0), f)) : sL;
+        }
+
+        // A block can end part-way through the register
+        age += count;
+
+        // Mono buses take both source channels
+        const Vec outL = vmul(vmul(w, gainL), right != nullptr ? sL : vmul(half, vadd(sL, sR)));
+
+        if (count == lanes)
+        {
+            vstore(left + i, vadd(vload(left + i), outL));
+            if (right != nullptr)
+                vstore(right + i, vadd(vload(right + i), vmul(vmul(w, gainR), sR)));
+        }
+        else
+        {
+            vstore(tmp, outL);
+            for (int l = 0; l < count; ++l)
+                left[i + l] += tmp[l];
+
+            if (right != nullptr)
+            {
+                vstore(tmp, vmul(vmul(w, gainR), sR));
+                for (int l = 0; l < count; ++l)
+                    right[i + l] += tmp[l];
+            }
+        }
+    }
+
+    g.age = age;
+    return juce::jmin(i, numSamples) - first;
+}
+
+float H9GranularEngine::nextRandom(juce::uint32& state) noexcept
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return (float)(state >> 8) * (1.0f / 16777216.0f);
+}
+
+// ── Statistics ───────────────────────────────────────────────────────────────
+
+int H9GranularEngine::getNumGrains() const noexcept
+{
+    int n = 0;
+    for (auto& v : voices)
+        n += v.numGrains;
+    return n;
+}
+
+juce::uint64 H9GranularEngine::getDroppedGrains() const noexcept
+{
+    juce::uint64 n = 0;
+    for (auto& v : voices)
+        n += v.dropped;
+    return n;
+}
+
+juce::uint64 H9GranularEngine::getGrainSamples() const noexcept
+{
+    juce::uint64 n = 0;
+    for (auto& v : voices)
+        n += v.grainSamples;
+    return n;
+}
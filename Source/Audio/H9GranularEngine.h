@@ -0,0 +1,135 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+
+// ── H9GranularEngine ────────────────────────────────────────────────────────
+// Grain clouds for texture pads (a pack's padBank role "texture"). A voice
+// moves a play head through its sample at `scan` × the voice's rate and
+// scatters grains around it:
+//   scheduler   `density` grains per second at jittered intervals (0.5 …
+//               1.5 × the mean, so clouds don't buzz at the grain rate),
+//               each starting up to `spray` × maxSprayMs either side of the
+//               play head, panned up to `spread` either side of centre
+//   grains      `sizeMs` long, read at the voice's rate (linear
+//               interpolation, or straight copies at rate 1) under a Hann,
+//               Gaussian or Tukey window looked up from tables built once.
+//               Each grain renders four output samples per SIMD register;
+//               its gain keeps the cloud near the sample's own level
+//               whatever the overlap.
+// The voice ends once the play head has passed the end of the sample and
+// its last grain has finished.
+//
+// State is indexed by voice slot, as in H9VoiceDsp. Every slot owns a
+// preallocated partition of the grain pool, kept dense (finished grains
+// swap with the last), so scheduling and rendering never allocate, lock or
+// touch another voice's grains — the sampler's voice threads can render
+// different slots at once. A grain the full partition can't take is
+// dropped and counted.
+
+class H9GranularEngine
+{
+public:
+    static constexpr int maxVoices      = 16;
+    static constexpr int grainsPerVoice = 512;    // sounding at once, per voice
+    static constexpr int tableSize      = 4096;   // window points
+
+    static constexpr float minSizeMs  = 5.0f;
+    static constexpr float maxSprayMs = 250.0f;
+
+    enum class Window { hann, gauss, tukey };
+    static constexpr int numWindows = 3;
+
+    struct Settings
+    {
+        float  density { 60.0f };    // grains per second
+        float  sizeMs  { 120.0f };
+        float  scan    { 0.5f };     // play head speed, × the voice's rate
+        float  spray   { 0.2f };     // 0 … 1 of maxSprayMs
+        float  spread  { 0.5f };     // 0 … 1: pan range
+        Window window  { Window::hann };
+    };
+
+    // Frames a grain reads from: the whole sample, resident as float
+    struct Source
+    {
+        const float* left;
+        const float* right;          // == left for mono samples
+        int length;
+    };
+
+    // Shorter samples are played without grains
+    static constexpr int minSourceFrames = 64;
+
+    H9GranularEngine();
+
+    // Non-RT. Ends every voice.
+    void prepare(double sampleRate);
+
+    // ── Audio thread ────────────────────────────────────────────────────────
+
+    // Call once per block, before any render(); new grains use it
+    void setSettings(const Settings&) noexcept;
+
+    // `increment` is source frames per output sample (rate and pitch)
+    void startVoice(int voice, double increment, float gain) noexcept;
+    void stopVoice(int voice) noexcept;
+
+    // Adds `voice`'s grains into `left` / `right` (nullptr: mono bus, both
+    // source channels mixed). Returns false once the voice has finished.
+    // Touches only that voice's state, so voices can render concurrently.
+    bool render(int voice, const Source&, float* left, float* right, int numSamples) noexcept;
+
+    // Between renders: grains sounding, grains dropped since prepare() and
+    // grain samples rendered since prepare(), over all voices
+    int          getNumGrains() const noexcept;
+    juce::uint64 getDroppedGrains() const noexcept;
+    juce::uint64 getGrainSamples() const noexcept;
+
+private:
+    struct Grain
+    {
+        int   start;       // first source frame
+        int   length;      // output samples in the window
+        int   age;         // output samples rendered so far
+        float phaseStep;   // window table steps per output sample
+        float gainL, gainR;
+        int   delay;       // output samples before it starts, this block
+    };
+
+    struct VoiceState
+    {
+        bool   scheduling { false };   // play head still inside the sample
+        juce::int64 elapsed { 0 };     // output samples since startVoice()
+        double increment  { 1.0 };
+        float  gain       { 0.0f };
+        double nextOnset  { 0.0 };     // output samples since startVoice()
+        juce::uint32 random { 1 };
+        int    numGrains  { 0 };
+        juce::uint64 dropped { 0 };
+        juce::uint64 grainSamples { 0 };
+    };
+
+    double   sampleRate { 44100.0 };
+    Settings settings;
+    double   interval   { 0.0 };        // mean samples between grains
+    int      grainLength { 1 };         // output samples
+    float    cloudGain  { 1.0f };       // overlap compensation
+    const float* window { nullptr };    // settings.window's table
+    juce::uint32 seed   { 0x9e3779b9u };
+
+    // tableSize + 1 points from 0 to 0, then a zero guard for interpolation
+    std::array<std::vector<float>, numWindows> tables;
+    std::array<float, numWindows> windowPower {};   // mean square
+
+    std::array<VoiceState, maxVoices> voices {};
+    std::vector<Grain> pool;            // grainsPerVoice per voice slot
+
+    void schedule(VoiceState&, Grain* grains, const Source&, int numSamples) noexcept;
+
+    template <bool unitRate>
+    int renderGrain(Grain&, const Source&, float increment, float* left, float* right,
+                    int numSamples) noexcept;
+
+    static float nextRandom(juce::uint32& state) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE(H9GranularEngine)
+};
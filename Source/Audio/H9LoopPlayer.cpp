@@ -0,0 +1,564 @@
+#include "H9LoopPlayer.h"
+#include "Audio/H9Resampler.h"
+#include "Audio/H9SampleRelinker.h"
+#include "Audio/H9Simd.h"
+#include "Core/H9Trace.h"
+
+namespace
+{
+    using namespace H9Simd;
+
+    int grainFrames(double sampleRate) noexcept
+    {
+        return juce::jmax(64, juce::roundToInt(H9LoopPlayer::grainMs * 0.001 * sampleRate / 32.0) * 32);
+    }
+
+    // n a multiple of lanes
+    float dot(const float* a, const float* b, int n) noexcept
+    {
+        Vec acc0 = vset(0.0f), acc1 = vset(0.0f);
+        int i = 0;
+        for (; i + 2 * lanes <= n; i += 2 * lanes)
+        {
+            acc0 = vadd(acc0, vmul(vload(a + i),         vload(b + i)));
+            acc1 = vadd(acc1, vmul(vload(a + i + lanes), vload(b + i + lanes)));
+        }
+        if (i < n)
+            acc0 = vadd(acc0, vmul(vload(a + i), vload(b + i)));
+
+        return vsum(vadd(acc0, acc1));
+    }
+
+    // "loop 120bpm", "Drums_92_BPM", or a lone number 60 – 200: "keys_84_dry"
+    double tempoFromName(const juce::String& name)
+    {
+        const auto lower = name.toLowerCase();
+
+        const int at = lower.indexOf("bpm");
+        if (at > 0)
+        {
+            int end = at;
+            while (end > 0 && juce::String(" _-").containsChar(lower[end - 1]))
+                --end;
+            int start = end;
+            while (start > 0 && juce::CharacterFunctions::isDigit(lower[start - 1]))
+                --start;
+
+            const double bpm = lower.substring(start, end).getDoubleValue();
+            if (end > start && bpm >= 40.0 && bpm <= 300.0)
+                return bpm;
+        }
+
+        for (auto& token : juce::StringArray::fromTokens(lower, " _-.()[]", ""))
+            if (token.containsOnly("0123456789") && token.getIntValue() >= 60 && token.getIntValue() <= 200)
+                return token.getIntValue();
+
+        return 0.0;
+    }
+}
+
+// ── Shared state ─────────────────────────────────────────────────────────────
+// Outlives the player if a job is still running when the plugin is deleted.
+
+struct H9LoopPlayer::Shared
+{
+    juce::CriticalSection lock;
+    H9LoopPlayer* owner { nullptr };        // cleared by ~H9LoopPlayer
+    std::unique_ptr<Analysis> completed;    // guarded by lock
+    H9SampleRef completedRef;
+    bool completedFromName { false };
+};
+
+// ── Background job ───────────────────────────────────────────────────────────
+
+class H9LoopPlayer::Job
+{
+public:
+    Job(std::shared_ptr<Shared> s, H9SampleRef r, juce::File root, double rate, int gen)
+        : shared(std::move(s)), saved(std::move(r)), libraryRoot(std::move(root)),
+          targetRate(rate), generation(gen) {}
+
+    void run(const H9JobToken& token)
+    {
+        H9_TRACE_SCOPE("loop analysis");
+
+        bool relinked = false;
+        const auto file = H9SampleRelinker(libraryRoot).resolve(saved, token, relinked);
+
+        H9SampleRef ref;
+        auto audio = read(file, ref);
+        if (audio.getNumSamples() == 0 || token.isCancelled())
+            return;
+
+        bool fromName = false;
+        auto analysis = analyse(audio, file, fromName);
+        if (analysis == nullptr || token.isCancelled())
+            return;
+
+        const juce::ScopedLock sl(shared->lock);
+        if (shared->owner != nullptr)
+        {
+            shared->completed         = std::move(analysis);
+            shared->completedRef      = ref;
+            shared->completedFromName = fromName;
+            shared->owner->triggerAsyncUpdate();
+        }
+    }
+
+private:
+    std::shared_ptr<Shared> shared;
+    H9SampleRef saved;
+    juce::File  libraryRoot;
+    double targetRate;
+    int    generation;
+
+    // Reads the file once: the same bytes are hashed and decoded
+    juce::AudioBuffer<float> read(const juce::File& file, H9SampleRef& ref) const
+    {
+        juce::MemoryBlock bytes;
+        if (!file.loadFileAsData(bytes) || bytes.getSize() == 0)
+            return {};
+
+        ref.path = file.getFullPathName();
+        ref.hash = juce::MD5(bytes).toHexString();
+        ref.size = (juce::int64)bytes.getSize();
+
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(
+            std::make_unique<juce::MemoryInputStream>(bytes, false)));
+        if (reader == nullptr || reader->lengthInSamples <= 0 || reader->sampleRate <= 0.0)
+            return {};
+
+        const int channels = juce::jlimit(1, 2, (int)reader->numChannels);
+        const int length   = (int)juce::jmin(reader->lengthInSamples,
+                                             (juce::int64)(maxSeconds * reader->sampleRate));
+
+        juce::AudioBuffer<float> audio(channels, length);
+        reader->read(&audio, 0, length, 0, true, channels > 1);
+
+        if (H9Resampler::needsConversion(reader->sampleRate, targetRate))
+            audio = H9Resampler::process(audio, reader->sampleRate, targetRate);
+
+        return audio;
+    }
+
+    std::unique_ptr<Analysis> analyse(const juce::AudioBuffer<float>& audio, const juce::File& file,
+                                      bool& fromName) const
+    {
+        auto a = std::make_unique<Analysis>();
+        a->sampleRate = targetRate;
+        a->length     = audio.getNumSamples();
+        a->grain      = grainFrames(targetRate);
+        a->tolerance  = a->grain / 16 * 4;
+        a->generation = generation;
+
+        if (a->length < a->grain)
+            return nullptr;
+
+        // Tempo: the name's, rounded to whole beats; otherwise the whole
+        // number of bars (1 – 16) that lands nearest 120 BPM
+        const double seconds = a->length / targetRate;
+        const double named   = tempoFromName(file.getFileNameWithoutExtension());
+        fromName = named > 0.0;
+
+        if (fromName)
+        {
+            a->beats = juce::jmax(1.0, std::round(seconds * named / 60.0));
+        }
+        else
+        {
+            double bestError = 1.0e9;
+            for (int bars = 1; bars <= 16; bars *= 2)
+            {
+                const double error = std::abs(std::log2(60.0 * 4 * bars / seconds / 120.0));
+                if (error < bestError)
+                {
+                    bestError = error;
+                    a->beats  = 4.0 * bars;
+                }
+            }
+        }
+
+        // The wrap covers the furthest read: a grain from the end of the
+        // search range
+        const int total    = a->length + a->grain + 2 * a->tolerance + 8;
+        const int channels = audio.getNumChannels();
+
+        a->audio.setSize(channels, total);
+        for (int c = 0; c < channels; ++c)
+        {
+            const float* src = audio.getReadPointer(c);
+            float* dst = a->audio.getWritePointer(c);
+            for (int i = 0; i < total; ++i)
+                dst[i] = src[i % a->length];
+        }
+
+        a->mono.assign((size_t)total, 0.0f);
+        for (int c = 0; c < channels; ++c)
+            juce::FloatVectorOperations::addWithMultiply(a->mono.data(), a->audio.getReadPointer(c),
+                                                         1.0f / (float)channels, total);
+
+        a->coarse.resize((size_t)(total / 4));
+        for (size_t q = 0; q < a->coarse.size(); ++q)
+            a->coarse[q] = 0.25f * ((a->mono[4 * q] + a->mono[4 * q + 1]) + (a->mono[4 * q + 2] + a->mono[4 * q + 3]));
+
+        // Periodic, so grains half a grain apart sum to exactly one
+        a->window.resize((size_t)a->grain);
+        for (int j = 0; j < a->grain; ++j)
+            a->window[(size_t)j] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * (float)j / (float)a->grain);
+
+        return a;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(Job)
+};
+
+// ── H9LoopPlayer ─────────────────────────────────────────────────────────────
+
+H9LoopPlayer::H9LoopPlayer()
+    : shared(std::make_shared<Shared>())
+{
+    shared->owner = this;
+}
+
+H9LoopPlayer::~H9LoopPlayer()
+{
+    {
+        const juce::ScopedLock sl(shared->lock);
+        shared->owner = nullptr;
+    }
+    token.cancel();
+    cancelPendingUpdate();
+}
+
+void H9LoopPlayer::prepare(double sr, int)
+{
+    const int grain = grainFrames(sr);
+    for (auto& a : acc)
+        a.assign((size_t)grain, 0.0f);
+
+    gain.reset(sr, 0.05);
+    running.reset(sr, 0.01);
+    reset();
+
+    if (sampleRate.exchange(sr) != sr && !wanted.isEmpty())
+        startJob();
+}
+
+void H9LoopPlayer::load(const juce::File& newFile)
+{
+    load(H9SampleRef { newFile.getFullPathName(), {}, 0 }, {});
+}
+
+void H9LoopPlayer::load(const H9SampleRef& ref, const juce::File& root)
+{
+    if (ref.path == wanted.path && ref.hash == wanted.hash && root == libraryRoot
+        && loadedRate == sampleRate.load())
+        return;
+
+    wanted      = ref;
+    libraryRoot = root;
+    startJob();
+}
+
+void H9LoopPlayer::startJob()
+{
+    const int generation = ++requested;
+    loadedRate = sampleRate.load();
+
+    token.cancel();
+    token = {};
+
+    const bool findable = juce::File(wanted.path).existsAsFile()
+                       || (wanted.hash.isNotEmpty() && libraryRoot.isDirectory());
+    if (!findable || loadedRate <= 0.0)
+    {
+        infoSeconds.store(0.0);
+        infoBeats.store(0.0);
+        infoBpm.store(0.0);
+        return;
+    }
+
+    auto job = std::make_shared<Job>(shared, wanted, libraryRoot, loadedRate, generation);
+    jobs->submit(H9JobSystem::Priority::user, "loop analysis", token,
+                 [job](const H9JobToken& t) { job->run(t); });
+}
+
+void H9LoopPlayer::handleAsyncUpdate()
+{
+    std::unique_ptr<Analysis> analysis;
+    H9SampleRef ref;
+    bool fromName = false;
+    {
+        const juce::ScopedLock sl(shared->lock);
+        analysis = std::move(shared->completed);
+        ref      = shared->completedRef;
+        fromName = shared->completedFromName;
+    }
+
+    if (analysis == nullptr || analysis->generation != requested.load())
+        return;
+
+    const double seconds = analysis->length / analysis->sampleRate;
+    infoSeconds.store(seconds);
+    infoBeats.store(analysis->beats);
+    infoBpm.store(60.0 * analysis->beats / seconds);
+    infoFromName.store(fromName);
+
+    analyses.publish(std::move(analysis));
+
+    // A relinked loop reloads from where it was found on a rate change
+    wanted = ref;
+
+    if (onLoaded)
+        onLoaded(ref);
+}
+
+H9LoopPlayer::Info H9LoopPlayer::getInfo() const
+{
+    return { infoSeconds.load(), infoBeats.load(), infoBpm.load(), infoFromName.load() };
+}
+
+// ── Audio thread ─────────────────────────────────────────────────────────────
+
+void H9LoopPlayer::beginBlock() noexcept
+{
+    bool changed = false;
+    analyses.acquire(changed);
+
+    // A new loop starts at once, crossfading from the old one's last grain
+    if (changed)
+    {
+        previous   = -1;
+        clockValid = false;
+    }
+}
+
+bool H9LoopPlayer::isReady(const Analysis* a) const noexcept
+{
+    return a != nullptr && a->generation == requested.load(std::memory_order_relaxed)
+        && a->grain == (int)acc[0].size();
+}
+
+void H9LoopPlayer::reset() noexcept
+{
+    resetVoice();
+    gain.setCurrentAndTargetValue(gain.getTargetValue());
+    running.setCurrentAndTargetValue(0.0f);
+    clockValid = false;
+}
+
+void H9LoopPlayer::resetVoice() noexcept
+{
+    for (auto& a : acc)
+        std::fill(a.begin(), a.end(), 0.0f);
+
+    hopLeft  = 0;
+    hopPos   = 0;
+    previous = -1;
+    idle     = true;
+}
+
+void H9LoopPlayer::process(juce::AudioBuffer<float>& buffer, int numSamples, const Transport& transport) noexcept
+{
+    auto* a = analyses.get();
+    const bool ready  = isReady(a);
+    const bool follow = syncToHost && transport.synced;
+
+    running.setTargetValue(ready && (!follow || transport.playing) ? 1.0f : 0.0f);
+
+    const bool silent = (gain.getTargetValue() <= 0.0f && !gain.isSmoothing())
+                     || (running.getTargetValue() <= 0.0f && !running.isSmoothing());
+    if (!ready || silent || numSamples <= 0)
+    {
+        if (!idle)
+            resetVoice();
+        clockValid = false;
+        gain.skip(numSamples);
+        running.skip(numSamples);
+        return;
+    }
+
+    const double sr      = a->sampleRate;
+    const double loopBpm = 60.0 * a->beats * sr / a->length;
+    const double bpm     = syncToHost && transport.bpm > 0.0 ? transport.bpm : loopBpm;
+    const double beatsPerSample = bpm / (60.0 * sr);
+    stretch.store(bpm / loopBpm, std::memory_order_relaxed);
+
+    // The host's position wins; a difference bigger than the search can
+    // absorb is a jump, and the next grain starts fresh right away
+    bool restart = !clockValid;
+    if (follow && transport.playing)
+    {
+        restart |= std::abs(transport.beat - beat) > a->tolerance * beatsPerSample;
+        beat = transport.beat;
+    }
+    else if (!clockValid)
+    {
+        beat = 0.0;
+    }
+    clockValid = true;
+
+    if (restart)
+        previous = -1;
+
+    const int half = a->grain / 2;
+    const int numChannels = juce::jmin(2, buffer.getNumChannels());
+    float* out[2] = { buffer.getWritePointer(0), numChannels > 1 ? buffer.getWritePointer(1) : nullptr };
+
+    for (int i = 0; i < numSamples;)
+    {
+        if (hopLeft == 0 || restart)
+        {
+            // Centred: the grain's middle plays its nominal source frame
+            const double centreBeat = beat + (i + half) * beatsPerSample;
+            double phase = centreBeat / a->beats;
+            phase -= std::floor(phase);
+
+            startGrain(*a, phase * a->length - half, hopPos);
+            hopLeft = half;
+            hopPos  = 0;
+            restart = false;
+            idle    = false;
+        }
+
+        const int n = juce::jmin(hopLeft, numSamples - i);
+        for (int k = 0; k < n; ++k)
+        {
+            const float g = gain.getNextValue() * running.getNextValue();
+            for (int c = 0; c < numChannels; ++c)
+                out[c][i + k] += g * acc[c][(size_t)(hopPos + k)];
+        }
+
+        hopPos  += n;
+        hopLeft -= n;
+        i       += n;
+    }
+
+    beat += numSamples * beatsPerSample;
+
+    driftAge += numSamples;
+    if (driftAge >= (int)sr)
+    {
+        driftMs.store((float)(1000.0 * maxDrift / sr), std::memory_order_relaxed);
+        maxDrift = 0.0f;
+        driftAge = 0;
+    }
+}
+
+// Shifts out the `shift` samples already played, then overlap-adds the next
+// grain over the whole accumulator
+void H9LoopPlayer::startGrain(const Analysis& a, double nominalStart, int shift) noexcept
+{
+    const int grain = a.grain;
+    const int half  = grain / 2;
+    const int L     = a.length;
+    auto wrap = [L](int x) { return ((x % L) + L) % L; };
+
+    for (auto& buf : acc)
+    {
+        std::copy(buf.begin() + shift, buf.end(), buf.begin());
+        std::fill(buf.end() - shift, buf.end(), 0.0f);
+    }
+
+    const int nominal = wrap(juce::roundToInt(nominalStart));
+    int start = nominal;
+
+    if (previous >= 0)
+    {
+        const int continuation = wrap(previous + half);
+        const int d = std::abs(continuation - nominal);
+
+        // At the loop's own tempo the continuation is the nominal position
+        start = juce::jmin(d, L - d) <= 1 ? continuation : search(a, continuation, nominal);
+    }
+
+    const int d = std::abs(wrap(start) - nominal);
+    maxDrift = juce::jmax(maxDrift, (float)juce::jmin(d, L - d));
+    previous = wrap(start);
+
+    const float* w = a.window.data();
+    for (int c = 0; c < 2; ++c)
+    {
+        const float* src = a.audio.getReadPointer(juce::jmin(c, a.audio.getNumChannels() - 1)) + start;
+        float* dst = acc[c].data();
+
+        for (int j = 0; j < grain; j += lanes)
+            vstore(dst + j, vadd(vload(dst + j), vmul(vload(w + j), vload(src + j))));
+    }
+}
+
+// The start within ±tolerance of `nominal` whose first half best matches
+// the previous grain's natural continuation, with a slight preference for
+// staying near `nominal` (periodic material has many equal matches).
+// Returns a frame in
+// [nominal - tolerance, nominal + tolerance], unwrapped past the loop end
+// if need be (the analysis has the frames to read it).
+int H9LoopPlayer::search(const Analysis& a, int continuation, int nominal) noexcept
+{
+    const int L    = a.length;
+    const int tol  = a.tolerance;
+    const int half = a.grain / 2;
+    const int base = ((nominal - tol) % L + L) % L;   // candidates base … base + 2·tol
+
+    // Coarse: every 4th frame, on the 4:1 mix
+    const int len     = half / 4;
+    const int qTarget = continuation / 4;
+    const int qBase   = base / 4;
+    const int qCount  = tol / 2 + 1;
+
+    const float* t = a.coarse.data() + qTarget;
+    const float* c = a.coarse.data() + qBase;
+    const float eps = 1.0e-9f * (float)len;
+
+    // Normalised correlation, less up to 0.1 at the edge of the range
+    auto score = [tol](float correlation, float norm, int offset)
+    {
+        return correlation / norm - 0.1f * (float)std::abs(offset) / (float)tol;
+    };
+
+    float targetEnergy = dot(t, t, len) + eps;
+    float energy = dot(c, c, len);
+    float best = -1.0e30f;
+    int   bestQ = 0;
+
+    for (int k = 0; k < qCount; ++k)
+    {
+        const float s = score(dot(t, c + k, len), std::sqrt(targetEnergy * (energy + eps)), 4 * k - tol);
+        if (s > best)
+        {
+            best  = s;
+            bestQ = k;
+        }
+        energy = juce::jmax(0.0f, energy + c[k + len] * c[k + len] - c[k] * c[k]);
+    }
+
+    // Fine: the frames either side of the coarse match, on the full mix
+    const int centre = 4 * (qBase + bestQ) + (continuation - 4 * qTarget);
+    const int lo = juce::jmax(base, centre - 3);
+    const int hi = juce::jmin(base + 2 * tol, centre + 3);
+    if (lo > hi)
+        return juce::jlimit(base, base + 2 * tol, centre);
+
+    const float* m  = a.mono.data();
+    const float* tm = m + continuation;
+    targetEnergy = dot(tm, tm, half) + eps;
+    energy = dot(m + lo, m + lo, half);
+    best = -1.0e30f;
+    int bestStart = lo;
+
+    for (int p = lo; p <= hi; ++p)
+    {
+        const float s = score(dot(tm, m + p, half), std::sqrt(targetEnergy * (energy + eps)), p - base - tol);
+        if (s > best)
+        {
+            best = s;
+            bestStart = p;
+        }
+        energy = juce::jmax(0.0f, energy + m[p + half] * m[p + half] - m[p] * m[p]);
+    }
+
+    return bestStart;
+}
@@ -0,0 +1,156 @@
+#pragma once
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_events/juce_events.h>
+#include "Core/H9JobSystem.h"
+#include "Core/H9ObjectHandoff.h"
+#include "Data/H9PluginState.h"
+
+// ── H9LoopPlayer ────────────────────────────────────────────────────────────
+// One looping audio file, time-stretched to the host tempo without changing
+// its pitch. load() decodes the file as a user-priority job on H9JobSystem,
+// converts it to the host rate and works out its tempo — from a "120bpm" /
+// "_120_" in the file name, otherwise the whole number of 4/4 bars nearest
+// 120 BPM. The same job caches everything the stretcher reads: the audio
+// with a wrapped tail, a mono mix, the mono mix box-averaged by 4 for the
+// coarse search, and the grain window. It reaches the audio thread through
+// H9ObjectHandoff.
+//
+// Stretching is WSOLA: 46 ms Hann grains overlap-added at half a grain.
+// Each grain's nominal source position comes straight from the beat
+// position, so the loop stays locked to the bar grid with no error that
+// builds up. The grain then starts at the offset within ±tolerance of that
+// position that best continues the previous grain (normalised
+// cross-correlation, coarse on the decimated mix then refined to the
+// sample). The search, the correlation and the overlap-add all run four
+// samples per SIMD register, at a fixed cost per grain. At the loop's own
+// tempo the continuation is the nominal position and the search is
+// skipped.
+//
+// Synced, the loop follows the host's beat position while the transport
+// plays and fades out when it stops; a jump (locate, cycle) starts a fresh
+// grain straight away. Unsynced it plays continuously at its own tempo, and
+// so it does at the host's tempo when the host has no transport.
+
+class H9LoopPlayer : private juce::AsyncUpdater
+{
+public:
+    static constexpr double maxSeconds = 60.0;   // longer files are cut
+    static constexpr double grainMs    = 46.0;
+
+    struct Info
+    {
+        double seconds { 0.0 };   // 0 = no loop loaded
+        double beats   { 0.0 };
+        double bpm     { 0.0 };   // the loop's own tempo
+        bool   tempoFromName { false };
+    };
+
+    // The block's position, filled from the host playhead
+    struct Transport
+    {
+        bool   synced  { false };   // beat / playing come from the host
+        bool   playing { false };
+        double bpm     { 120.0 };
+        double beat    { 0.0 };     // at the first sample, counted in whole bars from bar 1
+    };
+
+    H9LoopPlayer();
+    ~H9LoopPlayer() override;
+
+    // Non-RT. Reloads the loop if the rate has changed.
+    void prepare(double sampleRate, int maxBlockSize);
+
+    // ── Message thread ──────────────────────────────────────────────────────
+
+    // A file that doesn't exist unloads
+    void load(const juce::File& file);
+
+    // A saved loop: its path, else a library file with its hash
+    // (H9SampleRelinker, on the load job). Unloads if neither is found.
+    void load(const H9SampleRef& ref, const juce::File& libraryRoot);
+    void collectGarbage() { analyses.collectGarbage(); }
+
+    // Called with the file's reference (path, hash, size) once it has loaded
+    std::function<void(const H9SampleRef&)> onLoaded;
+
+    Info getInfo() const;   // any thread — the loop in use once ready
+
+    // Time-stretch ratio (host / loop tempo) and the largest distance a
+    // grain started from its nominal position, in ms, over the last second
+    double getStretch() const noexcept  { return stretch.load(std::memory_order_relaxed); }
+    float  getDriftMs() const noexcept  { return driftMs.load(std::memory_order_relaxed); }
+
+    // ── Audio thread ────────────────────────────────────────────────────────
+
+    // Adopts a newly loaded loop
+    void beginBlock() noexcept;
+
+    void setLevel(float level) noexcept { gain.setTargetValue(juce::jmax(0.0f, level)); }
+    void setSynced(bool shouldSync) noexcept { syncToHost = shouldSync; }
+    void reset() noexcept;
+
+    // Adds the loop to the first one or two channels
+    void process(juce::AudioBuffer<float>& buffer, int numSamples, const Transport&) noexcept;
+
+private:
+    struct Analysis
+    {
+        double sampleRate { 0.0 };
+        int    length     { 0 };      // frames in one pass of the loop
+        double beats      { 0.0 };
+        int    grain      { 0 };      // frames, a multiple of 32
+        int    tolerance  { 0 };      // search reach either side, a multiple of 4
+        int    generation { 0 };
+
+        // All `length` + wrap frames long: reads never need to wrap
+        juce::AudioBuffer<float> audio;
+        std::vector<float> mono;
+        std::vector<float> coarse;    // mono, 4:1
+        std::vector<float> window;    // periodic Hann, `grain` long
+    };
+
+    struct Shared;
+    class Job;
+
+    std::shared_ptr<Shared> shared;
+    juce::SharedResourcePointer<H9JobSystem> jobs;
+    H9JobToken token;
+
+    // Message thread
+    H9SampleRef wanted;        // path only for files picked by the user
+    juce::File  libraryRoot;
+    double      loadedRate { 0.0 };
+
+    std::atomic<double> sampleRate { 0.0 };
+    std::atomic<int>    requested  { 0 };
+    std::atomic<double> infoSeconds { 0.0 }, infoBeats { 0.0 }, infoBpm { 0.0 };
+    std::atomic<bool>   infoFromName { false };
+    std::atomic<double> stretch { 1.0 };
+    std::atomic<float>  driftMs { 0.0f };
+
+    // Audio thread
+    H9ObjectHandoff<Analysis> analyses;
+    juce::SmoothedValue<float> gain { 0.0f };
+    juce::SmoothedValue<float> running { 0.0f };   // transport fade
+    bool   syncToHost { true };
+    double beat       { 0.0 };      // own clock at the next block
+    bool   clockValid { false };
+
+    std::vector<float> acc[2];      // overlap-add accumulator, one grain long
+    int    hopLeft  { 0 };          // samples of acc still to emit
+    int    hopPos   { 0 };
+    int    previous { -1 };         // source frame of the last grain; -1 = none
+    float  maxDrift { 0.0f };       // samples, since the last publish
+    int    driftAge { 0 };
+    bool   idle     { true };
+
+    bool isReady(const Analysis*) const noexcept;
+    void resetVoice() noexcept;
+    void startGrain(const Analysis&, double nominal, int shift) noexcept;
+    int  search(const Analysis&, int continuation, int nominal) noexcept;
+
+    void startJob();
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE(H9LoopPlayer)
+};
@@ -0,0 +1,222 @@
+#include "H9LoopSlicer.h"
+#include "Audio/H9OnsetDetector.h"
+#include "Audio/H9Resampler.h"
+#include "Audio/H9SampleRelinker.h"
+#include "Core/H9Trace.h"
+
+// ── Shared state ─────────────────────────────────────────────────────────────
+// Outlives the slicer if a job is still running when the plugin is deleted.
+
+struct H9LoopSlicer::Shared
+{
+    juce::CriticalSection lock;
+    H9LoopSlicer* owner { nullptr };     // cleared by ~H9LoopSlicer
+    std::unique_ptr<Result> completed;   // guarded by lock
+    int completedGeneration { 0 };
+};
+
+// ── Background job ───────────────────────────────────────────────────────────
+
+class H9LoopSlicer::Job
+{
+public:
+    Job(std::shared_ptr<Shared> s, H9SampleRef r, juce::File root, double rate, int gen)
+        : shared(std::move(s)), saved(std::move(r)), libraryRoot(std::move(root)),
+          targetRate(rate), generation(gen) {}
+
+    void run(const H9JobToken& token)
+    {
+        H9_TRACE_SCOPE("loop slicing");
+
+        bool relinked = false;
+        const auto file = H9SampleRelinker(libraryRoot).resolve(saved, token, relinked);
+
+        auto result = std::make_unique<Result>();
+        double rate = targetRate;
+        auto audio = read(file, result->ref, rate);
+        if (token.isCancelled())
+            return;
+
+        // Missing or unreadable: deliver the empty result so isSlicing() ends
+        if (audio == nullptr)
+        {
+            deliver(std::move(result));
+            return;
+        }
+
+        const auto t0 = juce::Time::getHighResolutionTicks();
+        const int length = audio->getNumSamples();
+
+        std::vector<float> mono((size_t)length);
+        for (int c = 0; c < audio->getNumChannels(); ++c)
+            juce::FloatVectorOperations::addWithMultiply(mono.data(), audio->getReadPointer(c),
+                                                         1.0f / (float)audio->getNumChannels(), length);
+
+        H9OnsetDetector detector(rate);
+        const auto onsets = detector.detect(mono.data(), length);
+        result->starts    = detector.pickSlices(onsets, numPads);
+        result->numOnsets = (int)onsets.size();
+        result->analysisMs = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - t0) * 1000.0;
+
+        if (token.isCancelled())
+            return;
+
+        result->set = std::make_unique<H9SampleSet>();
+        const int numSlices = (int)result->starts.size();
+        for (int i = 0; i < numSlices; ++i)
+        {
+            const int start = result->starts[(size_t)i];
+            const int end   = i + 1 < numSlices ? result->starts[(size_t)i + 1] : length;
+
+            auto& pad = result->set->pads[(size_t)i];
+            pad.store.share(audio, start, end - start);
+            pad.sampleRate = rate;
+            pad.path       = result->ref.path;
+        }
+
+        deliver(std::move(result));
+    }
+
+private:
+    std::shared_ptr<Shared> shared;
+    H9SampleRef saved;
+    juce::File  libraryRoot;
+    double targetRate;
+    int    generation;
+
+    void deliver(std::unique_ptr<Result> result)
+    {
+        const juce::ScopedLock sl(shared->lock);
+        if (shared->owner != nullptr)
+        {
+            shared->completed = std::move(result);
+            shared->completedGeneration = generation;
+            shared->owner->triggerAsyncUpdate();
+        }
+    }
+
+    // Reads the file once: the same bytes are hashed and decoded. `rate` is
+    // the target, or the file's own when the target is 0.
+    std::shared_ptr<const juce::AudioBuffer<float>> read(const juce::File& file, H9SampleRef& ref,
+                                                         double& rate) const
+    {
+        juce::MemoryBlock bytes;
+        if (!file.loadFileAsData(bytes) || bytes.getSize() == 0)
+            return {};
+
+        ref.path = file.getFullPathName();
+        ref.hash = juce::MD5(bytes).toHexString();
+        ref.size = (juce::int64)bytes.getSize();
+
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(
+            std::make_unique<juce::MemoryInputStream>(bytes, false)));
+        if (reader == nullptr || reader->lengthInSamples <= 0 || reader->sampleRate <= 0.0)
+            return {};
+
+        const int channels = juce::jlimit(1, 2, (int)reader->numChannels);
+        const int length   = (int)juce::jmin(reader->lengthInSamples,
+                                             (juce::int64)(maxSeconds * reader->sampleRate));
+
+        juce::AudioBuffer<float> audio(channels, length);
+        reader->read(&audio, 0, length, 0, true, channels > 1);
+
+        if (rate > 0.0 && H9Resampler::needsConversion(reader->sampleRate, rate))
+            audio = H9Resampler::process(audio, reader->sampleRate, rate);
+        else
+            rate = reader->sampleRate;
+
+        return std::make_shared<const juce::AudioBuffer<float>>(std::move(audio));
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(Job)
+};
+
+// ── H9LoopSlicer ─────────────────────────────────────────────────────────────
+
+H9LoopSlicer::H9LoopSlicer()
+    : shared(std::make_shared<Shared>())
+{
+    shared->owner = this;
+}
+
+H9LoopSlicer::~H9LoopSlicer()
+{
+    {
+        const juce::ScopedLock sl(shared->lock);
+        shared->owner = nullptr;
+    }
+    token.cancel();
+    cancelPendingUpdate();
+}
+
+void H9LoopSlicer::slice(const juce::File& file, double targetSampleRate)
+{
+    slice({ file.getFullPathName(), {}, 0 }, {}, targetSampleRate);
+}
+
+void H9LoopSlicer::slice(const H9SampleRef& ref, const juce::File& libraryRoot, double targetSampleRate)
+{
+    const int generation = ++requested;
+
+    token.cancel();
+    token = {};
+
+    // Nothing to find: no file at the path and no hash to search by
+    if (!juce::File(ref.path).existsAsFile() && (ref.hash.isEmpty() || !libraryRoot.isDirectory()))
+    {
+        busy.store(false, std::memory_order_relaxed);
+        return;
+    }
+
+    busy.store(true, std::memory_order_relaxed);
+
+    auto job = std::make_shared<Job>(shared, ref, libraryRoot, targetSampleRate, generation);
+    jobs->submit(H9JobSystem::Priority::user, "loop slicing", token,
+                 [job](const H9JobToken& t) { job->run(t); });
+}
+
+void H9LoopSlicer::cancel()
+{
+    ++requested;
+    token.cancel();
+    token = {};
+    busy.store(false, std::memory_order_relaxed);
+
+    infoSlices.store(0);
+    infoOnsets.store(0);
+    infoMs.store(0.0);
+}
+
+void H9LoopSlicer::handleAsyncUpdate()
+{
+    std::unique_ptr<Result> result;
+    int generation = 0;
+    {
+        const juce::ScopedLock sl(shared->lock);
+        result     = std::move(shared->completed);
+        generation = shared->completedGeneration;
+    }
+
+    if (result == nullptr || generation != requested.load())
+        return;
+
+    busy.store(false, std::memory_order_relaxed);
+
+    if (result->set == nullptr)
+        return;   // the loop wasn't found or couldn't be read
+
+    infoSlices.store((int)result->starts.size());
+    infoOnsets.store(result->numOnsets);
+    infoMs.store(result->analysisMs);
+
+    if (onSliced)
+        onSliced(std::move(*result));
+}
+
+H9LoopSlicer::Info H9LoopSlicer::getInfo() const
+{
+    return { infoSlices.load(), infoOnsets.load(), infoMs.load() };
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_events/juce_events.h>
+#include "Audio/H9PadSampler.h"
+#include "Core/H9JobSystem.h"
+#include "Data/H9PluginState.h"
+
+// ── H9LoopSlicer ────────────────────────────────────────────────────────────
+// Chops a loop across the eight pads. slice() decodes the file as a
+// user-priority job on H9JobSystem, converts it to the host rate and finds
+// its onsets with H9OnsetDetector; the loop is then cut at its start and
+// the seven strongest onsets, each on a zero crossing, so the pads played
+// in order give back the whole loop. The slices make a virtual kit: every
+// pad's store is a view of its region of the one decoded loop
+// (H9SampleStore::share), nothing copied, and the loop is freed with the
+// last set that uses it.
+//
+// A saved loop that has moved is found again in the library by its hash
+// (H9SampleRelinker), on the same job. Only the newest request is
+// delivered — each slice() cancels the last.
+
+class H9LoopSlicer : private juce::AsyncUpdater
+{
+public:
+    static constexpr int    numPads    = H9SampleSet::numPads;
+    static constexpr double maxSeconds = 60.0;   // longer files are cut
+
+    struct Result
+    {
+        std::unique_ptr<H9SampleSet> set;
+        H9SampleRef ref;                  // the loop's path, hash and size
+        std::vector<int> starts;          // slice starts, frames at the set's rate
+        int    numOnsets  { 0 };          // found, before picking the strongest
+        double analysisMs { 0.0 };        // onset detection and slicing, decode excluded
+    };
+
+    struct Info
+    {
+        int    slices     { 0 };          // 0 = pads aren't sliced
+        int    onsets     { 0 };
+        double analysisMs { 0.0 };
+    };
+
+    H9LoopSlicer();
+    ~H9LoopSlicer() override;
+
+    // ── Message thread ──────────────────────────────────────────────────────
+    // `targetSampleRate` 0 keeps the file's rate
+    void slice(const juce::File& file, double targetSampleRate);
+
+    // A saved loop: its path, else a library file with its hash
+    void slice(const H9SampleRef& ref, const juce::File& libraryRoot, double targetSampleRate);
+
+    // Drops any request in flight, e.g. because a kit is loading instead
+    void cancel();
+
+    bool isSlicing() const noexcept { return busy.load(std::memory_order_relaxed); }
+
+    // Called on the message thread with the newest finished request
+    std::function<void(Result&&)> onSliced;
+
+    // Any thread — the last delivered result, or zeros after cancel()
+    Info getInfo() const;
+
+private:
+    struct Shared;
+    class Job;
+
+    std::shared_ptr<Shared> shared;
+    juce::SharedResourcePointer<H9JobSystem> jobs;
+    H9JobToken token;
+    std::atomic<int>  requested { 0 };
+    std::atomic<bool> busy { false };
+
+    std::atomic<int>    infoSlices { 0 }, infoOnsets { 0 };
+    std::atomic<double> infoMs { 0.0 };
+
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE(H9LoopSlicer)
+};
@@ -0,0 +1,246 @@
+#include "H9OnsetDetector.h"
+#include "Audio/H9Simd.h"
+
+namespace
+{
+    using namespace H9Simd;
+
+    constexpr int   envelopeBlock = 32;
+    constexpr float peakMs        = 15.0f;   // an onset is the largest flux within this
+    constexpr float historyMs     = 40.0f;   // … and stands out from the mean over this
+    constexpr double lowestBandHz = 40.0;
+    const double     bandRatio    = std::pow(2.0, 0.25);
+
+    int fftOrderFor(double sampleRate) noexcept
+    {
+        return 10 + (sampleRate > 50000.0 ? 1 : 0) + (sampleRate > 100000.0 ? 1 : 0);
+    }
+}
+
+H9OnsetDetector::H9OnsetDetector(double sr)
+    : sampleRate(sr),
+      order(fftOrderFor(sr)),
+      frameSize(1 << order),
+      hop(frameSize / 2),
+      fft(order)
+{
+    // Periodic Hann
+    window.resize((size_t)frameSize);
+    for (int i = 0; i < frameSize; ++i)
+        window[(size_t)i] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * (float)i / (float)frameSize);
+
+    // Quarter-octave bands from 40 Hz, at least a bin wide, each counted
+    // once whatever its width
+    const double binHz = sr / frameSize;
+    const double top   = juce::jmin(16000.0, 0.5 * sr);
+    bandEdges.push_back(juce::jmax(1, (int)(lowestBandHz / binHz)));
+    for (double hz = lowestBandHz * bandRatio; hz < top * bandRatio; hz *= bandRatio)
+    {
+        const int edge = juce::jmin(frameSize / 2, (int)std::ceil(juce::jmin(hz, top) / binHz));
+        if (edge > bandEdges.back())
+            bandEdges.push_back(edge);
+    }
+
+    // Padded to whole SIMD registers with bands that stay zero
+    const size_t numBands = bandEdges.size() - 1;
+    bands.assign((numBands + lanes - 1) / lanes * lanes, 0.0f);
+    previous.assign(bands.size(), 0.0f);
+    frame.assign((size_t)frameSize * 2, 0.0f);
+}
+
+std::vector<H9OnsetDetector::Onset> H9OnsetDetector::detect(const float* mono, int numFrames)
+{
+    flux.clear();
+    if (numFrames <= 0)
+        return {};
+
+    // ── Flux: frame h is centred on sample h · hop ─────────────────────────
+    const int numHops  = (numFrames + hop - 1) / hop;
+    flux.resize((size_t)numHops);
+    std::fill(previous.begin(), previous.end(), 0.0f);
+
+    float* f = frame.data();
+    for (int h = 0; h < numHops; ++h)
+    {
+        const int start = h * hop - frameSize / 2;
+        const int from  = juce::jmax(0, -start);
+        const int to    = juce::jmin(frameSize, numFrames - start);
+
+        std::fill(frame.begin(), frame.end(), 0.0f);
+        if (to > from)
+            std::copy(mono + start + from, mono + start + to, f + from);
+
+        for (int i = 0; i < frameSize; i += lanes)
+            vstore(f + i, vmul(vload(f + i), vload(window.data() + i)));
+
+        fft.performFrequencyOnlyForwardTransform(f, true);
+
+        // Mean magnitude per band, log-compressed
+        for (size_t b = 0; b + 1 < bandEdges.size(); ++b)
+        {
+            const int lo = bandEdges[b], hi = bandEdges[b + 1];
+            float m = 0.0f;
+            for (int k = lo; k < hi; ++k)
+                m += f[k];
+            bands[b] = std::log1p(m / (float)(hi - lo));
+        }
+
+        Vec sum = vset(0.0f);
+        for (size_t b = 0; b < bands.size(); b += lanes)
+        {
+            const Vec now = vload(bands.data() + b);
+            sum = vadd(sum, vmax(vsub(now, vload(previous.data() + b)), vset(0.0f)));
+            vstore(previous.data() + b, now);
+        }
+        flux[(size_t)h] = vsum(sum);
+    }
+
+    // ── Picking ────────────────────────────────────────────────────────────
+    double mean = 0.0, square = 0.0;
+    for (float v : flux)
+    {
+        mean   += v;
+        square += (double)v * v;
+    }
+    mean /= numHops;
+    const float deviation = (float)std::sqrt(juce::jmax(0.0, square / numHops - mean * mean));
+    if (deviation <= 1.0e-9f)
+        return {};
+
+    const double hopMs = 1000.0 * hop / sampleRate;
+    const int reach   = juce::jmax(1, juce::roundToInt(peakMs / hopMs));
+    const int history = juce::jmax(1, juce::roundToInt(historyMs / hopMs));
+
+    std::vector<Onset> onsets;
+    for (int h = 0; h < numHops; ++h)
+    {
+        const float v = flux[(size_t)h];
+
+        // Strictly above earlier frames, so a plateau counts once
+        bool isPeak = true;
+        for (int k = juce::jmax(0, h - reach); k < juce::jmin(numHops, h + reach + 1) && isPeak; ++k)
+            isPeak = k < h ? v > flux[(size_t)k] : v >= flux[(size_t)k];
+        if (!isPeak)
+            continue;
+
+        float local = 0.0f;
+        const int first = juce::jmax(0, h - history);
+        for (int k = first; k < h; ++k)
+            local += flux[(size_t)k];
+        if (h > first)
+            local /= (float)(h - first);
+
+        const float strength = (v - local) / deviation;
+        if (strength < threshold)
+            continue;
+
+        const Onset onset { snapToZeroCrossing(mono, numFrames, locate(mono, numFrames, h)), strength };
+
+        // Two flux peaks on one attack
+        if (!onsets.empty() && onset.frame - onsets.back().frame < reach * hop)
+        {
+            if (onset.strength > onsets.back().strength)
+                onsets.back() = onset;
+            continue;
+        }
+
+        onsets.push_back(onset);
+    }
+
+    return onsets;
+}
+
+std::vector<int> H9OnsetDetector::pickSlices(const std::vector<Onset>& onsets, int maxSlices,
+                                             float minGapMs) const
+{
+    if (maxSlices <= 0)
+        return {};
+
+    auto strongest = onsets;
+    std::stable_sort(strongest.begin(), strongest.end(),
+                     [](const Onset& a, const Onset& b) { return a.strength > b.strength; });
+
+    const int gap = juce::roundToInt(minGapMs * 0.001 * sampleRate);
+    std::vector<int> starts { 0 };
+
+    for (const auto& o : strongest)
+    {
+        if ((int)starts.size() >= maxSlices)
+            break;
+
+        const bool clear = std::all_of(starts.begin(), starts.end(),
+                                       [&](int s) { return std::abs(o.frame - s) >= gap; });
+        if (clear)
+            starts.push_back(o.frame);
+    }
+
+    std::sort(starts.begin(), starts.end());
+    return starts;
+}
+
+// Where the attack in flux frame `h` starts: the 32-sample peak envelope
+// over the frame, walked back from its maximum to
+// the last block below a quarter of the way up from the floor before it —
+// plus one block of margin
+int H9OnsetDetector::locate(const float* mono, int numFrames, int h) const noexcept
+{
+    const int from = juce::jlimit(0, numFrames, h * hop - frameSize / 2);
+    const int to   = juce::jlimit(from, numFrames, h * hop + frameSize / 2);
+    constexpr int maxBlocks = (1 << 12) / envelopeBlock;   // the largest frame
+    const int numBlocks = juce::jmin(maxBlocks, (to - from) / envelopeBlock);
+    if (numBlocks < 2)
+        return from;
+
+    float envelope[maxBlocks];
+    int peak = 0;
+
+    for (int k = 0; k < numBlocks; ++k)
+    {
+        const auto range = juce::FloatVectorOperations::findMinAndMax(mono + from + k * envelopeBlock, envelopeBlock);
+        envelope[k] = juce::jmax(-range.getStart(), range.getEnd());
+        if (envelope[k] > envelope[peak])
+            peak = k;
+    }
+
+    float floor = envelope[peak];
+    for (int k = 0; k <= peak; ++k)
+        floor = juce::jmin(floor, envelope[k]);
+
+    const float rise = floor + 0.25f * (envelope[peak] - floor);
+    int k = peak;
+    while (k > 0 && envelope[k - 1] >= rise)
+        --k;
+
+    return from + juce::jmax(0, k - 1) * envelopeBlock;
+}
+
+// The nearest sign change at or before `position` within snapMs, else the
+// nearest after it; `position` itself when there is neither
+int H9OnsetDetector::snapToZeroCrossing(const float* mono, int numFrames, int position) const noexcept
+{
+    const int reach = juce::jmax(1, juce::roundToInt(snapMs * 0.001 * sampleRate));
+
+    auto crossesAt = [mono](int i) noexcept
+    {
+        return mono[i] == 0.0f || (mono[i - 1] < 0.0f) != (mono[i] < 0.0f);
+    };
+
+    // Of the two samples either side, the quieter
+    auto quieter = [mono](int i) noexcept
+    {
+        return std::abs(mono[i - 1]) < std::abs(mono[i]) ? i - 1 : i;
+    };
+
+    position = juce::jlimit(0, juce::jmax(0, numFrames - 1), position);
+
+    // The start of the loop counts as a crossing — nothing plays before it
+    for (int i = position; i >= juce::jmax(0, position - reach); --i)
+        if (i == 0 || crossesAt(i))
+            return i == 0 ? 0 : quieter(i);
+
+    for (int i = juce::jmax(1, position + 1); i < juce::jmin(numFrames, position + reach); ++i)
+        if (crossesAt(i))
+            return quieter(i);
+
+    return position;
+}
@@ -0,0 +1,574 @@
+#include "H9PadSampler.h"
+
+using H9VoiceKernels::maxFramesBefore;
+using H9VoiceKernels::maxFramesAfter;
+
+// ── Setup ────────────────────────────────────────────────────────────────────
+
+H9PadSampler::H9PadSampler()
+{
+    // Sinc tables are built once per process, never on the audio thread
+    H9VoiceKernels::prepareTables();
+
+    for (int i = numSlots; --i >= 0;)
+        freeSlots[(size_t)numFree++] = i;
+
+    scratch.resize((size_t)H9RealtimeWorkers::maxThreads);
+    voiceBus.setSize(2 * numSlots, 512);
+}
+
+void H9PadSampler::prepare(double sampleRate, int maxBlockSize)
+{
+    voiceBus.setSize(2 * numSlots, juce::jmax(1, maxBlockSize));
+    hostSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
+    releaseSamples = juce::jmax(16, juce::roundToInt(releaseSeconds * hostSampleRate));
+    releaseStep    = 1.0f / (float)releaseSamples;
+    voiceDsp.prepare(hostSampleRate);
+    granular.prepare(hostSampleRate);
+    allNotesOff();
+
+    textureTicks.fill(0);
+    activeGrains.store(0);
+    peakGrains.store(0);
+    droppedGrains.store(0);
+}
+
+void H9PadSampler::setSampleSet(std::unique_ptr<H9SampleSet> set)
+{
+    const juce::ScopedLock sl(diskStreams.getSourceLock());
+    sampleSets.publish(std::move(set));
+}
+
+void H9PadSampler::collectGarbage()
+{
+    const juce::ScopedLock sl(diskStreams.getSourceLock());
+    sampleSets.collectGarbage();
+}
+
+// ── Block lifecycle ─────────────────────────────────────────────────────────
+
+void H9PadSampler::beginBlock() noexcept
+{
+    // Voices index into the old set's buffers, and their disk streams read
+    // its stream sources — a kit change cuts them before the set is retired
+    bool changed = false;
+    sampleSets.acquire(changed, [this] { allNotesOff(); });
+
+    padPeaks.fill(0.0f);
+}
+
+void H9PadSampler::allNotesOff() noexcept
+{
+    for (auto& v : voices)
+        stopVoice(v);
+}
+
+void H9PadSampler::setVoiceLimit(int limit) noexcept
+{
+    voiceLimit = juce::jlimit(1, maxVoices, limit);
+
+    while (playing.size > voiceLimit)
+        releaseVoice(voices[(size_t)playing.head], 0);
+}
+
+// ── Voice lists ─────────────────────────────────────────────────────────────
+
+void H9PadSampler::pushBack(List& list, Links Voice::* links, int slot) noexcept
+{
+    auto& l = voices[(size_t)slot].*links;
+    l.prev = list.tail;
+    l.next = -1;
+
+    if (list.tail >= 0)
+        (voices[(size_t)list.tail].*links).next = slot;
+    else
+        list.head = slot;
+
+    list.tail = slot;
+    ++list.size;
+}
+
+void H9PadSampler::unlink(List& list, Links Voice::* links, int slot) noexcept
+{
+    auto& l = voices[(size_t)slot].*links;
+
+    if (l.prev >= 0) (voices[(size_t)l.prev].*links).next = l.next;
+    else             list.head = l.next;
+
+    if (l.next >= 0) (voices[(size_t)l.next].*links).prev = l.prev;
+    else             list.tail = l.prev;
+
+    l = {};
+    --list.size;
+}
+
+// ── Voice allocation ────────────────────────────────────────────────────────
+
+bool H9PadSampler::startVoice(int pad, float velocity, int sampleOffset, float semitones) noexcept
+{
+    auto* set = sampleSets.get();
+    if (set == nullptr || !juce::isPositiveAndBelow(pad, numPads))
+        return false;
+
+    auto& sample = set->pads[(size_t)pad];
+    if (!sample.isValid())
+        return false;
+
+    const int   offset = juce::jmax(0, sampleOffset);
+    const float vel    = juce::jlimit(0.0f, 1.0f, velocity);
+
+    // Choke: this hit fades out every other pad in its group
+    if (sample.chokeGroup > 0)
+        for (int p = 0; p < numPads; ++p)
+            if (p != pad && set->pads[(size_t)p].chokeGroup == sample.chokeGroup)
+                while (byPad[(size_t)p].head >= 0)
+                    releaseVoice(voices[(size_t)byPad[(size_t)p].head], offset);
+
+    // Pool full: steal this pad's oldest voice, else the oldest overall
+    if (playing.size >= voiceLimit)
+    {
+        const int victim = byPad[(size_t)pad].head >= 0 ? byPad[(size_t)pad].head : playing.head;
+        releaseVoice(voices[(size_t)victim], offset);
+    }
+
+    // Every slot busy fading — cut the oldest fade
+    if (numFree == 0)
+        stopVoice(voices[(size_t)releasing.head]);
+
+    const int slot = freeSlots[(size_t)--numFree];
+    auto& v = voices[(size_t)slot];
+
+    v.state        = VoiceState::playing;
+    v.active       = true;
+    v.pad          = pad;
+    v.position     = 0.0;
+    v.increment    = sample.sampleRate / hostSampleRate;
+    v.gain         = sample.gain * vel;
+    v.startDelay   = offset;
+    v.releaseDelay = 0;
+    v.releaseLeft  = -1;
+
+    const float pitch = juce::jlimit(-48.0f, 48.0f, sample.tune + sample.velocityToPitch * vel + semitones);
+    if (pitch != 0.0f)
+        v.increment *= std::exp2((double)pitch / 12.0);
+
+    // Grains read the whole sample in place
+    v.texture = texturePads[(size_t)pad] && sample.stream == nullptr
+             && sample.store.getFloatPointer(0) != nullptr
+             && sample.store.getNumFrames() >= H9GranularEngine::minSourceFrames;
+    if (v.texture)
+        granular.startVoice(slot, v.increment, v.gain);
+
+    pushBack(playing, &Voice::order, slot);
+    pushBack(byPad[(size_t)pad], &Voice::padOrder, slot);
+    voiceDsp.startVoice(slot, pad);
+
+    // Start reading the rest straight away; the head covers the latency.
+    // The stream overlaps the head by a full interpolation kernel.
+    v.streaming = sample.stream != nullptr;
+    if (v.streaming)
+        diskStreams.start(slot, sample.stream.get(),
+                          juce::jmax(0, sample.store.getNumFrames() - maxFramesAfter - maxFramesBefore));
+
+    return true;
+}
+
+// Moves a playing voice to the release list; its fade begins `sampleOffset`
+// samples into the next render() call, where the hit that displaced it lands
+void H9PadSampler::releaseVoice(Voice& v, int sampleOffset) noexcept
+{
+    if (v.startDelay > 0 && v.startDelay >= sampleOffset)
+    {
+        stopVoice(v);   // would not have been heard yet
+        return;
+    }
+
+    const int slot = indexOf(v);
+    unlink(playing, &Voice::order, slot);
+    unlink(byPad[(size_t)v.pad], &Voice::padOrder, slot);
+    pushBack(releasing, &Voice::order, slot);
+
+    v.state        = VoiceState::releasing;
+    v.releaseDelay = sampleOffset - v.startDelay;
+    v.releaseLeft  = releaseSamples;
+}
+
+void H9PadSampler::stopVoice(Voice& v) noexcept
+{
+    if (v.state == VoiceState::idle)
+        return;
+
+    const int slot = indexOf(v);
+    if (v.state == VoiceState::playing)
+    {
+        unlink(playing, &Voice::order, slot);
+        unlink(byPad[(size_t)v.pad], &Voice::padOrder, slot);
+    }
+    else
+    {
+        unlink(releasing, &Voice::order, slot);
+    }
+
+    if (v.streaming)
+        diskStreams.stop(slot);
+    if (v.texture)
+        granular.stopVoice(slot);
+
+    v.state     = VoiceState::idle;
+    v.active    = false;
+    v.streaming = false;
+    v.texture   = false;
+    freeSlots[(size_t)numFree++] = slot;
+}
+
+void H9PadSampler::advanceRelease(Voice& v, int numRendered) noexcept
+{
+    if (v.releaseDelay > 0)
+        v.releaseDelay -= numRendered;
+    else if (v.releaseLeft >= 0 && (v.releaseLeft -= numRendered) <= 0)
+        v.active = false;
+}
+
+// ── Rendering ───────────────────────────────────────────────────────────────
+
+void H9PadSampler::render(juce::AudioBuffer<float>& out, int startSample, int numSamples,
+                          H9RealtimeWorkers* workers) noexcept
+{
+    auto* set = sampleSets.get();
+    if (set == nullptr || numSamples <= 0) return;
+
+    // Hosts may exceed the prepared block size; work in voiceBus-sized chunks
+    const int chunk = voiceBus.getNumSamples();
+    for (int pos = 0; pos < numSamples; pos += chunk)
+        renderChunk(*set, out, startSample + pos, juce::jmin(chunk, numSamples - pos), workers);
+
+    // Grain statistics, with every voice thread done
+    const int grains = granular.getNumGrains();
+    activeGrains.store(grains, std::memory_order_relaxed);
+    if (grains > peakGrains.load(std::memory_order_relaxed))
+        peakGrains.store(grains, std::memory_order_relaxed);
+    droppedGrains.store(granular.getDroppedGrains(), std::memory_order_relaxed);
+}
+
+juce::int64 H9PadSampler::takeTextureTicks() noexcept
+{
+    juce::int64 ticks = 0;
+    for (auto& t : textureTicks)
+    {
+        ticks += t;
+        t = 0;
+    }
+    return ticks;
+}
+
+H9PadSampler::GrainStats H9PadSampler::getGrainStats() const noexcept
+{
+    return { activeGrains.load(std::memory_order_relaxed),
+             peakGrains.load(std::memory_order_relaxed),
+             droppedGrains.load(std::memory_order_relaxed) };
+}
+
+void H9PadSampler::renderChunk(const H9SampleSet& set, juce::AudioBuffer<float>& out, int startSample,
+                               int numSamples, H9RealtimeWorkers* workers) noexcept
+{
+    // Playing then releasing, oldest first. The reduction below follows this
+    // order whichever thread rendered each voice.
+    int numJobs = 0;
+    for (auto* list : { &playing, &releasing })
+        for (int i = list->head; i >= 0; i = voices[(size_t)i].order.next)
+            jobs[(size_t)numJobs++] = i;
+
+    if (numJobs == 0) return;
+
+    const bool stereoOut = out.getNumChannels() > 1;
+
+    // Fetched here: AudioBuffer's write accessors aren't safe to call from
+    // several threads at once
+    float* const* slotChannels = voiceBus.getArrayOfWritePointers();
+
+    // Touches only the voice, its bus slot and disk stream, and the
+    // thread's scratch
+    auto renderJob = [&](int job, int thread)
+    {
+        const int slot = jobs[(size_t)job];
+        auto& v = voices[(size_t)slot];
+
+        const Bus bus { slotChannels[2 * slot],
+                        stereoOut ? slotChannels[2 * slot + 1] : nullptr };
+
+        juce::FloatVectorOperations::clear(bus.left, numSamples);
+        if (bus.right != nullptr)
+            juce::FloatVectorOperations::clear(bus.right, numSamples);
+
+        voicePeaks[(size_t)slot] = renderVoice(v, set.pads[(size_t)v.pad], bus, numSamples,
+                                               scratch[(size_t)thread]);
+    };
+
+    if (workers != nullptr && numJobs >= minParallelVoices && numSamples >= minParallelSamples)
+        workers->run(numJobs, renderJob);
+    else
+        for (int job = 0; job < numJobs; ++job)
+            renderJob(job, 0);
+
+    // Envelopes and filters, in place on the bus; replaces those voices' peaks
+    int numShaped = 0;
+    for (int job = 0; job < numJobs; ++job)
+        if (!voiceDsp.isNeutral(voices[(size_t)jobs[(size_t)job]].pad))
+            shaped[(size_t)numShaped++] = jobs[(size_t)job];
+
+    if (numShaped > 0)
+        voiceDsp.process(shaped.data(), numShaped, slotChannels, stereoOut, numSamples,
+                         voiceStarts.data(), voicePeaks.data());
+
+    for (int job = 0; job < numJobs; ++job)
+    {
+        const int slot = jobs[(size_t)job];
+        auto& v = voices[(size_t)slot];
+
+        juce::FloatVectorOperations::add(out.getWritePointer(0, startSample),
+                                         voiceBus.getReadPointer(2 * slot), numSamples);
+        if (stereoOut)
+            juce::FloatVectorOperations::add(out.getWritePointer(1, startSample),
+                                             voiceBus.getReadPointer(2 * slot + 1), numSamples);
+
+        auto& padPeak = padPeaks[(size_t)v.pad];
+        padPeak = juce::jmax(padPeak, voicePeaks[(size_t)slot]);
+
+        if (!v.active || voiceDsp.hasDecayed(slot))
+            stopVoice(v);
+    }
+}
+
+// Renders one voice into `out` from sample 0 and returns its peak
+float H9PadSampler::renderVoice(Voice& v, const H9PadSample& sample, Bus out,
+                                int numSamples, Scratch& tmp) noexcept
+{
+    const int skip = juce::jmin(v.startDelay, numSamples);
+    v.startDelay -= skip;
+    voiceStarts[(size_t)indexOf(v)] = skip;
+
+    if (v.texture)
+        return renderTexture(v, sample, out, skip, numSamples);
+
+    const auto& store    = sample.store;
+    const int   resident = store.getNumFrames();
+    const int   length   = sample.getLength();
+    const int   rightChannel = store.getNumChannels() > 1 ? 1 : 0;
+    const auto* floatL   = store.getFloatPointer(0);
+
+    float peak = 0.0f;
+    int pos = skip;
+    const int end = numSamples;
+
+    while (pos < end && v.active)
+    {
+        const int idx  = (int)v.position;
+        const int from = pos;
+
+        // Full gain up to a pending choke / steal, then no further than the fade
+        int stop = end;
+        if (v.releaseDelay > 0)       stop = juce::jmin(end, pos + v.releaseDelay);
+        else if (v.releaseLeft >= 0)  stop = juce::jmin(end, pos + v.releaseLeft);
+
+        if (idx + maxFramesAfter >= resident && resident < length)
+        {
+            // Past the resident head of a streamed pad
+            pos = renderStream(v, sample, out, pos, stop, peak, tmp);
+        }
+        else if (floatL != nullptr)
+        {
+            pos = renderWindow(v, { floatL, store.getFloatPointer(rightChannel), 0, resident, length },
+                               out, pos, stop, peak, tmp);
+        }
+        else
+        {
+            // Packed / compressed: decode a window around the play head
+            const int base   = (juce::jmax(0, idx - maxFramesBefore) / H9SampleStore::blockFrames)
+                             * H9SampleStore::blockFrames;
+            const int frames = juce::jmin(decodeFrames, resident - base);
+            if (frames <= 0) { v.active = false; break; }
+
+            store.decode(0, base, frames, tmp.decodeL.data());
+            if (rightChannel != 0)
+                store.decode(1, base, frames, tmp.decodeR.data());
+
+            const float* srcR = rightChannel != 0 ? tmp.decodeR.data() : tmp.decodeL.data();
+            pos = renderWindow(v, { tmp.decodeL.data(), srcR, base, base + frames, length },
+                               out, pos, stop, peak, tmp);
+        }
+
+        advanceRelease(v, pos - from);
+    }
+
+    return peak;
+}
+
+// A texture voice's grains over [pos, end). A choke / steal fades the whole
+// cloud out over the release time, as it would a one-shot.
+float H9PadSampler::renderTexture(Voice& v, const H9PadSample& sample, Bus out,
+                                  int pos, int end) noexcept
+{
+    const int  slot  = indexOf(v);
+    const auto start = juce::Time::getHighResolutionTicks();
+
+    const auto& store = sample.store;
+    const H9GranularEngine::Source src { store.getFloatPointer(0),
+                                         store.getFloatPointer(store.getNumChannels() > 1 ? 1 : 0),
+                                         store.getNumFrames() };
+
+    while (pos < end && v.active)
+    {
+        const int from = pos;
+
+        int stop = end;
+        if (v.releaseDelay > 0)       stop = juce::jmin(end, pos + v.releaseDelay);
+        else if (v.releaseLeft >= 0)  stop = juce::jmin(end, pos + v.releaseLeft);
+
+        const int n = stop - from;
+        if (!granular.render(slot, src, out.left + from, out.right != nullptr ? out.right + from : nullptr, n))
+            v.active = false;
+
+        if (v.releaseDelay == 0 && v.releaseLeft >= 0)
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                const float g = releaseStep * (float)(v.releaseLeft - i);
+                out.left[from + i] *= g;
+                if (out.right != nullptr)
+                    out.right[from + i] *= g;
+            }
+        }
+
+        pos = stop;
+        advanceRelease(v, n);
+    }
+
+    textureTicks[(size_t)slot] += juce::Time::getHighResolutionTicks() - start;
+
+    const int skip = voiceStarts[(size_t)slot];
+    if (skip >= end)
+        return 0.0f;
+
+    auto range = juce::FloatVectorOperations::findMinAndMax(out.left + skip, end - skip);
+    if (out.right != nullptr)
+        range = range.getUnionWith(juce::FloatVectorOperations::findMinAndMax(out.right + skip, end - skip));
+    return juce::jmax(-range.getStart(), range.getEnd());
+}
+
+// Plays from the voice's disk stream ring. If the I/O thread hasn't got
+// there yet the rest of the block is silent, the play head keeps moving and
+// the shortfall is counted against the stream.
+int H9PadSampler::renderStream(Voice& v, const H9PadSample& sample, Bus out,
+                               int pos, int end, float& peak, Scratch& tmp) noexcept
+{
+    const int stream = indexOf(v);
+    const int length = sample.getLength();
+    const int idx    = (int)v.position;
+
+    // The window starts a kernel's width behind the play head
+    const int from = juce::jmax(0, idx - maxFramesBefore);
+    const int got  = v.streaming
+        ? diskStreams.read(stream, from, juce::jmin(decodeFrames, length - from),
+                           tmp.decodeL.data(), tmp.decodeR.data())
+        : 0;
+
+    // Enough for at least one output sample with any kernel
+    const int needed = juce::jmin(idx + maxFramesAfter + 1, length) - from;
+
+    if (got < needed)
+    {
+        const int missing = end - pos;
+        diskStreams.reportUnderrun(stream, missing);
+
+        v.position += v.increment * (double)missing;
+        if ((int)v.position >= length)
+            v.active = false;
+        else
+            diskStreams.consumed(stream, juce::jmax(0, (int)v.position - maxFramesBefore));
+        return end;
+    }
+
+    const float* srcR = sample.store.getNumChannels() > 1 ? tmp.decodeR.data() : tmp.decodeL.data();
+    pos = renderWindow(v, { tmp.decodeL.data(), srcR, from, from + got, length },
+                       out, pos, end, peak, tmp);
+
+    diskStreams.consumed(stream, juce::jmax(0, (int)v.position - maxFramesBefore));
+    return pos;
+}
+
+// Renders output samples [pos, end) from a window of source frames
+// [base, windowEnd) with the kernel specialised for this voice and bus.
+// Returns where it stopped: `end`, the voice running out, or the window
+// needing a refill.
+int H9PadSampler::renderWindow(Voice& v, const SourceWindow& src, Bus out,
+                               int pos, int end, float& peak, Scratch& tmp) noexcept
+{
+    using namespace H9VoiceKernels;
+
+    const auto interp       = v.increment == 1.0 ? Interp::none : interpolation;
+    const bool stereoSource = src.left != src.right;
+    const bool stereoOut    = out.right != nullptr;
+
+    // Choked / stolen voices ramp down linearly (the caller stops at the end
+    // of the fade); everything else plays at a constant gain
+    const bool fading = v.releaseDelay == 0 && v.releaseLeft >= 0;
+    const auto kernel = get(interp, stereoSource, stereoOut, fading);
+
+    int base = src.base;
+
+    Args a;
+    a.left      = src.left;
+    a.right     = src.right;
+    a.position  = v.position - (double)base;
+    a.increment = v.increment;
+    a.gainStep  = fading ? v.gain * releaseStep : 0.0f;
+    a.gain      = fading ? a.gainStep * (float)v.releaseLeft : v.gain;
+    a.outL      = out.left + pos;
+    a.outR      = stereoOut ? out.right + pos : nullptr;
+    a.sinc      = interp == Interp::sinc ? getSincTable(getSincBand(v.increment)) : nullptr;
+
+    int n = getSafeLength(interp, a.position, a.increment, src.windowEnd - base - 1, end - pos);
+
+    if (n == 0)
+    {
+        // The kernel would read before the first frame or past the last:
+        // run it over a copy of the frames around the play head, zero outside
+        // the sample
+        const int idx   = (int)v.position;
+        const int first = idx - getFramesBefore(interp);
+        const bool atStart = first < 0;
+        const bool atEnd   = src.windowEnd == src.length && idx + getFramesAfter(interp) >= src.length;
+        if (!atStart && !atEnd)
+            return pos;   // window needs a refill
+
+        int last = edgeFrames - 1;
+        for (int i = 0; i < edgeFrames; ++i)
+        {
+            const int f = first + i;
+            if (f >= src.windowEnd && f < src.length)
+            {
+                last = i - 1;   // the rest is in the next window
+                break;
+            }
+
+            const bool inside = f >= base && f < src.windowEnd;
+            tmp.edgeL[(size_t)i] = inside ? src.left[f - base]  : 0.0f;
+            tmp.edgeR[(size_t)i] = inside ? src.right[f - base] : 0.0f;
+        }
+
+        base       = first;
+        a.left     = tmp.edgeL.data();
+        a.right    = stereoSource ? tmp.edgeR.data() : tmp.edgeL.data();
+        a.position = v.position - (double)base;
+        n = getSafeLength(interp, a.position, a.increment, last, end - pos);
+    }
+
+    const auto r = kernel(a, n);
+    pos += n;
+    peak = juce::jmax(peak, r.peak);
+
+    v.position = (double)base + r.position;
+    if ((int)v.position >= src.length)
+        v.active = false;
+    return pos;
+}
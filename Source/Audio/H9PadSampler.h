@@ -0,0 +1,252 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "Core/H9ObjectHandoff.h"
+#include "Core/H9RealtimeWorkers.h"
+#include "Audio/H9SampleStore.h"
+#include "Audio/H9DiskStreamer.h"
+#include "Audio/H9VoiceKernels.h"
+#include "Audio/H9VoiceDsp.h"
+#include "Audio/H9GranularEngine.h"
+
+// ── Sample data ─────────────────────────────────────────────────────────────
+
+struct H9PadSample
+{
+    juce::AudioBuffer<float> audio;       // float staging while loading; released
+                                          // once `store` is built
+    H9SampleStore store;                  // what voices play from — the whole
+                                          // sample, or just its head when streamed
+    std::unique_ptr<H9StreamSource> stream;   // the rest, for streaming kits
+    double       sampleRate { 44100.0 };
+    float        gain       { 1.0f };
+    int          chokeGroup { 0 };        // see H9PadInfo::chokeGroup
+    float        tune       { 0.0f };     // semitones
+    float        velocityToPitch { 0.0f };   // semitones at full velocity
+    juce::String path;
+
+    bool isValid() const   { return store.getNumFrames() > 0; }
+    int  getLength() const { return stream != nullptr ? stream->frames : store.getNumFrames(); }
+};
+
+struct H9SampleSet
+{
+    static constexpr int numPads = 8;
+    std::array<H9PadSample, numPads> pads;
+};
+
+// ── H9PadSampler ────────────────────────────────────────────────────────────
+// One-shot 8-pad sampler. Sample sets are built off the audio thread and
+// handed over through H9ObjectHandoff; everything called from processBlock
+// is allocation- and lock-free. Pads of streaming kits play their resident
+// head and then the ring buffer of the voice's H9DiskStreams slot.
+//
+// Voices live in fixed slots threaded onto intrusive lists, so a hit never
+// scans the pool:
+//   playing     sounding voices, oldest first (at most maxVoices)
+//   byPad[p]    playing voices of pad p, oldest first
+//   releasing   choked / stolen voices ramping out, oldest (quietest) first
+//   free        stack of idle slots
+// A hit first releases every voice of the other pads in its choke group.
+// With the pool full it then steals this pad's oldest voice, else the
+// oldest overall; stolen voices fade over a few ms instead of clicking. If
+// no slot is free the oldest release is cut — it is nearly silent by then.
+//
+// Voices at the host rate with no pitch offset copy samples straight
+// through; anything else uses the interpolation set by setInterpolation().
+// Near either end of a sample the kernel runs over a small zero-padded copy
+// of the frames around the play head, so every tier reads whole taps.
+//
+// Each voice renders into its own slot of a voice bus. Voices of pads with a
+// tone set (setPadTone) then go through H9VoiceDsp — amp envelope and SVF,
+// four voices per SIMD register — and the bus is summed into the output in
+// list order. A voice whose envelope has decayed to silence is freed.
+// Given an H9RealtimeWorkers pool, render() spreads the voices across its
+// threads (each with its own decode scratch); the mix is bit-identical to
+// the single-threaded one.
+//
+// Voices of texture pads (setPadTexture) play as grain clouds through
+// H9GranularEngine instead, with the same choke, stealing, tone and
+// threading. Grains read the sample in place, so that takes a resident
+// float32 store; texture pads of packed or streamed kits play as ordinary
+// one-shots.
+
+class H9PadSampler
+{
+public:
+    static constexpr int numPads      = H9SampleSet::numPads;
+    static constexpr int maxVoices    = 8;   // sounding at once
+    static constexpr int maxReleasing = 4;   // extra slots for fade-outs
+    static constexpr int numSlots     = maxVoices + maxReleasing;
+
+    static constexpr double releaseSeconds = 0.003;
+
+    // Below these, render() stays on the calling thread — waking workers
+    // costs more than it saves
+    static constexpr int minParallelVoices  = 3;
+    static constexpr int minParallelSamples = 32;
+
+    H9PadSampler();
+
+    void prepare(double sampleRate, int maxBlockSize);
+
+    // ── Message thread ──────────────────────────────────────────────────────
+    // Sets are deleted under the disk streams' source lock, so the I/O
+    // thread never reads a stream source that is going away
+    void setSampleSet(std::unique_ptr<H9SampleSet> set);
+    void collectGarbage();
+
+    // ── Audio thread ────────────────────────────────────────────────────────
+    void beginBlock() noexcept;
+
+    // Starts `pad` `sampleOffset` samples into the next render() call,
+    // transposed by `semitones` on top of the pad's own tuning.
+    // Returns false when the pad has no sample loaded.
+    bool startVoice(int pad, float velocity, int sampleOffset, float semitones = 0.0f) noexcept;
+
+    // Interpolation for resampled / pitched voices; takes effect on the next
+    // window each voice renders
+    void setInterpolation(H9VoiceKernels::Interp i) noexcept { interpolation = i; }
+    H9VoiceKernels::Interp getInterpolation() const noexcept { return interpolation; }
+
+    // Sounding voices allowed (1 … maxVoices). Lowering it releases the
+    // oldest voices beyond the new limit.
+    void setVoiceLimit(int limit) noexcept;
+    int  getVoiceLimit() const noexcept { return voiceLimit; }
+
+    // Amp envelope and filter for every voice of `pad`, sounding ones
+    // included. Call once per block with the current parameter values.
+    void setPadTone(int pad, const H9VoiceDsp::Tone& tone) noexcept { voiceDsp.setTone(pad, tone); }
+
+    // Texture pads and their grain settings; hits after the call use them,
+    // and settings reach sounding clouds' new grains. Once per block.
+    void setPadTexture(int pad, bool isTexture) noexcept { texturePads[(size_t)pad] = isTexture; }
+    void setTextureSettings(const H9GranularEngine::Settings& s) noexcept { granular.setSettings(s); }
+
+    // Adds voices into `out` (stereo or mono) and records per-pad peaks.
+    // `workers`, if given, renders voices in parallel.
+    void render(juce::AudioBuffer<float>& out, int startSample, int numSamples,
+                H9RealtimeWorkers* workers = nullptr) noexcept;
+
+    void allNotesOff() noexcept;
+
+    float getPadPeak(int pad) const noexcept { return padPeaks[(size_t)pad]; }
+    int   getNumActiveVoices() const noexcept { return playing.size + releasing.size; }
+
+    // CPU ticks spent rendering grains since the last call, summed over
+    // the threads that rendered them
+    juce::int64 takeTextureTicks() noexcept;
+
+    // Any thread
+    H9DiskStreams::Stats getStreamStats() const noexcept { return diskStreams.getStats(); }
+
+    struct GrainStats
+    {
+        int active { 0 };              // sounding after the last block
+        int peak   { 0 };              // most at once since prepare()
+        juce::uint64 dropped { 0 };    // turned away by full grain pools
+    };
+
+    GrainStats getGrainStats() const noexcept;
+
+private:
+    enum class VoiceState : juce::uint8 { idle, playing, releasing };
+
+    struct Links { int prev { -1 }, next { -1 }; };
+    struct List  { int head { -1 }, tail { -1 }, size { 0 }; };
+
+    struct Voice
+    {
+        VoiceState state  { VoiceState::idle };
+        bool   active     { false };  // cleared by the renderers when done
+        int    pad        { -1 };
+        double position   { 0.0 };
+        double increment  { 1.0 };
+        float  gain       { 0.0f };
+        int    startDelay { 0 };      // samples of silence before the hit
+        int    releaseDelay { 0 };    // samples before the fade starts
+        int    releaseLeft  { -1 };   // samples of fade left; -1 = not releasing
+        bool   streaming  { false };  // has a disk stream running
+        bool   texture    { false };  // renders through `granular`
+        Links  order;                 // in `playing` or `releasing`
+        Links  padOrder;              // in byPad[pad] while playing
+    };
+
+    H9ObjectHandoff<H9SampleSet> sampleSets;
+    H9DiskStreams diskStreams { numSlots };   // stream i belongs to voices[i]
+
+    std::array<Voice, numSlots>   voices {};
+    List playing, releasing;
+    std::array<List, numPads>     byPad {};
+    std::array<int, numSlots>     freeSlots {};
+    int numFree { 0 };
+
+    std::array<float, numPads>    padPeaks {};
+    double hostSampleRate { 44100.0 };
+    int    releaseSamples { 128 };
+    float  releaseStep    { 1.0f / 128.0f };
+    H9VoiceKernels::Interp interpolation { H9VoiceKernels::Interp::linear };
+    int    voiceLimit     { maxVoices };
+
+    static constexpr int decodeFrames = 2 * H9SampleStore::blockFrames;
+    static constexpr int edgeFrames   = 32;
+
+    // Per rendering thread
+    struct Scratch
+    {
+        // Decode window for packed / compressed stores and disk streams
+        std::array<float, decodeFrames> decodeL {}, decodeR {};
+
+        // Zero-padded frames around the play head at the start / end of a sample
+        std::array<float, edgeFrames> edgeL {}, edgeR {};
+    };
+
+    std::vector<Scratch> scratch;
+
+    // Two channels per voice slot; sized by prepare()
+    juce::AudioBuffer<float> voiceBus;
+    std::array<int, numSlots>   jobs {};
+    std::array<float, numSlots> voicePeaks {};
+    std::array<int, numSlots>   voiceStarts {};   // first bus sample of each voice this chunk
+
+    H9VoiceDsp voiceDsp;   // state indexed by voice slot
+    std::array<int, numSlots> shaped {};
+    static_assert(numSlots <= H9VoiceDsp::maxVoices, "H9VoiceDsp holds a state per voice slot");
+
+    H9GranularEngine granular;   // grain pool partition per voice slot
+    std::array<bool, numPads>          texturePads {};
+    std::array<juce::int64, numSlots>  textureTicks {};   // written by whichever thread renders the slot
+    static_assert(numSlots <= H9GranularEngine::maxVoices, "H9GranularEngine holds a state per voice slot");
+
+    std::atomic<int> activeGrains { 0 }, peakGrains { 0 };
+    std::atomic<juce::uint64> droppedGrains { 0 };
+
+    struct Bus
+    {
+        float* left;
+        float* right;    // nullptr on mono buses
+    };
+
+    struct SourceWindow
+    {
+        const float* left;
+        const float* right;
+        int base;        // frame index of left[0]
+        int windowEnd;   // one past the last frame available
+        int length;      // frames in the whole sample
+    };
+
+    int  indexOf(const Voice& v) const noexcept { return (int)(&v - voices.data()); }
+    void pushBack(List&, Links Voice::*, int slot) noexcept;
+    void unlink(List&, Links Voice::*, int slot) noexcept;
+
+    void releaseVoice(Voice&, int sampleOffset) noexcept;
+    void stopVoice(Voice&) noexcept;
+    void advanceRelease(Voice&, int numRendered) noexcept;
+
+    void renderChunk(const H9SampleSet&, juce::AudioBuffer<float>& out, int startSample,
+                     int numSamples, H9RealtimeWorkers*) noexcept;
+    float renderVoice(Voice&, const H9PadSample&, Bus out, int numSamples, Scratch&) noexcept;
+    float renderTexture(Voice&, const H9PadSample&, Bus out, int pos, int end) noexcept;
+    int renderStream(Voice&, const H9PadSample&, Bus out, int pos, int end, float& peak, Scratch&) noexcept;
+    int renderWindow(Voice&, const SourceWindow&, Bus out, int pos, int end, float& peak, Scratch&) noexcept;
+};
@@ -0,0 +1,261 @@
+#include "H9PartitionedConvolver.h"
+#include "Audio/H9Simd.h"
+
+namespace
+{
+    using namespace H9Simd;
+
+    // acc += x · h over `n` split-complex values (n a multiple of lanes)
+    void complexMac(float* accRe, float* accIm, const float* xRe, const float* xIm,
+                    const float* hRe, const float* hIm, int n) noexcept
+    {
+        for (int i = 0; i < n; i += lanes)
+        {
+            const Vec xr = vload(xRe + i), xi = vload(xIm + i);
+            const Vec hr = vload(hRe + i), hi = vload(hIm + i);
+            vstore(accRe + i, vadd(vload(accRe + i), vsub(vmul(xr, hr), vmul(xi, hi))));
+            vstore(accIm + i, vadd(vload(accIm + i), vadd(vmul(xr, hi), vmul(xi, hr))));
+        }
+    }
+
+    // JUCE's real-only transforms work on interleaved complex values
+    void deinterleave(const float* data, float* re, float* im, int bins) noexcept
+    {
+        for (int b = 0; b < bins; ++b)
+        {
+            re[b] = data[2 * b];
+            im[b] = data[2 * b + 1];
+        }
+    }
+
+    int orderOf(int size) noexcept
+    {
+        int order = 0;
+        while ((1 << order) < size)
+            ++order;
+        return order;
+    }
+}
+
+H9PartitionedConvolver::H9PartitionedConvolver(const juce::AudioBuffer<float>& ir)
+{
+    irChannels = juce::jlimit(1, maxChannels, ir.getNumChannels());
+    length     = ir.getNumSamples();
+
+    for (int c = 0; c < irChannels; ++c)
+        for (int j = 0; j < juce::jmin(headLength, length); ++j)
+            headTaps[c][headLength - 1 - j] = ir.getSample(c, j);
+
+    int start = headLength;
+    for (int s = 0; s < numSizes && start < length; ++s)
+    {
+        // Each size runs up to where the next one can start without latency
+        const int size = partitionSizes[s];
+        const int end  = s + 1 < numSizes ? juce::jmin(length, partitionSizes[s + 1]) : length;
+        jassert(start == size);
+
+        Segment seg;
+        seg.size   = size;
+        seg.parts  = (end - start + size - 1) / size;
+        seg.bins   = size + 1;
+        seg.stride = (seg.bins + lanes - 1) / lanes * lanes;
+        seg.fft    = std::make_unique<juce::dsp::FFT>(orderOf(2 * size));
+        seg.fftData.assign((size_t)(4 * size), 0.0f);
+
+        for (int c = 0; c < irChannels; ++c)
+        {
+            seg.irRe[c].assign((size_t)(seg.parts * seg.stride), 0.0f);
+            seg.irIm[c].assign((size_t)(seg.parts * seg.stride), 0.0f);
+
+            for (int k = 0; k < seg.parts; ++k)
+            {
+                std::fill(seg.fftData.begin(), seg.fftData.end(), 0.0f);
+                const int from = start + k * size;
+                const int n    = juce::jmin(size, length - from);
+                std::copy_n(ir.getReadPointer(c, from), n, seg.fftData.data());
+
+                seg.fft->performRealOnlyForwardTransform(seg.fftData.data(), true);
+                deinterleave(seg.fftData.data(), seg.irRe[c].data() + k * seg.stride,
+                             seg.irIm[c].data() + k * seg.stride, seg.bins);
+            }
+        }
+
+        for (auto& st : seg.state)
+        {
+            st.input.assign((size_t)(2 * size), 0.0f);
+            st.output.assign((size_t)size, 0.0f);
+            st.xRe.assign((size_t)(seg.parts * seg.stride), 0.0f);
+            st.xIm.assign((size_t)(seg.parts * seg.stride), 0.0f);
+            st.accRe.assign((size_t)seg.stride, 0.0f);
+            st.accIm.assign((size_t)seg.stride, 0.0f);
+        }
+
+        numPartitions += seg.parts;
+        start += seg.parts * size;
+        segments.push_back(std::move(seg));
+    }
+}
+
+H9PartitionedConvolver::~H9PartitionedConvolver() = default;
+
+void H9PartitionedConvolver::reset() noexcept
+{
+    for (auto& h : headHistory)
+        std::fill(std::begin(h), std::end(h), 0.0f);
+    headPos = 0;
+
+    for (auto& seg : segments)
+    {
+        for (auto& st : seg.state)
+        {
+            for (auto* v : { &st.input, &st.output, &st.xRe, &st.xIm, &st.accRe, &st.accIm })
+                std::fill(v->begin(), v->end(), 0.0f);
+            st.ring    = 0;
+            st.macDone = 0;
+        }
+        seg.fill = 0;
+    }
+}
+
+void H9PartitionedConvolver::process(const float* inL, const float* inR, float* outL, float* outR,
+                                     int numSamples) noexcept
+{
+    const float* in[maxChannels] = { inL, inR };
+    float* out[maxChannels]      = { outL, outR };
+    const int numChannels = inR != nullptr && outR != nullptr ? 2 : 1;
+
+    processHead(in, out, numChannels, numSamples);
+
+    for (auto& seg : segments)
+        processSegment(seg, in, out, numChannels, numSamples);
+}
+
+// ── Head: direct form, no latency ───────────────────────────────────────────
+
+void H9PartitionedConvolver::processHead(const float* const* in, float* const* out, int numChannels,
+                                         int numSamples) noexcept
+{
+    int pos = headPos;
+
+    for (int c = 0; c < numChannels; ++c)
+    {
+        const float* taps = headTaps[juce::jmin(c, irChannels - 1)];
+        float* history    = headHistory[c];
+        pos = headPos;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            history[pos] = history[pos + headLength] = in[c][i];
+
+            // Oldest → newest, against the taps reversed
+            const float* window = history + pos + 1;
+            Vec acc0 = vset(0.0f), acc1 = vset(0.0f);
+            for (int j = 0; j < headLength; j += 2 * lanes)
+            {
+                acc0 = vadd(acc0, vmul(vload(window + j),         vload(taps + j)));
+                acc1 = vadd(acc1, vmul(vload(window + j + lanes), vload(taps + j + lanes)));
+            }
+
+            alignas(16) float sum[lanes];
+            vstore(sum, vadd(acc0, acc1));
+            out[c][i] = (sum[0] + sum[1]) + (sum[2] + sum[3]);
+
+            pos = (pos + 1) & (headLength - 1);
+        }
+    }
+
+    headPos = pos;
+}
+
+// ── FFT segments ────────────────────────────────────────────────────────────
+
+void H9PartitionedConvolver::processSegment(Segment& seg, const float* const* in, float* const* out,
+                                            int numChannels, int numSamples) noexcept
+{
+    const int size = seg.size;
+
+    for (int pos = 0; pos < numSamples;)
+    {
+        const int n = juce::jmin(numSamples - pos, size - seg.fill);
+
+        for (int c = 0; c < numChannels; ++c)
+        {
+            auto& st = seg.state[c];
+            std::copy_n(in[c] + pos, n, st.input.data() + size + seg.fill);
+            juce::FloatVectorOperations::add(out[c] + pos, st.output.data() + seg.fill, n);
+        }
+
+        seg.fill += n;
+        pos += n;
+
+        // Partitions 1 … parts-1 only need spectra already in the delay
+        // line; sum them in step with the block filling up
+        const int target = (int)((juce::int64)(seg.parts - 1) * seg.fill / size);
+        for (int c = 0; c < numChannels; ++c)
+        {
+            auto& st = seg.state[c];
+            const int irc = juce::jmin(c, irChannels - 1);
+
+            for (; st.macDone < target; ++st.macDone)
+            {
+                const int k    = st.macDone + 1;
+                const int slot = (st.ring - k + seg.parts) % seg.parts;
+                complexMac(st.accRe.data(), st.accIm.data(),
+                           st.xRe.data() + slot * seg.stride, st.xIm.data() + slot * seg.stride,
+                           seg.irRe[irc].data() + k * seg.stride, seg.irIm[irc].data() + k * seg.stride,
+                           seg.stride);
+            }
+        }
+
+        if (seg.fill == size)
+        {
+            for (int c = 0; c < numChannels; ++c)
+                finishBlock(seg, c);
+            seg.fill = 0;
+        }
+    }
+}
+
+// A full block is in: transform it, add partition 0's product and turn the
+// sum back into the next period's output
+void H9PartitionedConvolver::finishBlock(Segment& seg, int c) noexcept
+{
+    auto& st = seg.state[c];
+    const int size = seg.size;
+    const int irc  = juce::jmin(c, irChannels - 1);
+    float* data    = seg.fftData.data();
+
+    std::copy_n(st.input.data(), 2 * size, data);
+    std::fill(data + 2 * size, data + 4 * size, 0.0f);
+    seg.fft->performRealOnlyForwardTransform(data, true);
+
+    float* xRe = st.xRe.data() + st.ring * seg.stride;
+    float* xIm = st.xIm.data() + st.ring * seg.stride;
+    deinterleave(data, xRe, xIm, seg.bins);
+
+    complexMac(st.accRe.data(), st.accIm.data(), xRe, xIm, seg.irRe[irc].data(), seg.irIm[irc].data(), seg.stride);
+
+    // Back to interleaved, with the negative frequencies mirrored so the
+    // inverse is real whichever FFT engine JUCE picked
+    const int fftSize = 2 * size;
+    for (int b = 0; b < seg.bins; ++b)
+    {
+        data[2 * b]     = st.accRe[(size_t)b];
+        data[2 * b + 1] = st.accIm[(size_t)b];
+    }
+    for (int b = 1; b < size; ++b)
+    {
+        data[2 * (fftSize - b)]     =  st.accRe[(size_t)b];
+        data[2 * (fftSize - b) + 1] = -st.accIm[(size_t)b];
+    }
+    seg.fft->performRealOnlyInverseTransform(data);
+
+    // Overlap-save: the second half is the valid part
+    std::copy_n(data + size, size, st.output.data());
+    std::copy_n(st.input.data() + size, size, st.input.data());
+
+    std::fill(st.accRe.begin(), st.accRe.end(), 0.0f);
+    std::fill(st.accIm.begin(), st.accIm.end(), 0.0f);
+    st.ring    = (st.ring + 1) % seg.parts;
+    st.macDone = 0;
+}
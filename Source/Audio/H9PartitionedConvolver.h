@@ -0,0 +1,100 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+
+// ── H9PartitionedConvolver ──────────────────────────────────────────────────
+// Zero-latency convolution with a fixed impulse response, non-uniformly
+// partitioned:
+//   head        the first 64 taps, direct form (SIMD dot product per sample)
+//   64 × 7      uniform FFT partitions covering taps 64 … 511
+//   512 × 7     taps 512 … 4095
+//   4096 × n    the rest of the response
+// A segment of partition size P starts P taps into the response, so the P
+// samples it needs to gather a block are exactly covered by the segments in
+// front of it and nothing is delayed. Each segment keeps a frequency-domain
+// delay line of its past input spectra (overlap-save, FFT size 2P). Only
+// the newest partition's product has to wait for a full block; the rest of
+// the sum is accumulated a little at a time while the next block fills, so
+// a 4096-sample segment costs two FFTs and one spectral multiply at its
+// boundary rather than one per partition.
+//
+// Built off the audio thread (everything is allocated in the constructor);
+// process() and reset() are real-time safe. Mono responses feed both sides;
+// stereo ones convolve left with left and right with right.
+
+class H9PartitionedConvolver
+{
+public:
+    static constexpr int headLength = 64;
+    static constexpr int numSizes   = 3;
+    static constexpr int partitionSizes[numSizes] = { 64, 512, 4096 };
+    static constexpr int maxChannels = 2;
+
+    // `ir`: 1 or 2 channels at the rate it will run at
+    explicit H9PartitionedConvolver(const juce::AudioBuffer<float>& ir);
+    ~H9PartitionedConvolver();
+
+    // ── Audio thread ────────────────────────────────────────────────────────
+
+    void reset() noexcept;
+
+    // Writes the convolution of each input channel to the matching output.
+    // inR / outR may be nullptr for a mono bus. Inputs and outputs must not
+    // overlap.
+    void process(const float* inL, const float* inR, float* outL, float* outR, int numSamples) noexcept;
+
+    // ── Any thread ──────────────────────────────────────────────────────────
+
+    int getLength() const noexcept        { return length; }
+    int getNumPartitions() const noexcept { return numPartitions; }
+    int getNumSegments() const noexcept   { return (int)segments.size(); }
+
+    // Samples of silent input after which every internal buffer is zero
+    int getTailSamples() const noexcept   { return length + 2 * partitionSizes[numSizes - 1]; }
+
+private:
+    struct Segment
+    {
+        int size     { 0 };   // P
+        int parts    { 0 };
+        int bins     { 0 };   // P + 1 complex values
+        int stride   { 0 };   // bins rounded up to whole SIMD registers
+        std::unique_ptr<juce::dsp::FFT> fft;   // order log2(2P)
+        std::vector<float> fftData;            // 2 × FFT size, shared by the channels
+
+        // Response spectra per IR channel, split real / imaginary, parts × stride
+        std::vector<float> irRe[maxChannels], irIm[maxChannels];
+
+        // Per input channel
+        struct State
+        {
+            std::vector<float> input;    // last 2P samples
+            std::vector<float> output;   // P samples to play this period
+            std::vector<float> xRe, xIm; // past input spectra, parts × stride
+            std::vector<float> accRe, accIm;
+            int ring    { 0 };           // slot the next spectrum goes into
+            int macDone { 0 };           // partitions 1 … macDone summed into acc
+        };
+        State state[maxChannels];
+        int fill { 0 };                  // samples gathered this period (both channels)
+    };
+
+    int length        { 0 };
+    int numPartitions { 0 };
+    int irChannels    { 1 };
+
+    // Head taps per IR channel, reversed, and per input channel a doubled
+    // ring of the last headLength inputs so the window is always contiguous
+    alignas(16) float headTaps[maxChannels][headLength] {};
+    alignas(16) float headHistory[maxChannels][2 * headLength] {};
+    int headPos { 0 };
+
+    std::vector<Segment> segments;
+
+    void processHead(const float* const* in, float* const* out, int numChannels, int numSamples) noexcept;
+    void processSegment(Segment&, const float* const* in, float* const* out, int numChannels,
+                        int numSamples) noexcept;
+    void finishBlock(Segment&, int channel) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE(H9PartitionedConvolver)
+};
@@ -0,0 +1,156 @@
+#include "H9ResampleCache.h"
+
+namespace
+{
+    constexpr int magic     = 0x53523948;   // "H9RS"
+    constexpr int version   = 1;
+    constexpr int hashBytes = 16;
+}
+
+juce::File H9ResampleCache::getDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+               .getChildFile("HALO9/Cache/Resampled");
+}
+
+juce::File H9ResampleCache::entryFor(const juce::File& source, double targetRate)
+{
+    const auto identity = source.getFullPathName()
+                        + "|" + juce::String(source.getSize())
+                        + "|" + juce::String(source.getLastModificationTime().toMilliseconds());
+
+    return getDirectory().getChildFile(
+        juce::String::toHexString(identity.hashCode64())
+        + "-" + juce::String(juce::roundToInt(targetRate)) + ".h9rs");
+}
+
+bool H9ResampleCache::load(const juce::File& source, double targetRate,
+                           H9PadSample& pad, H9SampleRef& ref)
+{
+    return read(source, targetRate, -1, pad, ref, nullptr);
+}
+
+bool H9ResampleCache::loadHead(const juce::File& source, double targetRate, int headFrames,
+                               H9PadSample& pad, H9SampleRef& ref, H9StreamSource& stream)
+{
+    return read(source, targetRate, juce::jmax(1, headFrames), pad, ref, &stream);
+}
+
+bool H9ResampleCache::read(const juce::File& source, double targetRate, int maxFrames,
+                           H9PadSample& pad, H9SampleRef& ref, H9StreamSource* stream)
+{
+    const auto entry = entryFor(source, targetRate);
+    auto in = std::make_unique<juce::FileInputStream>(entry);
+    if (!in->openedOk())
+        return false;
+
+    if (in->readInt() != magic || in->readShort() != version)
+        return false;
+
+    const int    channels = in->readInt();
+    const int    frames   = in->readInt();
+    const double rate     = in->readDouble();
+
+    if (channels < 1 || channels > 2 || frames <= 0 || std::abs(rate - targetRate) > 0.5)
+        return false;
+
+    juce::uint8 hash[hashBytes];
+    if (in->read(hash, hashBytes) != hashBytes)
+        return false;
+    const auto sourceSize = in->readInt64();
+
+    const auto dataOffset      = in->getPosition();
+    const auto bytesPerChannel = (juce::int64)frames * (juce::int64)sizeof(float);
+    if (in->getNumBytesRemaining() < bytesPerChannel * channels)
+        return false;   // truncated
+
+    const int resident = maxFrames < 0 ? frames : juce::jmin(frames, maxFrames);
+
+    pad.audio.setSize(channels, resident);
+    for (int ch = 0; ch < channels; ++ch)
+    {
+        if (!in->setPosition(dataOffset + ch * bytesPerChannel))
+            return false;
+        in->read(pad.audio.getWritePointer(ch), resident * (int)sizeof(float));
+    }
+
+    pad.sampleRate = rate;
+    pad.path       = source.getFullPathName();
+
+    ref.path = pad.path;
+    ref.hash = juce::String::toHexString(hash, hashBytes, 0);
+    ref.size = sourceSize;
+
+    entry.setLastModificationTime(juce::Time::getCurrentTime());   // LRU for prune()
+
+    if (stream != nullptr)
+    {
+        stream->file       = entry;
+        stream->dataOffset = dataOffset;
+        stream->frames     = frames;
+        stream->channels   = channels;
+        stream->input      = std::move(in);
+    }
+    return true;
+}
+
+bool H9ResampleCache::store(const juce::File& source, double targetRate,
+                            const H9PadSample& pad, const H9SampleRef& ref)
+{
+    const auto entry = entryFor(source, targetRate);
+    if (!entry.getParentDirectory().createDirectory())
+        return false;
+
+    juce::TemporaryFile temp(entry);
+    {
+        juce::FileOutputStream out(temp.getFile());
+        if (!out.openedOk())
+            return false;
+
+        juce::MemoryBlock hash;
+        hash.loadFromHexString(ref.hash);
+        hash.setSize(hashBytes, true);
+
+        out.writeInt(magic);
+        out.writeShort((short)version);
+        out.writeInt(pad.audio.getNumChannels());
+        out.writeInt(pad.audio.getNumSamples());
+        out.writeDouble(pad.sampleRate);
+        out.write(hash.getData(), hashBytes);
+        out.writeInt64(ref.size);
+
+        for (int ch = 0; ch < pad.audio.getNumChannels(); ++ch)
+            out.write(pad.audio.getReadPointer(ch),
+                      (size_t)pad.audio.getNumSamples() * sizeof(float));
+
+        out.flush();
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+void H9ResampleCache::prune(juce::int64 budgetBytes)
+{
+    auto entries = getDirectory().findChildFiles(juce::File::findFiles, false, "*.h9rs");
+
+    juce::int64 total = 0;
+    for (auto& f : entries)
+        total += f.getSize();
+
+    if (total <= budgetBytes)
+        return;
+
+    std::sort(entries.begin(), entries.end(), [](const juce::File& a, const juce::File& b)
+    {
+        return a.getLastModificationTime() < b.getLastModificationTime();
+    });
+
+    for (auto& f : entries)
+    {
+        if (total <= budgetBytes) break;
+        total -= f.getSize();
+        f.deleteFile();
+    }
+}
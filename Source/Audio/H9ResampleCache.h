@@ -0,0 +1,48 @@
+#pragma once
+#include "Audio/H9PadSampler.h"
+#include "Data/H9PluginState.h"
+
+// ── H9ResampleCache ─────────────────────────────────────────────────────────
+// Persistent on-disk cache of samples already converted to a host rate, so
+// a session reopened at the same rate skips both decoding and SRC. Entries
+// are keyed by (file identity, target rate) — identity being path, size
+// and modification time, so an edited file misses — and carry the source's
+// content hash so a hit never has to read the original file.
+//
+//   <app data>/HALO9/Cache/Resampled/<identity>-<rate>.h9rs
+//
+//   u32 'H9RS'  u16 version  i32 channels  i32 frames  f64 rate
+//   u8[16] source md5  i64 source size  f32 frames × channels (planar, LE)
+//
+// Safe to share between instances and processes: entries are written to a
+// temporary file and moved into place.
+
+class H9ResampleCache
+{
+public:
+    static constexpr juce::int64 defaultBudgetBytes = (juce::int64)1 << 30;   // 1 GB
+
+    static juce::File getDirectory();
+
+    // Fills `pad` (audio + rate) and `ref` (path, hash, size) on a hit
+    static bool load(const juce::File& source, double targetRate,
+                     H9PadSample& pad, H9SampleRef& ref);
+
+    // Streaming kits: reads only the first `headFrames` frames into `pad`
+    // and points `stream` at the whole sample inside the entry
+    static bool loadHead(const juce::File& source, double targetRate, int headFrames,
+                         H9PadSample& pad, H9SampleRef& ref, H9StreamSource& stream);
+
+    static bool store(const juce::File& source, double targetRate,
+                      const H9PadSample& pad, const H9SampleRef& ref);
+
+    // Deletes least-recently-used entries until the cache fits the budget
+    static void prune(juce::int64 budgetBytes = defaultBudgetBytes);
+
+private:
+    static juce::File entryFor(const juce::File& source, double targetRate);
+
+    // maxFrames < 0 reads everything; `stream` may be null
+    static bool read(const juce::File& source, double targetRate, int maxFrames,
+                     H9PadSample& pad, H9SampleRef& ref, H9StreamSource* stream);
+};
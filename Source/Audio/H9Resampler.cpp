@@ -0,0 +1,89 @@
+#include "H9Resampler.h"
+#include <cmath>
+
+namespace
+{
+    // Zeroth-order modified Bessel function of the first kind
+    double besselI0(double x)
+    {
+        double sum = 1.0, term = 1.0;
+        const double q = x * x * 0.25;
+        for (int k = 1; k < 64; ++k)
+        {
+            term *= q / ((double)k * (double)k);
+            sum += term;
+            if (term < sum * 1.0e-12) break;
+        }
+        return sum;
+    }
+}
+
+juce::AudioBuffer<float> H9Resampler::process(const juce::AudioBuffer<float>& source,
+                                              double sourceRate, double targetRate)
+{
+    const int numChannels = source.getNumChannels();
+    const int inLength    = source.getNumSamples();
+
+    if (!needsConversion(sourceRate, targetRate) || inLength == 0)
+        return source;
+
+    const double ratio  = targetRate / sourceRate;
+    const double cutoff = juce::jmin(1.0, ratio) * passband;   // of source Nyquist
+
+    // Kernel half-width in source samples — widens when converting down
+    const double halfWidth = (double)zeroCrossings / cutoff;
+    const double tableStep = cutoff / (double)phasesPerZero;   // table x spacing
+    const int    tableSize = (int)std::ceil(halfWidth / tableStep) + 2;
+
+    std::vector<float> kernel((size_t)tableSize);
+    const double i0Beta = besselI0(kaiserBeta);
+    for (int i = 0; i < tableSize; ++i)
+    {
+        const double x = (double)i * tableStep;
+        if (x >= halfWidth) { kernel[(size_t)i] = 0.0f; continue; }
+
+        const double u    = x / halfWidth;
+        const double arg  = juce::MathConstants<double>::pi * cutoff * x;
+        const double sinc = x == 0.0 ? 1.0 : std::sin(arg) / arg;
+        const double win  = besselI0(kaiserBeta * std::sqrt(1.0 - u * u)) / i0Beta;
+        kernel[(size_t)i] = (float)(cutoff * sinc * win);
+    }
+
+    auto tap = [&](double x)
+    {
+        const double pos  = std::abs(x) / tableStep;
+        const int    idx  = (int)pos;
+        if (idx + 1 >= tableSize) return 0.0f;
+        const float  frac = (float)(pos - (double)idx);
+        return kernel[(size_t)idx] + frac * (kernel[(size_t)idx + 1] - kernel[(size_t)idx]);
+    };
+
+    const int outLength = (int)std::ceil((double)inLength * ratio);
+    const int reach     = (int)std::ceil(halfWidth);
+
+    juce::AudioBuffer<float> out(numChannels, outLength);
+    std::vector<float> weights((size_t)(2 * reach + 1));
+
+    for (int n = 0; n < outLength; ++n)
+    {
+        const double t     = (double)n / ratio;
+        const int    first = juce::jmax(0, (int)std::floor(t) - reach + 1);
+        const int    last  = juce::jmin(inLength - 1, (int)std::floor(t) + reach);
+
+        // Weights are shared by every channel
+        int count = 0;
+        for (int k = first; k <= last; ++k)
+            weights[(size_t)count++] = tap(t - (double)k);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const float* src = source.getReadPointer(ch) + first;
+            float acc = 0.0f;
+            for (int i = 0; i < count; ++i)
+                acc += src[i] * weights[(size_t)i];
+            out.setSample(ch, n, acc);
+        }
+    }
+
+    return out;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+
+// ── H9Resampler ─────────────────────────────────────────────────────────────
+// Offline band-limited sample-rate conversion (Kaiser-windowed sinc, 32 zero
+// crossings, table-driven with linear interpolation between 512 phases).
+// When converting down the cutoff follows the target Nyquist, so nothing
+// above it aliases back. Not real-time safe — used by the sample loader so
+// that voices can play cached audio at unity rate.
+
+class H9Resampler
+{
+public:
+    static constexpr int    zeroCrossings = 32;
+    static constexpr int    phasesPerZero = 512;
+    static constexpr double kaiserBeta    = 9.0;    // ≈ -90 dB sidelobes
+    static constexpr double passband      = 0.97;   // cutoff / Nyquist
+
+    static juce::AudioBuffer<float> process(const juce::AudioBuffer<float>& source,
+                                            double sourceRate, double targetRate);
+
+    static bool needsConversion(double sourceRate, double targetRate)
+    {
+        return sourceRate > 0.0 && targetRate > 0.0
+            && std::abs(sourceRate - targetRate) > 1.0e-6 * targetRate;
+    }
+};
@@ -0,0 +1,254 @@
+#include "H9SampleLoader.h"
+#include "Audio/H9Resampler.h"
+#include "Audio/H9ResampleCache.h"
+#include "Audio/H9SampleRelinker.h"
+#include "Core/H9Trace.h"
+
+// ── Shared state ─────────────────────────────────────────────────────────────
+// Outlives the loader if a job is still running when the plugin is deleted.
+
+struct H9SampleLoader::Shared
+{
+    juce::CriticalSection lock;
+    H9SampleLoader* owner { nullptr };      // cleared by ~H9SampleLoader
+    std::unique_ptr<Result> completed;      // guarded by lock
+    std::atomic<int> latestGeneration { 0 };
+};
+
+// ── Background job ───────────────────────────────────────────────────────────
+
+class H9SampleLoader::Job
+{
+public:
+    Job(std::shared_ptr<Shared> s, Request r, int gen)
+        : shared(std::move(s)), request(std::move(r)), generation(gen) {}
+
+    void run(H9JobSystem& jobs, const H9JobToken& t)
+    {
+        H9_TRACE_SCOPE("sample load");
+        token = &t;
+
+        formats.registerBasicFormats();
+
+        auto result = std::make_unique<Result>();
+        result->set = std::make_unique<H9SampleSet>();
+
+        for (int i = 0; i < numPads; ++i)
+        {
+            if (isSuperseded()) return;
+
+            auto& ref  = request.refs[(size_t)i];
+            auto  file = request.kitFiles[(size_t)i];
+
+            bool relinked = false;
+            if (!file.existsAsFile())
+                file = relinker.resolve(ref, t, relinked);
+
+            if (!file.existsAsFile())
+            {
+                result->refs[(size_t)i] = ref;   // keep the reference for next time
+                if (!ref.isEmpty()) ++result->numMissing;
+                continue;
+            }
+
+            auto& pad = result->set->pads[(size_t)i];
+            if (loadPad(file, pad, result->refs[(size_t)i]))
+            {
+                pad.gain       = request.gains[(size_t)i];
+                pad.chokeGroup = request.chokeGroups[(size_t)i];
+                pad.tune       = request.tunes[(size_t)i];
+                pad.velocityToPitch = request.velocityToPitch[(size_t)i];
+                if (relinked) ++result->numRelinked;
+
+                if (request.measureStorage)
+                    accumulate(result->storage, H9SampleStore::measure(pad.audio),
+                               pad.audio.getNumSamples(),
+                               (size_t)pad.audio.getNumSamples() * (size_t)pad.audio.getNumChannels() * sizeof(float));
+
+                pad.store.build(pad.audio, request.storage);
+                pad.audio = {};
+            }
+        }
+
+        if (isSuperseded()) return;
+
+        if (wroteCache)
+            jobs.submit(H9JobSystem::Priority::background, "sample cache prune",
+                        [](const H9JobToken&) { H9ResampleCache::prune(); });
+
+        const juce::ScopedLock sl(shared->lock);
+        if (shared->owner != nullptr && shared->latestGeneration.load() == generation)
+        {
+            shared->completed = std::move(result);
+            shared->owner->triggerAsyncUpdate();
+        }
+    }
+
+private:
+    std::shared_ptr<Shared> shared;
+    Request request;
+    int generation;
+    const H9JobToken* token { nullptr };
+
+    juce::AudioFormatManager formats;
+    H9SampleRelinker relinker { request.libraryRoot };
+
+    bool wroteCache { false };
+    juce::int64 measuredFrames { 0 };
+    size_t measuredFloatBytes { 0 };
+
+    // Sums bytes, frame-weights decode cost and keeps the worst error
+    void accumulate(std::vector<H9SampleStore::Measurement>& total,
+                    const std::vector<H9SampleStore::Measurement>& pad,
+                    int frames, size_t floatBytes)
+    {
+        if (total.empty())
+        {
+            total = pad;
+            measuredFrames = frames;
+            measuredFloatBytes = floatBytes;
+            return;
+        }
+
+        const double w = (double)frames / (double)(measuredFrames + frames);
+        measuredFrames += frames;
+        measuredFloatBytes += floatBytes;
+
+        for (size_t i = 0; i < total.size() && i < pad.size(); ++i)
+        {
+            auto& t = total[i];
+            t.bytes += pad[i].bytes;
+            t.ratio  = (double)t.bytes / (double)measuredFloatBytes;
+            t.decodeNsPerFrame += w * (pad[i].decodeNsPerFrame - t.decodeNsPerFrame);
+            t.maxError = juce::jmax(t.maxError, pad[i].maxError);
+        }
+    }
+
+    bool isSuperseded() const
+    {
+        return token->isCancelled() || shared->latestGeneration.load() != generation;
+    }
+
+    bool loadPad(const juce::File& file, H9PadSample& pad, H9SampleRef& ref)
+    {
+        const double target   = request.targetSampleRate;
+        const bool   streamed = target > 0.0 && request.preloadFrames > 0;
+
+        if (streamed ? loadHead(file, pad, ref)
+                     : target > 0.0 && H9ResampleCache::load(file, target, pad, ref))
+            return true;
+
+        if (!decode(file, pad, ref))
+            return false;
+
+        const bool convert = target > 0.0 && H9Resampler::needsConversion(pad.sampleRate, target);
+        if (convert)
+        {
+            H9_TRACE_SCOPE("resample");
+            pad.audio      = H9Resampler::process(pad.audio, pad.sampleRate, target);
+            pad.sampleRate = target;
+        }
+
+        // Streamed pads always need an entry to read from, even at the file's
+        // own rate; if it can't be written the pad just stays fully resident
+        if (convert || (streamed && pad.audio.getNumSamples() > request.preloadFrames))
+        {
+            const bool stored = H9ResampleCache::store(file, target, pad, ref);
+            wroteCache |= stored;
+
+            if (streamed && stored)
+                loadHead(file, pad, ref);
+        }
+        return true;
+    }
+
+    bool loadHead(const juce::File& file, H9PadSample& pad, H9SampleRef& ref)
+    {
+        auto source = std::make_unique<H9StreamSource>();
+        if (!H9ResampleCache::loadHead(file, request.targetSampleRate, request.preloadFrames,
+                                       pad, ref, *source))
+            return false;
+
+        if (source->frames > pad.audio.getNumSamples())
+            pad.stream = std::move(source);
+        return true;
+    }
+
+    // Reads the file once: the same bytes are hashed and decoded
+    bool decode(const juce::File& file, H9PadSample& pad, H9SampleRef& ref)
+    {
+        juce::MemoryBlock bytes;
+        if (!file.loadFileAsData(bytes) || bytes.getSize() == 0)
+            return false;
+
+        ref.path = file.getFullPathName();
+        ref.hash = juce::MD5(bytes).toHexString();
+        ref.size = (juce::int64)bytes.getSize();
+
+        std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(
+            std::make_unique<juce::MemoryInputStream>(bytes, false)));
+
+        if (reader == nullptr || reader->lengthInSamples <= 0)
+            return false;
+
+        const int channels = juce::jlimit(1, 2, (int)reader->numChannels);
+        const int length   = (int)reader->lengthInSamples;
+
+        pad.audio.setSize(channels, length);
+        reader->read(&pad.audio, 0, length, 0, true, channels > 1);
+        pad.sampleRate = reader->sampleRate;
+        pad.path       = ref.path;
+        return true;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(Job)
+};
+
+// ── H9SampleLoader ───────────────────────────────────────────────────────────
+
+H9SampleLoader::H9SampleLoader()
+    : shared(std::make_shared<Shared>())
+{
+    shared->owner = this;
+}
+
+H9SampleLoader::~H9SampleLoader()
+{
+    {
+        const juce::ScopedLock sl(shared->lock);
+        shared->owner = nullptr;
+    }
+    ++shared->latestGeneration;
+    token.cancel();   // running jobs bail out at the next pad
+    cancelPendingUpdate();
+}
+
+void H9SampleLoader::load(Request request)
+{
+    const int generation = ++shared->latestGeneration;
+    busy.store(true, std::memory_order_relaxed);
+
+    token.cancel();
+    token = {};
+
+    // std::function needs a copyable callable; the job itself is move-only
+    auto job = std::make_shared<Job>(shared, std::move(request), generation);
+    auto* system = &jobs.getObject();
+    system->submit(H9JobSystem::Priority::user, "sample load", token,
+                   [job, system](const H9JobToken& t) { job->run(*system, t); });
+}
+
+void H9SampleLoader::handleAsyncUpdate()
+{
+    std::unique_ptr<Result> result;
+    {
+        const juce::ScopedLock sl(shared->lock);
+        result = std::move(shared->completed);
+    }
+    if (result == nullptr) return;
+
+    busy.store(false, std::memory_order_relaxed);
+
+    if (onLoaded)
+        onLoaded(std::move(*result));
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_events/juce_events.h>
+#include "Audio/H9PadSampler.h"
+#include "Core/H9JobSystem.h"
+#include "Data/H9PluginState.h"
+
+// ── H9SampleLoader ──────────────────────────────────────────────────────────
+// Reads, hashes and decodes a kit's pad samples as user-priority jobs on the
+// process-wide H9JobSystem, so neither kit switches nor session restore
+// block the message thread. Each pad is resolved in order:
+//   1. the kit's own file, if the kit is in the library
+//   2. the saved path
+//   3. the library index — same file name first, then any audio file with
+//      the saved size and content hash (H9SampleRelinker)
+// Pads are then converted to the request's target rate with band-limited
+// SRC and kept in H9ResampleCache, so reopening at the same host rate skips
+// decoding and conversion entirely. Finally each pad is encoded into the
+// kit's resident storage format — for streaming kits just the first
+// `preloadFrames` of each pad, the rest being read from the cache entry by
+// H9DiskStreams while voices play. Only the newest request is delivered:
+// each load() cancels the previous request's token, so a stale job still
+// queued never starts and a running one stops at the next pad. Cache
+// pruning afterwards runs as a background job.
+
+class H9SampleLoader : private juce::AsyncUpdater
+{
+public:
+    static constexpr int numPads = H9SampleSet::numPads;
+
+    struct Request
+    {
+        std::array<juce::File, numPads>  kitFiles;   // may be empty / missing
+        std::array<float, numPads>       gains;
+        std::array<int, numPads>         chokeGroups;
+        std::array<float, numPads>       tunes;             // semitones
+        std::array<float, numPads>       velocityToPitch;   // semitones at full velocity
+        std::array<H9SampleRef, numPads> refs;       // saved references
+        juce::File libraryRoot;                      // relink search root
+        double targetSampleRate { 0.0 };             // 0 = keep file rates
+        H9SampleStore::Format storage { H9SampleStore::Format::float32 };
+        int preloadFrames { 0 };                     // > 0: stream past this many
+                                                     // frames (needs a target rate)
+        bool measureStorage { false };               // fill Result::storage
+
+        Request() { gains.fill(1.0f); chokeGroups.fill(0); tunes.fill(0.0f); velocityToPitch.fill(0.0f); }
+    };
+
+    struct Result
+    {
+        std::unique_ptr<H9SampleSet>     set;
+        std::array<H9SampleRef, numPads> refs;       // what was actually loaded
+        int numRelinked { 0 };
+        int numMissing  { 0 };
+
+        // Whole-kit totals per encoding when Request::measureStorage was set
+        std::vector<H9SampleStore::Measurement> storage;
+    };
+
+    H9SampleLoader();
+    ~H9SampleLoader() override;
+
+    // Message thread. Supersedes any request still in flight.
+    void load(Request request);
+
+    bool isLoading() const noexcept { return busy.load(std::memory_order_relaxed); }
+
+    // Called on the message thread with the newest finished request
+    std::function<void(Result&&)> onLoaded;
+
+private:
+    struct Shared;
+    class Job;
+
+    std::shared_ptr<Shared> shared;
+    juce::SharedResourcePointer<H9JobSystem> jobs;
+    H9JobToken token;   // the newest request's
+    std::atomic<bool> busy { false };
+
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE(H9SampleLoader)
+};
@@ -0,0 +1,62 @@
+#include "H9SampleRelinker.h"
+#include "Core/H9Trace.h"
+
+H9SampleRelinker::H9SampleRelinker(juce::File libraryRoot)
+    : root(std::move(libraryRoot))
+{
+}
+
+juce::File H9SampleRelinker::resolve(const H9SampleRef& ref, const H9JobToken& token, bool& relinked)
+{
+    relinked = false;
+
+    if (ref.path.isNotEmpty())
+        if (const juce::File file(ref.path); file.existsAsFile())
+            return file;
+
+    if (ref.hash.isEmpty())
+        return {};
+
+    auto file = find(ref, token);
+    relinked = file.existsAsFile();
+    return file;
+}
+
+bool H9SampleRelinker::matches(const juce::File& f, const H9SampleRef& ref)
+{
+    if (ref.size > 0 && f.getSize() != ref.size)
+        return false;
+
+    juce::MemoryBlock bytes;
+    return f.loadFileAsData(bytes) && juce::MD5(bytes).toHexString() == ref.hash;
+}
+
+juce::File H9SampleRelinker::find(const H9SampleRef& ref, const H9JobToken& token)
+{
+    if (!root.isDirectory() || ref.hash.isEmpty())
+        return {};
+
+    if (!libraryScanned)
+    {
+        H9_TRACE_SCOPE("library index scan");
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+        libraryFiles = root.findChildFiles(juce::File::findFiles, true,
+                                           formats.getWildcardForAllFormats());
+        libraryScanned = true;
+    }
+
+    // Same file name first — the common case is a moved / renamed folder
+    const auto name = juce::File(ref.path).getFileName();
+    for (auto& f : libraryFiles)
+        if (f.getFileName() == name && matches(f, ref))
+            return f;
+
+    for (auto& f : libraryFiles)
+    {
+        if (token.isCancelled()) return {};
+        if (f.getFileName() != name && matches(f, ref))
+            return f;
+    }
+    return {};
+}
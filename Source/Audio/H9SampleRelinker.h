@@ -0,0 +1,33 @@
+#pragma once
+#include <juce_audio_formats/juce_audio_formats.h>
+#include "Core/H9JobSystem.h"
+#include "Data/H9PluginState.h"
+
+// ── H9SampleRelinker ────────────────────────────────────────────────────────
+// Finds a saved sample again: at its saved path, else in the library — same
+// file name first, then any audio file with the saved size and content hash.
+// The library is scanned once, on the first lookup that needs it, so one
+// relinker serves a whole kit. Job threads only: lookups read files.
+
+class H9SampleRelinker
+{
+public:
+    explicit H9SampleRelinker(juce::File libraryRoot);
+
+    // The saved path if it exists, otherwise a library file with the saved
+    // hash, otherwise an empty File. `relinked` is set when the file moved.
+    // Gives up early once `token` is cancelled.
+    juce::File resolve(const H9SampleRef&, const H9JobToken& token, bool& relinked);
+
+    // Library search only
+    juce::File find(const H9SampleRef&, const H9JobToken& token);
+
+    static bool matches(const juce::File&, const H9SampleRef&);
+
+private:
+    juce::File root;
+    juce::Array<juce::File> libraryFiles;
+    bool libraryScanned { false };
+
+    JUCE_DECLARE_NON_COPYABLE(H9SampleRelinker)
+};
@@ -0,0 +1,347 @@
+#include "H9SampleStore.h"
+
+#if JUCE_USE_SSE_INTRINSICS
+ #include <emmintrin.h>
+#elif JUCE_USE_ARM_NEON
+ #include <arm_neon.h>
+#endif
+
+namespace
+{
+    constexpr float int24Max = 8388607.0f;
+    constexpr float int16Max = 32767.0f;
+    constexpr int   readPadding = 8;   // bit reader loads 8 bytes at a time
+
+    inline juce::uint32 zigZag(juce::int32 v) noexcept   { return ((juce::uint32)v << 1) ^ (juce::uint32)(v >> 31); }
+    inline juce::int32  unZigZag(juce::uint32 v) noexcept { return (juce::int32)(v >> 1) ^ -(juce::int32)(v & 1); }
+
+    inline int bitsFor(juce::uint32 v) noexcept
+    {
+        int n = 0;
+        while (v != 0) { ++n; v >>= 1; }
+        return n;
+    }
+
+    inline juce::uint64 load64(const juce::uint8* p) noexcept
+    {
+        juce::uint64 v;
+        std::memcpy(&v, p, sizeof(v));
+        return juce::ByteOrder::swapIfBigEndian(v);
+    }
+
+    // int16 → float with a multiplier; 8 samples per iteration where available
+    void widenInt16(const juce::int16* src, float* dest, float multiplier, int num) noexcept
+    {
+        int i = 0;
+
+       #if JUCE_USE_SSE_INTRINSICS
+        const __m128 mul = _mm_set1_ps(multiplier);
+        for (; i + 8 <= num; i += 8)
+        {
+            const __m128i x  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);   // sign-extend
+            const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+            _mm_storeu_ps(dest + i,     _mm_mul_ps(_mm_cvtepi32_ps(lo), mul));
+            _mm_storeu_ps(dest + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), mul));
+        }
+       #elif JUCE_USE_ARM_NEON
+        for (; i + 8 <= num; i += 8)
+        {
+            const int16x8_t x = vld1q_s16(src + i);
+            vst1q_f32(dest + i,     vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(x))),  multiplier));
+            vst1q_f32(dest + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(x))), multiplier));
+        }
+       #endif
+
+        for (; i < num; ++i)
+            dest[i] = (float)src[i] * multiplier;
+    }
+}
+
+// ── Names ───────────────────────────────────────────────────────────────────
+
+const char* H9SampleStore::getFormatName(Format f)
+{
+    switch (f)
+    {
+        case Format::float32:    return "float32";
+        case Format::int24:      return "int24";
+        case Format::int16:      return "int16";
+        case Format::compressed: return "compressed";
+    }
+    return "float32";
+}
+
+H9SampleStore::Format H9SampleStore::parseFormat(const juce::String& name, Format fallback)
+{
+    for (auto f : { Format::float32, Format::int24, Format::int16, Format::compressed })
+        if (name.equalsIgnoreCase(getFormatName(f)))
+            return f;
+    return fallback;
+}
+
+// ── Encoding ────────────────────────────────────────────────────────────────
+
+void H9SampleStore::clear()
+{
+    format = Format::float32;
+    numChannels = numFrames = 0;
+    scale = 1.0f;
+    floats = {};
+    shared.reset();
+    sharedStart = 0;
+    payload.clear();
+    payloadBytes.clear();
+    blocks.clear();
+}
+
+void H9SampleStore::build(const juce::AudioBuffer<float>& source, Format newFormat)
+{
+    clear();
+    format      = newFormat;
+    numChannels = source.getNumChannels();
+    numFrames   = source.getNumSamples();
+
+    if (numChannels == 0 || numFrames == 0)
+        return;
+
+    if (format == Format::float32)
+    {
+        floats.makeCopyOf(source);
+        return;
+    }
+
+    float peak = 1.0e-9f;
+    for (int ch = 0; ch < numChannels; ++ch)
+        peak = juce::jmax(peak, source.getMagnitude(ch, 0, numFrames));
+
+    const float fullScale = format == Format::int16 ? int16Max : int24Max;
+    const float toInt     = fullScale / peak;
+    scale = peak / fullScale;
+
+    auto quantise = [&](int ch, int i)
+    {
+        return (juce::int32)juce::jlimit(-fullScale, fullScale,
+                                         std::round(source.getSample(ch, i) * toInt));
+    };
+
+    payload.resize((size_t)numChannels);
+    payloadBytes.resize((size_t)numChannels);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto& bytes = payload[(size_t)ch];
+
+        if (format == Format::int16)
+        {
+            payloadBytes[(size_t)ch] = (size_t)numFrames * 2;
+            bytes.allocate(payloadBytes[(size_t)ch], false);
+            auto* dest = reinterpret_cast<juce::int16*>(bytes.get());
+            for (int i = 0; i < numFrames; ++i)
+                dest[i] = (juce::int16)quantise(ch, i);
+        }
+        else if (format == Format::int24)
+        {
+            payloadBytes[(size_t)ch] = (size_t)numFrames * 3;
+            bytes.allocate(payloadBytes[(size_t)ch], false);
+            auto* dest = bytes.get();
+            for (int i = 0; i < numFrames; ++i)
+            {
+                const auto v = (juce::uint32)quantise(ch, i);
+                dest[i * 3 + 0] = (juce::uint8)(v);
+                dest[i * 3 + 1] = (juce::uint8)(v >> 8);
+                dest[i * 3 + 2] = (juce::uint8)(v >> 16);
+            }
+        }
+        else // compressed
+        {
+            const int numBlocks = (numFrames + blockFrames - 1) / blockFrames;
+            auto& headers = blocks.emplace_back();
+            headers.resize((size_t)numBlocks);
+
+            std::vector<juce::uint8> packed;
+            for (int b = 0; b < numBlocks; ++b)
+            {
+                const int start = b * blockFrames;
+                const int n     = juce::jmin(blockFrames, numFrames - start);
+
+                juce::uint32 codes[blockFrames];
+                juce::uint32 widest = 0;
+                juce::int32  prev   = quantise(ch, start);
+                for (int i = 1; i < n; ++i)
+                {
+                    const auto v = quantise(ch, start + i);
+                    codes[i] = zigZag(v - prev);
+                    widest |= codes[i];
+                    prev = v;
+                }
+
+                auto& h = headers[(size_t)b];
+                h.first      = quantise(ch, start);
+                h.bits       = (juce::uint8)bitsFor(widest);
+                h.byteOffset = (juce::uint32)packed.size();
+
+                const size_t blockBytes = ((size_t)(n - 1) * h.bits + 7) / 8;
+                packed.resize(packed.size() + blockBytes, 0);
+                auto* out = packed.data() + h.byteOffset;
+
+                for (int i = 1; i < n; ++i)
+                {
+                    const size_t bit = (size_t)(i - 1) * h.bits;
+                    for (int k = 0; k < h.bits; ++k)
+                        if ((codes[i] >> k) & 1u)
+                            out[(bit + (size_t)k) >> 3] |= (juce::uint8)(1u << ((bit + (size_t)k) & 7));
+                }
+            }
+
+            payloadBytes[(size_t)ch] = packed.size();
+            bytes.allocate(packed.size() + readPadding, true);
+            std::memcpy(bytes.get(), packed.data(), packed.size());
+        }
+    }
+}
+
+void H9SampleStore::share(std::shared_ptr<const juce::AudioBuffer<float>> source, int start, int num)
+{
+    clear();
+    if (source == nullptr)
+        return;
+
+    start = juce::jlimit(0, source->getNumSamples(), start);
+    num   = juce::jlimit(0, source->getNumSamples() - start, num);
+    if (source->getNumChannels() == 0 || num == 0)
+        return;
+
+    numChannels = source->getNumChannels();
+    numFrames   = num;
+    sharedStart = start;
+    shared      = std::move(source);
+}
+
+size_t H9SampleStore::getMemoryBytes() const noexcept
+{
+    if (shared != nullptr)
+        return 0;
+
+    if (format == Format::float32)
+        return (size_t)numChannels * (size_t)numFrames * sizeof(float);
+
+    size_t total = 0;
+    for (auto n : payloadBytes) total += n;
+    for (auto& h : blocks)      total += h.size() * sizeof(BlockHeader);
+    return total;
+}
+
+// ── Decoding (real-time) ────────────────────────────────────────────────────
+
+void H9SampleStore::decodeCompressedBlock(int channel, int block, int num, float* dest) const noexcept
+{
+    const auto& h   = blocks[(size_t)channel][(size_t)block];
+    const auto* src = payload[(size_t)channel].get() + h.byteOffset;
+    const juce::uint32 mask = h.bits == 0 ? 0u : (0xffffffffu >> (32 - h.bits));
+
+    int values[blockFrames];
+    juce::int32 v = h.first;
+    values[0] = v;
+
+    for (int i = 1; i < num; ++i)
+    {
+        const size_t bit = (size_t)(i - 1) * h.bits;
+        const auto code  = (juce::uint32)(load64(src + (bit >> 3)) >> (bit & 7)) & mask;
+        v += unZigZag(code);
+        values[i] = v;
+    }
+
+    juce::FloatVectorOperations::convertFixedToFloat(dest, values, scale, num);
+}
+
+void H9SampleStore::decode(int channel, int start, int num, float* dest) const noexcept
+{
+    jassert(start % blockFrames == 0);
+    num = juce::jmin(num, numFrames - start);
+    if (num <= 0) return;
+
+    switch (format)
+    {
+        case Format::float32:
+            juce::FloatVectorOperations::copy(dest, getFloatPointer(channel) + start, num);
+            break;
+
+        case Format::int16:
+            widenInt16(reinterpret_cast<const juce::int16*>(payload[(size_t)channel].get()) + start,
+                       dest, scale, num);
+            break;
+
+        case Format::int24:
+        {
+            const auto* src = payload[(size_t)channel].get() + (size_t)start * 3;
+            int values[blockFrames];
+            for (int done = 0; done < num; done += blockFrames)
+            {
+                const int n = juce::jmin(blockFrames, num - done);
+                for (int i = 0; i < n; ++i, src += 3)
+                    values[i] = (juce::int32)(((juce::uint32)src[0] << 8)
+                                            | ((juce::uint32)src[1] << 16)
+                                            | ((juce::uint32)src[2] << 24)) >> 8;
+                juce::FloatVectorOperations::convertFixedToFloat(dest + done, values, scale, n);
+            }
+            break;
+        }
+
+        case Format::compressed:
+            for (int done = 0; done < num; done += blockFrames)
+                decodeCompressedBlock(channel, (start + done) / blockFrames,
+                                      juce::jmin(blockFrames, num - done), dest + done);
+            break;
+    }
+}
+
+// ── Measurement ─────────────────────────────────────────────────────────────
+
+std::vector<H9SampleStore::Measurement> H9SampleStore::measure(const juce::AudioBuffer<float>& source)
+{
+    std::vector<Measurement> results;
+    const int frames = source.getNumSamples();
+    const size_t floatBytes = (size_t)source.getNumChannels() * (size_t)frames * sizeof(float);
+    if (frames == 0 || floatBytes == 0) return results;
+
+    std::vector<float> scratch((size_t)blockFrames);
+
+    for (auto f : { Format::float32, Format::int24, Format::int16, Format::compressed })
+    {
+        H9SampleStore store;
+        store.build(source, f);
+
+        Measurement m;
+        m.format = f;
+        m.bytes  = store.getMemoryBytes();
+        m.ratio  = (double)m.bytes / (double)floatBytes;
+
+        constexpr int passes = 3;
+        juce::int64 bestTicks = std::numeric_limits<juce::int64>::max();
+        for (int pass = 0; pass < passes; ++pass)
+        {
+            const auto t0 = juce::Time::getHighResolutionTicks();
+            for (int ch = 0; ch < store.getNumChannels(); ++ch)
+            {
+                for (int start = 0; start < frames; start += blockFrames)
+                {
+                    const int n = juce::jmin(blockFrames, frames - start);
+                    store.decode(ch, start, n, scratch.data());
+
+                    if (pass == 0)
+                        for (int i = 0; i < n; ++i)
+                            m.maxError = juce::jmax(m.maxError,
+                                std::abs(scratch[(size_t)i] - source.getSample(ch, start + i)));
+                }
+            }
+            bestTicks = juce::jmin(bestTicks, juce::Time::getHighResolutionTicks() - t0);
+        }
+
+        m.decodeNsPerFrame = (double)bestTicks * 1.0e9
+                           / (double)juce::Time::getHighResolutionTicksPerSecond()
+                           / (double)frames;   // all channels of a frame
+        results.push_back(m);
+    }
+    return results;
+}
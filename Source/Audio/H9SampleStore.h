@@ -0,0 +1,99 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+
+// ── H9SampleStore ───────────────────────────────────────────────────────────
+// Resident sample data in one of several encodings, decoded a window at a
+// time by voices just ahead of the play position:
+//
+//   float32      4 B/sample   direct pointer, no decode
+//   int24        3 B/sample   peak-normalised, packed little endian
+//   int16        2 B/sample   peak-normalised
+//   compressed   ~1–2 B/sample on typical drums; lossless over int24 —
+//                per 256-frame block a start value plus zig-zag first
+//                differences bit-packed at the block's widest width
+//
+// Every encoding is split into blockFrames-sized blocks so any block can be
+// decoded independently; decode() is real-time safe.
+//
+// A store can also be a float32 view of frames of a buffer it shares with
+// other stores (share()) — slices of one loop play from the loop itself.
+
+class H9SampleStore
+{
+public:
+    enum class Format { float32 = 0, int24, int16, compressed };
+
+    static constexpr int blockFrames = 256;
+
+    static const char* getFormatName(Format);
+    static Format parseFormat(const juce::String& name, Format fallback = Format::float32);
+
+    // Encodes `source` (1 or 2 channels). Not real-time safe.
+    void build(const juce::AudioBuffer<float>& source, Format format);
+
+    // Frames [start, start + num) of `source`, in place: float32, nothing
+    // copied. The store keeps `source` alive.
+    void share(std::shared_ptr<const juce::AudioBuffer<float>> source, int start, int num);
+
+    void clear();
+
+    Format getFormat()      const noexcept { return format; }
+    int    getNumChannels() const noexcept { return numChannels; }
+    int    getNumFrames()   const noexcept { return numFrames; }
+    bool   isShared()       const noexcept { return shared != nullptr; }
+
+    // What this store owns — 0 for a shared view
+    size_t getMemoryBytes() const noexcept;
+
+    // Non-null only for float32
+    const float* getFloatPointer(int channel) const noexcept
+    {
+        if (format != Format::float32) return nullptr;
+        return shared != nullptr ? shared->getReadPointer(channel, sharedStart)
+                                 : floats.getReadPointer(channel);
+    }
+
+    // Decodes frames [start, start + num) of `channel` into `dest`. `start`
+    // must be a multiple of blockFrames (voices align their windows).
+    void decode(int channel, int start, int num, float* dest) const noexcept;
+
+    // ── Measurement ─────────────────────────────────────────────────────────
+    // Memory vs. decode cost of each encoding for the same audio, to choose
+    // a kit's "storage" mode.
+    struct Measurement
+    {
+        Format format;
+        size_t bytes         { 0 };
+        double ratio         { 1.0 };   // bytes / float32 bytes
+        double decodeNsPerFrame { 0.0 };
+        float  maxError      { 0.0f };  // vs. the float source
+    };
+
+    static std::vector<Measurement> measure(const juce::AudioBuffer<float>& source);
+
+private:
+    Format format { Format::float32 };
+    int numChannels { 0 };
+    int numFrames   { 0 };
+    float scale     { 1.0f };   // integer → float multiplier
+
+    juce::AudioBuffer<float> floats;
+
+    std::shared_ptr<const juce::AudioBuffer<float>> shared;
+    int sharedStart { 0 };
+
+    // int16 / int24 / compressed payload, per channel
+    std::vector<juce::HeapBlock<juce::uint8>> payload;
+    std::vector<size_t> payloadBytes;
+
+    // compressed: per-channel, per-block {first value, bit width, bit offset}
+    struct BlockHeader
+    {
+        juce::int32  first;
+        juce::uint8  bits;
+        juce::uint32 byteOffset;
+    };
+    std::vector<std::vector<BlockHeader>> blocks;
+
+    void decodeCompressedBlock(int channel, int block, int num, float* dest) const noexcept;
+};
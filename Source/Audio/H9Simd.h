@@ -0,0 +1,168 @@
+#pragma once
+#include <juce_core/juce_core.h>
+
+#if JUCE_USE_SSE_INTRINSICS
+ #include <emmintrin.h>
+#elif JUCE_USE_ARM_NEON
+ #include <arm_neon.h>
+#endif
+
+// ── H9Simd ──────────────────────────────────────────────────────────────────
+// Four-lane float vectors for DSP that runs several channels of the same
+// recursion side by side (voices in H9VoiceDsp, delay lines in
+// H9FdnReverb). SSE or NEON where JUCE enables them, plain arrays
+// otherwise — same results lane for lane.
+
+namespace H9Simd
+{
+    static constexpr int lanes = 4;
+
+    // Masks are all-ones / all-zeros lanes, as the compare instructions give
+
+   #if JUCE_USE_SSE_INTRINSICS
+    using Vec = __m128;
+
+    inline Vec  vload(const float* p) noexcept     { return _mm_loadu_ps(p); }
+    inline void vstore(float* p, Vec v) noexcept   { _mm_storeu_ps(p, v); }
+    inline Vec  vset(float x) noexcept             { return _mm_set1_ps(x); }
+    inline Vec  vadd(Vec a, Vec b) noexcept        { return _mm_add_ps(a, b); }
+    inline Vec  vsub(Vec a, Vec b) noexcept        { return _mm_sub_ps(a, b); }
+    inline Vec  vmul(Vec a, Vec b) noexcept        { return _mm_mul_ps(a, b); }
+    inline Vec  vdiv(Vec a, Vec b) noexcept        { return _mm_div_ps(a, b); }
+    inline Vec  vmin(Vec a, Vec b) noexcept        { return _mm_min_ps(a, b); }
+    inline Vec  vmax(Vec a, Vec b) noexcept        { return _mm_max_ps(a, b); }
+    inline Vec  vabs(Vec a) noexcept               { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    inline Vec  vless(Vec a, Vec b) noexcept       { return _mm_cmplt_ps(a, b); }
+    inline Vec  vand(Vec a, Vec b) noexcept        { return _mm_and_ps(a, b); }
+    inline Vec  vselect(Vec m, Vec a, Vec b) noexcept { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+
+    inline Vec  vsetLanes(float a, float b, float c, float d) noexcept { return _mm_setr_ps(a, b, c, d); }
+
+    inline void vtranspose(Vec* r) noexcept        { _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]); }
+
+    // Lanes pairwise swapped (b a d c) / halves swapped (c d a b)
+    inline Vec  vswapPairs(Vec a) noexcept         { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)); }
+    inline Vec  vswapHalves(Vec a) noexcept        { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 0, 3, 2)); }
+
+   #elif JUCE_USE_ARM_NEON
+    using Vec = float32x4_t;
+
+    inline Vec  vload(const float* p) noexcept     { return vld1q_f32(p); }
+    inline void vstore(float* p, Vec v) noexcept   { vst1q_f32(p, v); }
+    inline Vec  vset(float x) noexcept             { return vdupq_n_f32(x); }
+    inline Vec  vadd(Vec a, Vec b) noexcept        { return vaddq_f32(a, b); }
+    inline Vec  vsub(Vec a, Vec b) noexcept        { return vsubq_f32(a, b); }
+    inline Vec  vmul(Vec a, Vec b) noexcept        { return vmulq_f32(a, b); }
+
+    inline Vec  vdiv(Vec a, Vec b) noexcept
+    {
+       #if defined (__aarch64__)
+        return vdivq_f32(a, b);
+       #else
+        // ARMv7 has no divide: reciprocal estimate plus two Newton steps
+        Vec r = vrecpeq_f32(b);
+        r = vmulq_f32(vrecpsq_f32(b, r), r);
+        r = vmulq_f32(vrecpsq_f32(b, r), r);
+        return vmulq_f32(a, r);
+       #endif
+    }
+    inline Vec  vmin(Vec a, Vec b) noexcept        { return vminq_f32(a, b); }
+    inline Vec  vmax(Vec a, Vec b) noexcept        { return vmaxq_f32(a, b); }
+    inline Vec  vabs(Vec a) noexcept               { return vabsq_f32(a); }
+    inline Vec  vless(Vec a, Vec b) noexcept       { return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+    inline Vec  vand(Vec a, Vec b) noexcept
+    {
+        return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+    }
+    inline Vec  vselect(Vec m, Vec a, Vec b) noexcept { return vbslq_f32(vreinterpretq_u32_f32(m), a, b); }
+
+    inline Vec  vsetLanes(float a, float b, float c, float d) noexcept
+    {
+        const float v[lanes] = { a, b, c, d };
+        return vld1q_f32(v);
+    }
+
+    inline Vec  vswapPairs(Vec a) noexcept         { return vrev64q_f32(a); }
+    inline Vec  vswapHalves(Vec a) noexcept        { return vcombine_f32(vget_high_f32(a), vget_low_f32(a)); }
+
+    inline void vtranspose(Vec* r) noexcept
+    {
+        const auto ab = vtrnq_f32(r[0], r[1]);
+        const auto cd = vtrnq_f32(r[2], r[3]);
+        r[0] = vcombine_f32(vget_low_f32(ab.val[0]),  vget_low_f32(cd.val[0]));
+        r[1] = vcombine_f32(vget_low_f32(ab.val[1]),  vget_low_f32(cd.val[1]));
+        r[2] = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+        r[3] = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+    }
+
+   #else
+    struct Vec { float v[lanes]; };
+
+    template <typename Fn>
+    inline Vec lanewise(Vec a, Vec b, Fn&& fn) noexcept
+    {
+        Vec r;
+        for (int i = 0; i < lanes; ++i)
+            r.v[i] = fn(a.v[i], b.v[i]);
+        return r;
+    }
+
+    inline juce::uint32 bitsOf(float x) noexcept   { juce::uint32 b; std::memcpy(&b, &x, sizeof(b)); return b; }
+    inline float floatOf(juce::uint32 b) noexcept  { float x; std::memcpy(&x, &b, sizeof(x)); return x; }
+
+    inline Vec  vload(const float* p) noexcept     { Vec r; std::memcpy(r.v, p, sizeof(r.v)); return r; }
+    inline void vstore(float* p, Vec v) noexcept   { std::memcpy(p, v.v, sizeof(v.v)); }
+    inline Vec  vset(float x) noexcept             { return { { x, x, x, x } }; }
+    inline Vec  vadd(Vec a, Vec b) noexcept        { return lanewise(a, b, [](float x, float y) { return x + y; }); }
+    inline Vec  vsub(Vec a, Vec b) noexcept        { return lanewise(a, b, [](float x, float y) { return x - y; }); }
+    inline Vec  vmul(Vec a, Vec b) noexcept        { return lanewise(a, b, [](float x, float y) { return x * y; }); }
+    inline Vec  vdiv(Vec a, Vec b) noexcept        { return lanewise(a, b, [](float x, float y) { return x / y; }); }
+    inline Vec  vmin(Vec a, Vec b) noexcept        { return lanewise(a, b, [](float x, float y) { return y < x ? y : x; }); }
+    inline Vec  vmax(Vec a, Vec b) noexcept        { return lanewise(a, b, [](float x, float y) { return x < y ? y : x; }); }
+    inline Vec  vabs(Vec a) noexcept               { return lanewise(a, a, [](float x, float) { return std::abs(x); }); }
+    inline Vec  vless(Vec a, Vec b) noexcept
+    {
+        return lanewise(a, b, [](float x, float y) { return floatOf(x < y ? 0xffffffffu : 0u); });
+    }
+    inline Vec  vand(Vec a, Vec b) noexcept
+    {
+        return lanewise(a, b, [](float x, float y) { return floatOf(bitsOf(x) & bitsOf(y)); });
+    }
+    inline Vec  vselect(Vec m, Vec a, Vec b) noexcept
+    {
+        Vec r;
+        for (int i = 0; i < lanes; ++i)
+            r.v[i] = bitsOf(m.v[i]) != 0 ? a.v[i] : b.v[i];
+        return r;
+    }
+
+    inline Vec  vsetLanes(float a, float b, float c, float d) noexcept { return { { a, b, c, d } }; }
+
+    inline void vtranspose(Vec* r) noexcept
+    {
+        for (int i = 0; i < 4; ++i)
+            for (int j = i + 1; j < 4; ++j)
+                std::swap(r[i].v[j], r[j].v[i]);
+    }
+
+    inline Vec  vswapPairs(Vec a) noexcept         { return { { a.v[1], a.v[0], a.v[3], a.v[2] } }; }
+    inline Vec  vswapHalves(Vec a) noexcept        { return { { a.v[2], a.v[3], a.v[0], a.v[1] } }; }
+   #endif
+
+    // Unnormalised 4-point Hadamard transform within one register:
+    // (a+b+c+d, a-b+c-d, a+b-c-d, a-b-c+d)
+    inline Vec vhadamard4(Vec x) noexcept
+    {
+        const Vec p = vadd(vswapPairs(x), vmul(x, vsetLanes(1.0f, -1.0f, 1.0f, -1.0f)));
+        return vadd(vswapHalves(p), vmul(p, vsetLanes(1.0f, 1.0f, -1.0f, -1.0f)));
+    }
+
+    // (a + b) + (c + d)
+    inline float vsum(Vec x) noexcept
+    {
+        const Vec p = vadd(x, vswapPairs(x));
+        alignas(16) float r[lanes];
+        vstore(r, vadd(p, vswapHalves(p)));
+        return r[0];
+    }
+}
@@ -0,0 +1,137 @@
+#include "H9StepSequencer.h"
+
+namespace
+{
+    // Positions this close to a sample count as on it: the host's rounding
+    // must not move a step on an exact sample to the next one
+    constexpr double onSample = 1.0e-6;
+
+    void bump(std::atomic<juce::uint64>& counter, juce::uint64 n = 1) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+}
+
+void H9StepSequencer::prepare(double sr)
+{
+    sampleRate = sr > 0.0 ? sr : 44100.0;
+    reset();
+
+    statEvents.store(0);
+    statJumps.store(0);
+    statDropped.store(0);
+}
+
+// ── Message thread ───────────────────────────────────────────────────────────
+
+void H9StepSequencer::setPattern(const H9StepPattern& pattern)
+{
+    auto next = std::make_unique<H9StepPattern>(pattern);
+    next->stepsPerBeat = juce::jlimit(1, H9StepPattern::maxStepsPerBeat, next->stepsPerBeat);
+    next->numSteps     = juce::jlimit(1, H9StepPattern::maxSteps, next->numSteps);
+    patterns.publish(std::move(next));
+}
+
+H9StepSequencer::Stats H9StepSequencer::getStats() const noexcept
+{
+    return { statEvents.load(std::memory_order_relaxed),
+             statJumps.load(std::memory_order_relaxed),
+             statDropped.load(std::memory_order_relaxed) };
+}
+
+// ── Audio thread ─────────────────────────────────────────────────────────────
+
+int H9StepSequencer::schedule(const Transport& t, int numSamples) noexcept
+{
+    bool changed = false;
+    const auto* pattern = patterns.acquire(changed);
+
+    numEvents = 0;
+    if (pattern == nullptr || !t.playing || t.bpm <= 0.0 || numSamples <= 0)
+    {
+        continuous = false;
+        return 0;
+    }
+
+    const double samplesPerBeat = sampleRate * 60.0 / t.bpm;
+    double beat = t.beat;
+
+    if (continuous && std::abs(beat - expectedBeat) * samplesPerBeat < 0.5)
+        beat = expectedBeat;
+    else if (continuous)
+        bump(statJumps);
+
+    const bool looping = t.looping && (t.loopEnd - t.loopStart) * samplesPerBeat >= 1.0;
+
+    for (int done = 0; done < numSamples;)
+    {
+        int count = numSamples - done;
+        bool wraps = false;
+
+        // Samples before the loop end, when the cycle wraps in this block
+        // or right after it — the next block then carries on from the
+        // loop start
+        if (looping && beat < t.loopEnd)
+        {
+            const double toEnd = std::ceil((t.loopEnd - beat) * samplesPerBeat - onSample);
+            if (toEnd <= count)
+            {
+                count = juce::jmax(0, (int)toEnd);
+                wraps = true;
+            }
+        }
+
+        scheduleSegment(*pattern, beat, samplesPerBeat, done, count);
+
+        done += count;
+        beat += count / samplesPerBeat;
+        if (wraps)
+            beat = t.loopStart + (beat - t.loopEnd);
+    }
+
+    expectedBeat = beat;
+    continuous   = true;
+
+    bump(statEvents, (juce::uint64)numEvents);
+    return numEvents;
+}
+
+// Adds the hits of the steps falling on samples [0, numSamples) of a stretch
+// starting at `beat`, with `offset` added
+void H9StepSequencer::scheduleSegment(const H9StepPattern& pattern, double beat, double samplesPerBeat,
+                                      int offset, int numSamples) noexcept
+{
+    const int    perBeat = pattern.stepsPerBeat;
+    const double last    = beat + numSamples / samplesPerBeat;
+
+    // Steps are counted from bar 1; before it (pre-roll) the pattern
+    // runs on backwards
+    for (juce::int64 n = (juce::int64)std::floor(beat * perBeat); (double)n / perBeat < last; ++n)
+    {
+        const double distance = ((double)n / perBeat - beat) * samplesPerBeat;
+        const int k = (int)std::ceil(distance - onSample);
+        if (k < 0)
+            continue;
+        if (k >= numSamples)
+            break;
+
+        auto step = (int)(n % pattern.numSteps);
+        if (step < 0)
+            step += pattern.numSteps;
+
+        for (int track = 0; track < numTracks; ++track)
+        {
+            const int velocity = pattern.velocity[(size_t)track][(size_t)step];
+            if (velocity == 0)
+                continue;
+
+            if (numEvents == maxEvents)
+            {
+                bump(statDropped);
+                continue;
+            }
+
+            events[(size_t)numEvents++] = { offset + k, track, (float)velocity / 127.0f };
+        }
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include "Core/H9ObjectHandoff.h"
+#include "Data/H9PluginState.h"
+
+// ── H9StepSequencer ─────────────────────────────────────────────────────────
+// Plays an H9StepPattern on the pads from the host transport, no MIDI clip
+// needed. Once per block, schedule() turns the host's beat position into a
+// list of pad hits with their sample offsets, which the processor merges
+// with the block's MIDI:
+//   timing      a step sounds on the first sample at or after its beat
+//               position, worked out from its distance to the block start
+//               — never by accumulating — so there is no drift however long
+//               the song
+//   continuity  a block that starts where the last one ended (to within
+//               half a sample) carries on from exactly that position, so no
+//               step falls between two blocks or lands in both, whatever
+//               the rounding in the host's positions. Tempo is the host's,
+//               per block.
+//   jumps       any other position (locate, scrub, a new tempo map) starts
+//               over from there, taking a step that lies on the first sample
+//   loops       when the host's cycle wraps inside a block, the block is
+//               scheduled as two segments: up to the loop end, then from
+//               the loop start
+// The pattern reaches the audio thread through H9ObjectHandoff; the event
+// list is fixed-size, so scheduling never allocates or locks. Hits past
+// maxEvents in one block are dropped and counted.
+
+class H9StepSequencer
+{
+public:
+    static constexpr int numTracks = H9StepPattern::numTracks;
+    static constexpr int maxEvents = 1024;   // per block
+
+    // The block's position, filled from the host playhead
+    struct Transport
+    {
+        bool   playing   { false };
+        double bpm       { 120.0 };
+        double beat      { 0.0 };     // at the first sample, counted in whole bars from bar 1
+        bool   looping   { false };
+        double loopStart { 0.0 };     // beats, counted as `beat`
+        double loopEnd   { 0.0 };
+    };
+
+    struct Event
+    {
+        int   sampleOffset;
+        int   track;                  // pad
+        float velocity;               // 0 … 1
+    };
+
+    struct Stats
+    {
+        juce::uint64 events  { 0 };   // since prepare()
+        juce::uint64 jumps   { 0 };
+        juce::uint64 dropped { 0 };
+    };
+
+    // Non-RT
+    void prepare(double sampleRate);
+
+    // ── Message thread ──────────────────────────────────────────────────────
+
+    void setPattern(const H9StepPattern&);
+    void collectGarbage() { patterns.collectGarbage(); }
+
+    Stats getStats() const noexcept;   // any thread
+
+    // ── Audio thread ────────────────────────────────────────────────────────
+
+    // Builds this block's hits, in sample order; returns how many
+    int schedule(const Transport&, int numSamples) noexcept;
+
+    // Forgets the position: the next block starts over (transport stopped,
+    // sequencer switched off)
+    void reset() noexcept { continuous = false; numEvents = 0; }
+
+    const Event* getEvents() const noexcept { return events.data(); }
+    int getNumEvents() const noexcept       { return numEvents; }
+
+private:
+    double sampleRate { 44100.0 };
+
+    // Audio thread
+    H9ObjectHandoff<H9StepPattern> patterns;
+    std::array<Event, maxEvents> events {};
+    int    numEvents    { 0 };
+    bool   continuous   { false };
+    double expectedBeat { 0.0 };    // where the next block starts if nothing moved
+
+    std::atomic<juce::uint64> statEvents { 0 }, statJumps { 0 }, statDropped { 0 };
+
+    void scheduleSegment(const H9StepPattern&, double beat, double samplesPerBeat,
+                         int offset, int numSamples) noexcept;
+};
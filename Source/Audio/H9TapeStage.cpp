@@ -0,0 +1,295 @@
+#include "H9TapeStage.h"
+#include "Audio/H9Simd.h"
+
+namespace
+{
+    using namespace H9Simd;
+
+    // Rational tanh, exact at ±3 and flat beyond
+    inline Vec shape(Vec x) noexcept
+    {
+        x = vmin(vset(3.0f), vmax(vset(-3.0f), x));
+        const Vec x2 = vmul(x, x);
+        return vdiv(vmul(x, vadd(vset(27.0f), x2)), vadd(vset(27.0f), vmul(vset(9.0f), x2)));
+    }
+
+    inline float shape(float x) noexcept
+    {
+        x = juce::jlimit(-3.0f, 3.0f, x);
+        return x * (27.0f + x * x) / (27.0f + 9.0f * x * x);
+    }
+}
+
+H9TapeStage::H9TapeStage() = default;
+H9TapeStage::~H9TapeStage() = default;
+
+void H9TapeStage::prepare(double sr, int maxBlockSize)
+{
+    sampleRate = sr;
+    maxBlock   = juce::jmax(1, maxBlockSize);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        oversamplers[i] = std::make_unique<juce::dsp::Oversampling<float>>(
+            (size_t)maxChannels, (size_t)(i + 1),
+            juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true, false);
+        oversamplers[i]->initProcessing((size_t)maxBlock);
+    }
+
+    // Two samples of margin below the shortest delay for the Hermite taps.
+    // The factor with the shorter oversampler delay gets a longer centre,
+    // so the total is the same whichever runs.
+    const float maxSwing  = (maxWowMs + maxFlutterMs) * 0.001f * (float)sr;
+    const float minCentre = maxSwing + 2.0f;
+    const float osLatency[2] = { oversamplers[0]->getLatencyInSamples(), oversamplers[1]->getLatencyInSamples() };
+
+    latency = (int)std::ceil(minCentre + juce::jmax(osLatency[0], osLatency[1]));
+    for (int i = 0; i < 2; ++i)
+        centreDelay[i] = (float)latency - osLatency[i];
+
+    // The ring holds a whole block on top of the longest delay
+    const int ringSize = juce::nextPowerOfTwo(maxBlock + latency + (int)std::ceil(maxSwing) + 4);
+    for (auto& r : ring)
+        r.assign((size_t)ringSize, 0.0f);
+    ringMask = ringSize - 1;
+
+    const int drySize = juce::nextPowerOfTwo(maxBlock + latency);
+    for (auto& r : dryRing)
+        r.assign((size_t)drySize, 0.0f);
+    dryMask = drySize - 1;
+
+    const float wowStep     = juce::MathConstants<float>::twoPi * wowHz / (float)sr;
+    const float flutterStep = juce::MathConstants<float>::twoPi * flutterHz / (float)sr;
+    wowStepSin     = std::sin(wowStep);
+    wowStepCos     = std::cos(wowStep);
+    flutterStepSin = std::sin(flutterStep);
+    flutterStepCos = std::cos(flutterStep);
+
+    delayTrack.assign((size_t)maxBlock, centreDelay[0]);
+    dryBus.setSize(maxChannels, maxBlock);
+
+    wowDepth.reset(sr, 0.05);
+    flutterDepth.reset(sr, 0.05);
+    drive.reset(sr, 0.05);
+    mix.reset(sr, 0.03);
+
+    reset();
+}
+
+void H9TapeStage::reset() noexcept
+{
+    for (auto& r : dryRing)
+        std::fill(r.begin(), r.end(), 0.0f);
+    dryWrite = 0;
+
+    resetTape();
+    mix.setCurrentAndTargetValue(mix.getTargetValue());
+}
+
+// Everything but the dry delay, which keeps running while the stage is off
+void H9TapeStage::resetTape() noexcept
+{
+    for (auto& r : ring)
+        std::fill(r.begin(), r.end(), 0.0f);
+    writePos = 0;
+
+    wowSin = flutterSin = 0.0f;
+    wowCos = flutterCos = 1.0f;
+
+    for (auto& o : oversamplers)
+        if (o != nullptr)
+            o->reset();
+
+    wowDepth.setCurrentAndTargetValue(wowDepth.getTargetValue());
+    flutterDepth.setCurrentAndTargetValue(flutterDepth.getTargetValue());
+    drive.setCurrentAndTargetValue(drive.getTargetValue());
+    active = false;
+}
+
+void H9TapeStage::setSettings(const Settings& s) noexcept
+{
+    mix.setTargetValue(s.enabled ? 1.0f : 0.0f);
+    drive.setTargetValue(juce::jlimit(0.0f, 1.0f, s.drive));
+    wowDepth.setTargetValue(juce::jlimit(0.0f, 1.0f, s.wow) * maxWowMs * 0.001f * (float)sampleRate);
+    flutterDepth.setTargetValue(juce::jlimit(0.0f, 1.0f, s.flutter) * maxFlutterMs * 0.001f * (float)sampleRate);
+
+    // The other factor's filters hold whatever they last saw. Its centre
+    // delay differs by the oversamplers' difference, a fraction of a sample.
+    if (s.oversampling != oversampling)
+    {
+        oversampling = s.oversampling;
+        oversamplers[(int)oversampling]->reset();
+    }
+}
+
+void H9TapeStage::process(juce::AudioBuffer<float>& buffer, int numSamples) noexcept
+{
+    const int numChannels = juce::jmin(maxChannels, buffer.getNumChannels());
+    const bool off = mix.getTargetValue() <= 0.0f && !mix.isSmoothing();
+
+    // Off: start clean next time
+    if (off && active)
+        resetTape();
+
+    active = !off;
+    auto& oversampler = *oversamplers[(int)oversampling];
+
+    for (int pos = 0; pos < numSamples; pos += maxBlock)
+    {
+        const int n = juce::jmin(maxBlock, numSamples - pos);
+
+        float* channels[maxChannels] {};
+        for (int c = 0; c < numChannels; ++c)
+            channels[c] = buffer.getWritePointer(c, pos);
+
+        delayDry(channels, numChannels, n);
+
+        if (off)
+        {
+            for (int c = 0; c < numChannels; ++c)
+                std::copy_n(dryBus.getReadPointer(c), n, channels[c]);
+            continue;
+        }
+
+        modulate(channels, numChannels, n);
+
+        juce::dsp::AudioBlock<float> block(channels, (size_t)numChannels, (size_t)n);
+        auto up = oversampler.processSamplesUp(block);
+        saturate(up, drive.skip(n));
+        oversampler.processSamplesDown(block);
+
+        if (mix.isSmoothing())
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                const float m = mix.getNextValue();
+                for (int c = 0; c < numChannels; ++c)
+                {
+                    const float dry = dryBus.getSample(c, i);
+                    channels[c][i] = dry + m * (channels[c][i] - dry);
+                }
+            }
+        }
+    }
+}
+
+// ── Dry delay ───────────────────────────────────────────────────────────────
+
+// Fills dryBus with the chunk's input `latency` samples late
+void H9TapeStage::delayDry(float* const* channels, int numChannels, int numSamples) noexcept
+{
+    for (int c = 0; c < numChannels; ++c)
+    {
+        float* r = dryRing[c].data();
+        float* d = dryBus.getWritePointer(c);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            r[(dryWrite + i) & dryMask] = channels[c][i];
+            d[i] = r[(dryWrite + i - latency) & dryMask];
+        }
+    }
+
+    dryWrite = (dryWrite + numSamples) & dryMask;
+}
+
+// ── Wow / flutter ───────────────────────────────────────────────────────────
+
+void H9TapeStage::modulate(float* const* channels, int numChannels, int numSamples) noexcept
+{
+    // Delay per output sample — shared by the channels
+    const float centre = centreDelay[(int)oversampling];
+    float* delay = delayTrack.data();
+    for (int i = 0; i < numSamples; ++i)
+    {
+        delay[i] = centre + wowDepth.getNextValue() * wowSin + flutterDepth.getNextValue() * flutterSin;
+
+        const float ws = wowSin * wowStepCos + wowCos * wowStepSin;
+        wowCos = wowCos * wowStepCos - wowSin * wowStepSin;
+        wowSin = ws;
+
+        const float fs = flutterSin * flutterStepCos + flutterCos * flutterStepSin;
+        flutterCos = flutterCos * flutterStepCos - flutterSin * flutterStepSin;
+        flutterSin = fs;
+    }
+
+    // Pull the rotations back onto the unit circle
+    const float wr = 1.0f / std::sqrt(wowSin * wowSin + wowCos * wowCos);
+    const float fr = 1.0f / std::sqrt(flutterSin * flutterSin + flutterCos * flutterCos);
+    wowSin *= wr;     wowCos *= wr;
+    flutterSin *= fr; flutterCos *= fr;
+
+    // The whole chunk goes in first; every read is at least two samples
+    // behind its own write position
+    for (int c = 0; c < numChannels; ++c)
+        for (int i = 0; i < numSamples; ++i)
+            ring[c][(size_t)((writePos + i) & ringMask)] = channels[c][i];
+
+    alignas(16) float frac[lanes], xm1[lanes], x0[lanes], x1[lanes], x2[lanes], out[lanes];
+    int index[lanes];
+
+    for (int i = 0; i < numSamples; i += lanes)
+    {
+        const int count = juce::jmin(lanes, numSamples - i);
+
+        for (int l = 0; l < lanes; ++l)
+        {
+            const int   s    = i + juce::jmin(l, count - 1);
+            const float read = (float)(writePos + s) - delay[s];
+            const float p    = std::floor(read);
+            index[l] = (int)p;
+            frac[l]  = read - p;
+        }
+
+        for (int c = 0; c < numChannels; ++c)
+        {
+            const float* r = ring[c].data();
+            for (int l = 0; l < lanes; ++l)
+            {
+                xm1[l] = r[(index[l] - 1) & ringMask];
+                x0[l]  = r[index[l] & ringMask];
+                x1[l]  = r[(index[l] + 1) & ringMask];
+                x2[l]  = r[(index[l] + 2) & ringMask];
+            }
+
+            // 4-point, 3rd-order Hermite
+            const Vec f  = vload(frac);
+            const Vec a  = vload(xm1), b = vload(x0), cc = vload(x1), d = vload(x2);
+            const Vec c1 = vmul(vset(0.5f), vsub(cc, a));
+            const Vec c2 = vsub(vadd(a, vadd(cc, cc)), vadd(vmul(vset(2.5f), b), vmul(vset(0.5f), d)));
+            const Vec c3 = vadd(vmul(vset(0.5f), vsub(d, a)), vmul(vset(1.5f), vsub(b, cc)));
+            vstore(out, vadd(vmul(vadd(vmul(vadd(vmul(c3, f), c2), f), c1), f), b));
+
+            std::copy_n(out, count, channels[c] + i);
+        }
+    }
+
+    writePos = (writePos + numSamples) & ringMask;
+}
+
+// ── Saturation (oversampled) ────────────────────────────────────────────────
+
+void H9TapeStage::saturate(juce::dsp::AudioBlock<float>& block, float driveAmount) noexcept
+{
+    // Biased for a touch of even harmonics; subtracting shape(bias) keeps
+    // silence at zero
+    const float pre    = 1.0f + 3.0f * driveAmount;
+    const float bias   = 0.2f * driveAmount;
+    const float offset = shape(bias);
+    const float makeup = 1.0f / std::sqrt(pre);
+
+    const Vec preV = vset(pre), biasV = vset(bias), offsetV = vset(offset), makeupV = vset(makeup);
+    const int n = (int)block.getNumSamples();
+
+    for (size_t c = 0; c < block.getNumChannels(); ++c)
+    {
+        float* x = block.getChannelPointer(c);
+
+        int i = 0;
+        for (; i + lanes <= n; i += lanes)
+            vstore(x + i, vmul(makeupV, vsub(shape(vadd(vmul(vload(x + i), preV), biasV)), offsetV)));
+
+        for (; i < n; ++i)
+            x[i] = makeup * (shape(x[i] * pre + bias) - offset);
+    }
+}
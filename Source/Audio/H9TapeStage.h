@@ -0,0 +1,100 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+
+// ── H9TapeStage ─────────────────────────────────────────────────────────────
+// Tape transport and saturation for lo-fi packs, run on the mix after the
+// lowpass. Two parts:
+//   wow / flutter   one modulated fractional delay shared by both channels
+//                   (it is one transport): a slow wow and a faster flutter
+//                   sine, read with 4-point Hermite interpolation four
+//                   output samples per SIMD register
+//   saturation      a biased rational tanh — odd and a little even
+//                   harmonic — at 2× or 4× the host rate through JUCE's
+//                   polyphase IIR oversampling, so the harmonics above
+//                   Nyquist are filtered off instead of folding back
+//
+// The stage has a fixed latency, getLatencySamples(), which the processor
+// reports to the host: the modulated delay's centre (about 1.3 ms) plus the
+// oversampler's delay, with the shorter oversampling factor padded out to
+// the longer one. The dry signal is held back by the same amount, so
+// switching on or off crossfades over 30 ms between aligned signals, and a
+// disabled stage is a plain delay.
+
+class H9TapeStage
+{
+public:
+    enum class Oversampling { x2 = 0, x4 };
+
+    struct Settings
+    {
+        bool  enabled { false };
+        float drive   { 0.3f };   // 0 … 1: up to +12 dB into the shaper, half made up after
+        float wow     { 0.3f };   // 0 … 1 of maxWowMs
+        float flutter { 0.2f };   // 0 … 1 of maxFlutterMs
+        Oversampling oversampling { Oversampling::x2 };
+    };
+
+    static constexpr float maxWowMs     = 1.5f;
+    static constexpr float maxFlutterMs = 0.12f;
+    static constexpr float wowHz        = 0.55f;
+    static constexpr float flutterHz    = 6.5f;
+
+    H9TapeStage();
+    ~H9TapeStage();
+
+    // Non-RT. Builds both oversamplers so the factor can change per block.
+    void prepare(double sampleRate, int maxBlockSize);
+    void reset() noexcept;
+
+    // Samples of delay through the stage, on or off. Fixed by prepare().
+    int getLatencySamples() const noexcept { return latency; }
+
+    // ── Audio thread ────────────────────────────────────────────────────────
+
+    // Call once per block with the current parameter values
+    void setSettings(const Settings&) noexcept;
+
+    // In place, on the first one or two channels
+    void process(juce::AudioBuffer<float>& buffer, int numSamples) noexcept;
+
+private:
+    static constexpr int maxChannels = 2;
+
+    double sampleRate { 44100.0 };
+    int    maxBlock   { 0 };
+
+    std::unique_ptr<juce::dsp::Oversampling<float>> oversamplers[2];   // ×2, ×4
+    Oversampling oversampling { Oversampling::x2 };
+
+    int latency { 0 };
+
+    // Modulated delay: one ring per channel, power-of-two sized
+    std::vector<float> ring[maxChannels];
+    int   ringMask  { 0 };
+    int   writePos  { 0 };
+    float centreDelay[2] {};    // samples, per factor; the modulation swings either side
+    float wowSin { 0.0f }, wowCos { 1.0f }, wowStepSin { 0.0f }, wowStepCos { 1.0f };
+    float flutterSin { 0.0f }, flutterCos { 1.0f }, flutterStepSin { 0.0f }, flutterStepCos { 1.0f };
+    juce::SmoothedValue<float> wowDepth, flutterDepth;   // samples
+    std::vector<float> delayTrack;   // per-sample delay for the current chunk
+
+    juce::SmoothedValue<float> drive;
+    juce::SmoothedValue<float> mix;  // 0 dry … 1 tape
+
+    // Dry path: the input `latency` samples late, for the crossfade and
+    // for the output while the stage is off
+    std::vector<float> dryRing[maxChannels];
+    int dryMask  { 0 };
+    int dryWrite { 0 };
+    juce::AudioBuffer<float> dryBus;
+
+    bool active { false };   // false: the tape hasn't run since the last reset
+
+    void resetTape() noexcept;
+    void delayDry(float* const* channels, int numChannels, int numSamples) noexcept;
+    void modulate(float* const* channels, int numChannels, int numSamples) noexcept;
+    void saturate(juce::dsp::AudioBlock<float>& block, float driveAmount) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE(H9TapeStage)
+};
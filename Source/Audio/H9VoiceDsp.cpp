@@ -0,0 +1,344 @@
+#include "H9VoiceDsp.h"
+#include "Audio/H9Simd.h"
+
+namespace
+{
+    using namespace H9Simd;
+
+    // ── One group of up to eight voices ─────────────────────────────────────
+
+    constexpr int lanes      = H9VoiceDsp::lanes;
+    static_assert(lanes == H9Simd::lanes, "one voice per vector lane");
+    constexpr int groupLanes = 2 * lanes;   // two registers, stepped interleaved
+
+    // Lane-major copies of each voice's coefficients and state
+    struct Group
+    {
+        alignas(16) float attackStep[groupLanes], decay[groupLanes], sustain[groupLanes];
+        alignas(16) float a1[groupLanes], a2[groupLanes], a3[groupLanes], k[groupLanes];
+        alignas(16) float low[groupLanes], band[groupLanes], high[groupLanes];
+        alignas(16) float start[groupLanes];   // first sample of the hit
+        alignas(16) float level[groupLanes], attacking[groupLanes];
+        alignas(16) float ic1L[groupLanes], ic2L[groupLanes], ic1R[groupLanes], ic2R[groupLanes];
+        alignas(16) float peak[groupLanes];
+        float* outL[groupLanes];   // nullptr for unused lanes
+        float* outR[groupLanes];
+    };
+
+    struct Svf
+    {
+        Vec a1, a2, a3, k, low, band, high;
+
+        // Steps the filter by one sample in every lane
+        Vec process(Vec x, Vec& ic1, Vec& ic2) const noexcept
+        {
+            const Vec v3 = vsub(x, ic2);
+            const Vec v1 = vadd(vmul(a1, ic1), vmul(a2, v3));
+            const Vec v2 = vadd(ic2, vadd(vmul(a2, ic1), vmul(a3, v3)));
+            ic1 = vsub(vadd(v1, v1), ic1);
+            ic2 = vsub(vadd(v2, v2), ic2);
+
+            const Vec hp = vsub(vsub(x, vmul(k, v1)), v2);
+            return vadd(vmul(low, v2), vadd(vmul(band, v1), vmul(high, hp)));
+        }
+    };
+
+    // Loads `n` (1 … 4) samples from each of four lanes at `t`, one vector
+    // per lane
+    inline void loadRows(float* const* rows, int t, int n, Vec* r) noexcept
+    {
+        for (int l = 0; l < lanes; ++l)
+        {
+            if (rows[l] == nullptr)
+            {
+                r[l] = vset(0.0f);
+            }
+            else if (n == lanes)
+            {
+                r[l] = vload(rows[l] + t);
+            }
+            else
+            {
+                float tmp[lanes] = {};
+                std::memcpy(tmp, rows[l] + t, sizeof(float) * (size_t)n);
+                r[l] = vload(tmp);
+            }
+        }
+    }
+
+    inline void storeRows(float* const* rows, int t, int n, const Vec* r) noexcept
+    {
+        for (int l = 0; l < lanes; ++l)
+        {
+            if (rows[l] == nullptr)
+                continue;
+
+            if (n == lanes)
+            {
+                vstore(rows[l] + t, r[l]);
+            }
+            else
+            {
+                float tmp[lanes];
+                vstore(tmp, r[l]);
+                std::memcpy(rows[l] + t, tmp, sizeof(float) * (size_t)n);
+            }
+        }
+    }
+
+    // Four samples at a time: load a 4×4 tile (voices × time) per register,
+    // transpose it so each vector holds one sample of four voices, step
+    // envelopes and filters through the four samples, transpose back and
+    // store. With two registers the filter recursions of both run
+    // interleaved, hiding each other's latency.
+    template <bool Stereo, int Regs>
+    void processGroup(Group& g, int numSamples) noexcept
+    {
+        const Vec one  = vset(1.0f);
+        const Vec half = vset(0.5f);
+
+        Vec attackStep[Regs], decay[Regs], sustain[Regs], start[Regs];
+        Svf svf[Regs];
+        Vec level[Regs], attacking[Regs], ic1L[Regs], ic2L[Regs], ic1R[Regs], ic2R[Regs], peak[Regs];
+
+        for (int r = 0; r < Regs; ++r)
+        {
+            const int o = r * lanes;
+            attackStep[r] = vload(g.attackStep + o);
+            decay[r]      = vload(g.decay + o);
+            sustain[r]    = vload(g.sustain + o);
+            start[r]      = vload(g.start + o);
+            svf[r]        = { vload(g.a1 + o), vload(g.a2 + o), vload(g.a3 + o), vload(g.k + o),
+                              vload(g.low + o), vload(g.band + o), vload(g.high + o) };
+            level[r]      = vload(g.level + o);
+            attacking[r]  = vless(half, vload(g.attacking + o));
+            ic1L[r] = vload(g.ic1L + o);
+            ic2L[r] = vload(g.ic2L + o);
+            ic1R[r] = vload(g.ic1R + o);
+            ic2R[r] = vload(g.ic2R + o);
+            peak[r] = vset(0.0f);
+        }
+
+        Vec l[Regs][lanes], rt[Regs][lanes];
+
+        // One sample of every voice: envelope, filter, level, peak
+        const auto step = [&](int t, int j) noexcept
+        {
+            const Vec now = vset((float)(t + j) + 0.5f);
+
+            for (int r = 0; r < Regs; ++r)
+            {
+                const Vec started = vless(start[r], now);
+
+                const Vec up   = vadd(level[r], attackStep[r]);
+                const Vec down = vadd(sustain[r], vmul(vsub(level[r], sustain[r]), decay[r]));
+                level[r]     = vselect(started, vselect(attacking[r], vmin(up, one), down), level[r]);
+                attacking[r] = vselect(started, vand(attacking[r], vless(up, one)), attacking[r]);
+
+                l[r][j] = vmul(svf[r].process(l[r][j], ic1L[r], ic2L[r]), level[r]);
+                peak[r] = vmax(peak[r], vabs(l[r][j]));
+
+                if constexpr (Stereo)
+                {
+                    rt[r][j] = vmul(svf[r].process(rt[r][j], ic1R[r], ic2R[r]), level[r]);
+                    peak[r]  = vmax(peak[r], vabs(rt[r][j]));
+                }
+            }
+        };
+
+        for (int t = 0; t < numSamples; t += lanes)
+        {
+            const int n = juce::jmin(lanes, numSamples - t);
+
+            for (int r = 0; r < Regs; ++r)
+            {
+                loadRows(g.outL + r * lanes, t, n, l[r]);
+                vtranspose(l[r]);
+                if constexpr (Stereo)
+                {
+                    loadRows(g.outR + r * lanes, t, n, rt[r]);
+                    vtranspose(rt[r]);
+                }
+            }
+
+            for (int j = 0; j < n; ++j)
+                step(t, j);
+
+            for (int r = 0; r < Regs; ++r)
+            {
+                vtranspose(l[r]);
+                storeRows(g.outL + r * lanes, t, n, l[r]);
+                if constexpr (Stereo)
+                {
+                    vtranspose(rt[r]);
+                    storeRows(g.outR + r * lanes, t, n, rt[r]);
+                }
+            }
+        }
+
+        for (int r = 0; r < Regs; ++r)
+        {
+            const int o = r * lanes;
+            vstore(g.level + o, level[r]);
+            vstore(g.attacking + o, vand(attacking[r], one));
+            vstore(g.ic1L + o, ic1L[r]);
+            vstore(g.ic2L + o, ic2L[r]);
+            vstore(g.ic1R + o, ic1R[r]);
+            vstore(g.ic2R + o, ic2R[r]);
+            vstore(g.peak + o, peak[r]);
+        }
+    }
+}
+
+// ── H9VoiceDsp ───────────────────────────────────────────────────────────────
+
+H9VoiceDsp::H9VoiceDsp()
+{
+    static_assert(maxVoices % lanes == 0, "voice state is processed in whole registers");
+    padOf.fill(0);
+    prepare(sampleRate);
+}
+
+void H9VoiceDsp::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+
+    for (int p = 0; p < numPads; ++p)
+        updateCoeffs(p);
+
+    level.fill(1.0f);
+    attacking.fill(0.0f);
+    ic1L.fill(0.0f); ic2L.fill(0.0f);
+    ic1R.fill(0.0f); ic2R.fill(0.0f);
+}
+
+void H9VoiceDsp::setTone(int pad, const Tone& tone) noexcept
+{
+    if (!juce::isPositiveAndBelow(pad, numPads))
+        return;
+
+    auto& t = tones[(size_t)pad];
+    if (t.attackMs == tone.attackMs && t.decayMs == tone.decayMs && t.sustain == tone.sustain
+        && t.filter == tone.filter && t.cutoffHz == tone.cutoffHz && t.resonance == tone.resonance)
+        return;
+
+    t = tone;
+    updateCoeffs(pad);
+}
+
+void H9VoiceDsp::updateCoeffs(int pad) noexcept
+{
+    const auto& t = tones[(size_t)pad];
+    auto& c = pads[(size_t)pad];
+
+    const double msToSamples = sampleRate * 0.001;
+
+    c.neutral    = t.isNeutral();
+    c.attackStep = t.attackMs > 0.0f ? (float)(1.0 / juce::jmax(1.0, t.attackMs * msToSamples)) : 1.0f;
+    c.decay      = (float)std::exp(std::log(0.001) / juce::jmax(1.0, t.decayMs * msToSamples));
+    c.sustain    = juce::jlimit(0.0f, 1.0f, t.sustain);
+
+    // TPT SVF. Resonance 0 … 1 maps damping k from 2 (Q 0.5) to 0.05 (Q 20).
+    const double fc = juce::jlimit(20.0, 0.45 * sampleRate, (double)t.cutoffHz);
+    const double g  = t.filter == Filter::off ? 0.0 : std::tan(juce::MathConstants<double>::pi * fc / sampleRate);
+    const double k  = 2.0 - 1.95 * juce::jlimit(0.0, 1.0, (double)t.resonance);
+    const double a1 = 1.0 / (1.0 + g * (g + k));
+
+    c.a1 = (float)a1;
+    c.a2 = (float)(g * a1);
+    c.a3 = (float)(g * g * a1);
+    c.k  = (float)k;
+
+    c.low  = t.filter == Filter::lowpass  ? 1.0f : 0.0f;
+    c.band = t.filter == Filter::bandpass ? (float)k : 0.0f;   // unity gain at the peak
+    c.high = t.filter == Filter::highpass || t.filter == Filter::off ? 1.0f : 0.0f;
+}
+
+void H9VoiceDsp::startVoice(int voice, int pad) noexcept
+{
+    if (!juce::isPositiveAndBelow(voice, maxVoices) || !juce::isPositiveAndBelow(pad, numPads))
+        return;
+
+    const auto v = (size_t)voice;
+    const bool neutral = pads[(size_t)pad].neutral;
+
+    padOf[v]     = pad;
+    level[v]     = neutral ? 1.0f : 0.0f;
+    attacking[v] = neutral ? 0.0f : 1.0f;
+    ic1L[v] = ic2L[v] = ic1R[v] = ic2R[v] = 0.0f;
+}
+
+bool H9VoiceDsp::hasDecayed(int voice) const noexcept
+{
+    const auto v = (size_t)voice;
+    const auto& c = pads[(size_t)padOf[v]];
+    return !c.neutral && c.sustain <= 0.0f && attacking[v] == 0.0f && level[v] < 1.0e-4f;
+}
+
+void H9VoiceDsp::process(const int* voiceList, int numVoices, float* const* channels, bool stereo,
+                         int numSamples, const int* startOffsets, float* peaks) noexcept
+{
+    if (numSamples <= 0)
+        return;
+
+    for (int first = 0; first < numVoices; first += groupLanes)
+    {
+        const int count = juce::jmin(groupLanes, numVoices - first);
+        Group g;
+
+        for (int l = 0; l < groupLanes; ++l)
+        {
+            // Spare lanes run neutral coefficients on silence and are
+            // never stored
+            const int  v = l < count ? voiceList[first + l] : -1;
+            const auto& c = v >= 0 ? pads[(size_t)padOf[(size_t)v]] : pads[0];
+            const auto s = (size_t)juce::jmax(0, v);
+
+            g.attackStep[l] = c.attackStep;
+            g.decay[l]      = c.decay;
+            g.sustain[l]    = c.sustain;
+            g.a1[l] = v >= 0 ? c.a1 : 1.0f;
+            g.a2[l] = v >= 0 ? c.a2 : 0.0f;
+            g.a3[l] = v >= 0 ? c.a3 : 0.0f;
+            g.k[l]  = c.k;
+            g.low[l]  = v >= 0 ? c.low  : 0.0f;
+            g.band[l] = v >= 0 ? c.band : 0.0f;
+            g.high[l] = v >= 0 ? c.high : 1.0f;
+
+            g.start[l]     = v >= 0 ? (float)startOffsets[s] : (float)numSamples;
+            g.level[l]     = v >= 0 ? level[s] : 0.0f;
+            g.attacking[l] = v >= 0 ? attacking[s] : 0.0f;
+            g.ic1L[l] = v >= 0 ? ic1L[s] : 0.0f;
+            g.ic2L[l] = v >= 0 ? ic2L[s] : 0.0f;
+            g.ic1R[l] = v >= 0 ? ic1R[s] : 0.0f;
+            g.ic2R[l] = v >= 0 ? ic2R[s] : 0.0f;
+
+            g.outL[l] = v >= 0 ? channels[2 * v] : nullptr;
+            g.outR[l] = v >= 0 && stereo ? channels[2 * v + 1] : nullptr;
+        }
+
+        // Up to four voices fit one register
+        if (count <= lanes)
+        {
+            if (stereo) processGroup<true, 1>(g, numSamples);
+            else        processGroup<false, 1>(g, numSamples);
+        }
+        else
+        {
+            if (stereo) processGroup<true, 2>(g, numSamples);
+            else        processGroup<false, 2>(g, numSamples);
+        }
+
+        for (int l = 0; l < count; ++l)
+        {
+            const auto s = (size_t)voiceList[first + l];
+            level[s]     = g.level[l];
+            attacking[s] = g.attacking[l];
+            ic1L[s] = g.ic1L[l];
+            ic2L[s] = g.ic2L[l];
+            ic1R[s] = g.ic1R[l];
+            ic2R[s] = g.ic2R[l];
+            peaks[s] = g.peak[l];
+        }
+    }
+}
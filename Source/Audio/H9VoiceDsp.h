@@ -0,0 +1,97 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+
+// ── H9VoiceDsp ──────────────────────────────────────────────────────────────
+// Per-voice amp envelope and state-variable filter, applied in place to the
+// sampler's voice bus after the voices have rendered. Voice state lives in
+// structure-of-arrays form indexed by voice slot; process() packs the
+// voices it is given four to a register (SSE / NEON) and steps their
+// envelopes and filters together, so the cost per voice falls as voices
+// are added until every lane is busy.
+//
+// Envelope: linear attack to 1, then exponential decay towards the sustain
+// level (reaching 1/1000 of the gap after `decayMs`). Filter: TPT / Simper
+// SVF — low, band (unity peak) or high pass; `off` runs the same code with
+// g = 0, which passes the input through unchanged.
+//
+// Tones are set per pad once per block and take effect on every voice of
+// that pad, including ones already sounding. Pads whose tone is neutral
+// (no attack, full sustain, filter off) are skipped by the sampler.
+
+class H9VoiceDsp
+{
+public:
+    static constexpr int lanes     = 4;
+    static constexpr int maxVoices = 16;   // multiple of lanes
+    static constexpr int numPads   = 8;
+
+    enum class Filter { off, lowpass, bandpass, highpass };
+    static constexpr int numFilters = 4;
+
+    struct Tone
+    {
+        float  attackMs  { 0.0f };
+        float  decayMs   { 300.0f };
+        float  sustain   { 1.0f };       // 0 … 1
+        Filter filter    { Filter::off };
+        float  cutoffHz  { 20000.0f };
+        float  resonance { 0.0f };       // 0 … 1
+
+        bool isNeutral() const noexcept
+        {
+            return attackMs <= 0.0f && sustain >= 1.0f && filter == Filter::off;
+        }
+    };
+
+    H9VoiceDsp();
+
+    // Non-RT. Recomputes every pad's coefficients for the new rate.
+    void prepare(double sampleRate);
+
+    // ── Audio thread ────────────────────────────────────────────────────────
+
+    // Snapshots a pad's tone into coefficients; call once per block
+    void setTone(int pad, const Tone&) noexcept;
+    bool isNeutral(int pad) const noexcept { return pads[(size_t)pad].neutral; }
+
+    // Resets `voice`'s state for a new hit on `pad`. A hit on a neutral pad
+    // starts at full level, so an envelope dialled in mid-note can't fade it
+    // back in from silence.
+    void startVoice(int voice, int pad) noexcept;
+
+    // Runs envelope and filter over each listed voice's bus channels —
+    // channels[2 * voice] and, when `stereo`, channels[2 * voice + 1] —
+    // starting at startOffsets[voice] (samples before the hit are left
+    // alone). Writes the largest |sample| of each voice to peaks[voice].
+    void process(const int* voiceList, int numVoices, float* const* channels, bool stereo,
+                 int numSamples, const int* startOffsets, float* peaks) noexcept;
+
+    // True once the envelope has decayed to silence with nothing left to
+    // sustain — the sampler frees the voice
+    bool hasDecayed(int voice) const noexcept;
+
+private:
+    struct Coeffs
+    {
+        float attackStep { 1.0f };
+        float decay      { 0.0f };   // per-sample multiplier of (level - sustain)
+        float sustain    { 1.0f };
+        float a1 { 1.0f }, a2 { 0.0f }, a3 { 0.0f }, k { 2.0f };
+        float low { 0.0f }, band { 0.0f }, high { 1.0f };   // output mix
+        bool  neutral { true };
+    };
+
+    double sampleRate { 44100.0 };
+    std::array<Tone, numPads>   tones {};
+    std::array<Coeffs, numPads> pads {};
+
+    // Per voice slot
+    std::array<int, maxVoices> padOf {};
+    alignas(16) std::array<float, maxVoices> level {};
+    alignas(16) std::array<float, maxVoices> attacking {};   // 1 while in the attack stage
+    alignas(16) std::array<float, maxVoices> ic1L {}, ic2L {}, ic1R {}, ic2R {};
+
+    void updateCoeffs(int pad) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE(H9VoiceDsp)
+};
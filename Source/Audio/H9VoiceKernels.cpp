@@ -0,0 +1,126 @@
+#include "H9VoiceKernels.h"
+#include <cmath>
+
+namespace
+{
+    using namespace H9VoiceKernels;
+
+    constexpr double kaiserBeta = 7.0;
+
+    // Passband (fraction of the source Nyquist) and the highest increment
+    // each band is used for
+    constexpr double bandCutoff[numSincBands]    { 0.9, 0.9 / 1.5, 0.9 / 2.0, 0.9 / 3.0 };
+    constexpr double bandIncrement[numSincBands] { 1.0, 1.5, 2.0 };
+
+    // Zeroth-order modified Bessel function of the first kind
+    double besselI0(double x)
+    {
+        double sum = 1.0, term = 1.0;
+        const double q = x * x * 0.25;
+        for (int k = 1; k < 64; ++k)
+        {
+            term *= q / ((double)k * (double)k);
+            sum += term;
+            if (term < sum * 1.0e-12)
+                break;
+        }
+        return sum;
+    }
+
+    struct SincTables
+    {
+        static constexpr int rowFloats = 2 * sincTaps;
+
+        alignas(16) float data[numSincBands][sincPhases * rowFloats];
+
+        SincTables()
+        {
+            const double i0Beta    = besselI0(kaiserBeta);
+            const double halfWidth = (double)(sincTaps / 2);
+
+            for (int b = 0; b < numSincBands; ++b)
+            {
+                const double cutoff = bandCutoff[b];
+
+                // phases + 1 rows so the last phase has a delta to interpolate to
+                std::vector<double> rows((size_t)((sincPhases + 1) * sincTaps));
+                for (int ph = 0; ph <= sincPhases; ++ph)
+                {
+                    double* row = rows.data() + ph * sincTaps;
+                    double sum = 0.0;
+
+                    for (int k = 0; k < sincTaps; ++k)
+                    {
+                        // Tap k reads frame floor(p) - 7 + k
+                        const double x   = (double)(k - (sincTaps / 2 - 1)) - (double)ph / (double)sincPhases;
+                        const double u   = juce::jlimit(-1.0, 1.0, x / halfWidth);
+                        const double arg = juce::MathConstants<double>::pi * cutoff * x;
+                        const double sinc = x == 0.0 ? 1.0 : std::sin(arg) / arg;
+                        // Kaiser, lowered to reach zero at ±halfWidth: the tap that
+                        // enters at phase 0 and the one leaving at phase 1 are both
+                        // silent, so the response is continuous across frames
+                        const double win  = (besselI0(kaiserBeta * std::sqrt(1.0 - u * u)) - 1.0) / (i0Beta - 1.0);
+
+                        row[k] = cutoff * sinc * win;
+                        sum += row[k];
+                    }
+
+                    // Unity gain at DC in every phase
+                    for (int k = 0; k < sincTaps; ++k)
+                        row[k] /= sum;
+                }
+
+                for (int ph = 0; ph < sincPhases; ++ph)
+                {
+                    const double* row  = rows.data() + ph * sincTaps;
+                    float*        dest = data[b] + ph * rowFloats;
+
+                    for (int k = 0; k < sincTaps; ++k)
+                    {
+                        dest[k]            = (float)row[k];
+                        dest[sincTaps + k] = (float)(row[sincTaps + k] - row[k]);
+                    }
+                }
+            }
+        }
+    };
+
+    const SincTables& tables()
+    {
+        static const SincTables t;
+        return t;
+    }
+}
+
+namespace H9VoiceKernels
+{
+    const char* getInterpName(Interp i)
+    {
+        switch (i)
+        {
+            case Interp::none:   return "None";
+            case Interp::linear: return "Linear";
+            case Interp::cubic:  return "Cubic";
+            case Interp::sinc:   return "Sinc";
+        }
+        return "?";
+    }
+
+    int getSincBand(double increment) noexcept
+    {
+        int band = 0;
+        while (band < numSincBands - 1 && increment > bandIncrement[band])
+            ++band;
+        return band;
+    }
+
+    const float* getSincTable(int band) noexcept
+    {
+        return tables().data[juce::jlimit(0, numSincBands - 1, band)];
+    }
+
+    void prepareTables()
+    {
+        tables();
+    }
+}
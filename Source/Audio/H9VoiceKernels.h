@@ -0,0 +1,250 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#if JUCE_USE_SSE_INTRINSICS
+ #include <emmintrin.h>
+#elif JUCE_USE_ARM_NEON
+ #include <arm_neon.h>
+#endif
+
+// ── H9VoiceKernels ──────────────────────────────────────────────────────────
+// Inner loops of H9PadSampler, specialised at compile time on everything
+// that would otherwise be tested per sample:
+//   Interp        none (unity rate) / linear / cubic Hermite / windowed sinc
+//   StereoSource  false → the right channel reads the left
+//   StereoOut     false → mono bus, L and R folded at -6 dB
+//   Fading        a release ramp is running (gain steps every sample)
+// The sampler picks one kernel per voice segment through get() and sizes
+// `n` so that every frame the kernel touches lies inside the window — the
+// loops carry no bounds checks and no data-dependent branches. Positions
+// are computed as start + i * increment rather than accumulated, so there
+// is no loop-carried dependency besides the fade and the peak.
+//
+// The sinc tier is a 16-tap Kaiser-windowed polyphase filter: 256 phases,
+// linearly interpolated, with the tap products done four at a time in SSE /
+// NEON. Pitching up narrows the passband in four steps (up to 3× rate) so
+// higher notes don't alias.
+
+namespace H9VoiceKernels
+{
+    enum class Interp { none, linear, cubic, sinc };
+    static constexpr int numInterp = 4;
+
+    const char* getInterpName(Interp);
+
+    // Source frames each interpolation reads before / after floor(position)
+    constexpr int getFramesBefore(Interp i) noexcept { return i == Interp::sinc ? 7 : i == Interp::cubic ? 1 : 0; }
+    constexpr int getFramesAfter (Interp i) noexcept { return i == Interp::sinc ? 8 : i == Interp::cubic ? 2 : i == Interp::linear ? 1 : 0; }
+
+    static constexpr int maxFramesBefore = getFramesBefore(Interp::sinc);
+    static constexpr int maxFramesAfter  = getFramesAfter(Interp::sinc);
+
+    // ── Sinc tables ─────────────────────────────────────────────────────────
+
+    static constexpr int sincTaps     = 16;
+    static constexpr int sincPhases   = 256;
+    static constexpr int numSincBands = 4;
+
+    // Per phase: sincTaps coefficients, then sincTaps deltas to the next
+    // phase. 16-byte aligned rows.
+    int getSincBand(double increment) noexcept;
+    const float* getSincTable(int band) noexcept;
+
+    // Builds every table; call once off the audio thread before rendering
+    void prepareTables();
+
+    // ── Kernels ─────────────────────────────────────────────────────────────
+
+    struct Args
+    {
+        const float* left;       // source window; position 0 is left[0]
+        const float* right;      // == left for mono sources
+        double position;         // frames from left[0]
+        double increment;
+        float  gain;
+        float  gainStep;         // subtracted per output sample while fading
+        float* outL;             // first output sample
+        float* outR;             // nullptr on mono buses
+        const float* sinc;       // Interp::sinc only — getSincTable()
+    };
+
+    struct Result
+    {
+        double position;         // where the next call carries on
+        float  gain;
+        float  peak;             // largest |sample| written
+    };
+
+    using Kernel = Result (*)(const Args&, int n) noexcept;
+
+    namespace detail
+    {
+        // Both channels through the same interpolated coefficient set
+        inline void sincTap(const float* sL, const float* sR, const float* row, float frac,
+                            float& l, float& r) noexcept
+        {
+           #if JUCE_USE_SSE_INTRINSICS
+            const __m128 f = _mm_set1_ps(frac);
+            __m128 accL = _mm_setzero_ps(), accR = _mm_setzero_ps();
+            for (int k = 0; k < sincTaps; k += 4)
+            {
+                const __m128 c = _mm_add_ps(_mm_load_ps(row + k), _mm_mul_ps(f, _mm_load_ps(row + sincTaps + k)));
+                accL = _mm_add_ps(accL, _mm_mul_ps(c, _mm_loadu_ps(sL + k)));
+                accR = _mm_add_ps(accR, _mm_mul_ps(c, _mm_loadu_ps(sR + k)));
+            }
+            // Horizontal sums of both accumulators at once
+            const __m128 lo = _mm_unpacklo_ps(accL, accR), hi = _mm_unpackhi_ps(accL, accR);
+            const __m128 s  = _mm_add_ps(lo, hi);                          // l0+l2 r0+r2 l1+l3 r1+r3
+            const __m128 t  = _mm_add_ps(s, _mm_movehl_ps(s, s));          // l     r     …
+            l = _mm_cvtss_f32(t);
+            r = _mm_cvtss_f32(_mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1)));
+           #elif JUCE_USE_ARM_NEON
+            float32x4_t accL = vdupq_n_f32(0.0f), accR = vdupq_n_f32(0.0f);
+            for (int k = 0; k < sincTaps; k += 4)
+            {
+                const float32x4_t c = vmlaq_n_f32(vld1q_f32(row + k), vld1q_f32(row + sincTaps + k), frac);
+                accL = vmlaq_f32(accL, c, vld1q_f32(sL + k));
+                accR = vmlaq_f32(accR, c, vld1q_f32(sR + k));
+            }
+            const float32x2_t sum = vpadd_f32(vadd_f32(vget_low_f32(accL), vget_high_f32(accL)),
+                                              vadd_f32(vget_low_f32(accR), vget_high_f32(accR)));
+            l = vget_lane_f32(sum, 0);
+            r = vget_lane_f32(sum, 1);
+           #else
+            float accL = 0.0f, accR = 0.0f;
+            for (int k = 0; k < sincTaps; ++k)
+            {
+                const float c = row[k] + frac * row[sincTaps + k];
+                accL += c * sL[k];
+                accR += c * sR[k];
+            }
+            l = accL;
+            r = accR;
+           #endif
+        }
+
+        inline float hermite(const float* s, float f) noexcept   // s[-1] … s[2]
+        {
+            const float c1 = 0.5f * (s[1] - s[-1]);
+            const float c2 = s[-1] - 2.5f * s[0] + 2.0f * s[1] - 0.5f * s[2];
+            const float c3 = 0.5f * (s[2] - s[-1]) + 1.5f * (s[0] - s[1]);
+            return ((c3 * f + c2) * f + c1) * f + s[0];
+        }
+    }
+
+    template <Interp I, bool StereoSource, bool StereoOut, bool Fading>
+    Result render(const Args& a, int n) noexcept
+    {
+        const float* const srcL = a.left;
+        const float* const srcR = StereoSource ? a.right : a.left;
+        float* const dstL = a.outL;
+        float* const dstR = a.outR;
+
+        float gain = a.gain;
+        float peak = 0.0f;
+
+        for (int i = 0; i < n; ++i)
+        {
+            float l, r;
+
+            if constexpr (I == Interp::none)
+            {
+                const int at = (int)a.position + i;
+                l = srcL[at];
+                r = StereoSource ? srcR[at] : l;
+            }
+            else
+            {
+                const double p    = a.position + (double)i * a.increment;
+                const int    at   = (int)p;
+                const float  frac = (float)(p - (double)at);
+
+                if constexpr (I == Interp::linear)
+                {
+                    l = srcL[at] + frac * (srcL[at + 1] - srcL[at]);
+                    r = StereoSource ? srcR[at] + frac * (srcR[at + 1] - srcR[at]) : l;
+                }
+                else if constexpr (I == Interp::cubic)
+                {
+                    l = detail::hermite(srcL + at, frac);
+                    r = StereoSource ? detail::hermite(srcR + at, frac) : l;
+                }
+                else
+                {
+                    const float phase = frac * (float)sincPhases;
+                    const int   row   = juce::jmin((int)phase, sincPhases - 1);
+                    const float* first = srcL + at - (sincTaps / 2 - 1);
+
+                    detail::sincTap(first, StereoSource ? srcR + at - (sincTaps / 2 - 1) : first,
+                                    a.sinc + row * 2 * sincTaps, phase - (float)row, l, r);
+                }
+            }
+
+            l *= gain;
+            r *= gain;
+
+            if constexpr (StereoOut)
+            {
+                dstL[i] += l;
+                dstR[i] += r;
+            }
+            else
+            {
+                dstL[i] += 0.5f * (l + r);
+            }
+
+            peak = std::max(peak, std::max(std::abs(l), std::abs(r)));
+
+            if constexpr (Fading)
+                gain -= a.gainStep;
+        }
+
+        const double end = I == Interp::none ? a.position + (double)n
+                                             : a.position + (double)n * a.increment;
+        return { end, gain, peak };
+    }
+
+    // Largest n ≤ maxSamples for which render() reads nothing before frame 0
+    // or past `lastFrame` (relative to Args::left). Uses the same position
+    // arithmetic as the kernels, so the bound is exact.
+    inline int getSafeLength(Interp interp, double position, double increment,
+                             int lastFrame, int maxSamples) noexcept
+    {
+        const int lastStart = lastFrame - getFramesAfter(interp);
+        if (maxSamples <= 0 || (int)position > lastStart || (int)position < getFramesBefore(interp))
+            return 0;
+
+        if (interp == Interp::none)
+            return juce::jmin(maxSamples, lastStart - (int)position + 1);
+
+        int n = (int)juce::jmin((double)maxSamples,
+                                std::ceil(((double)lastStart + 1.0 - position) / increment));
+        // The division can land one either side of the exact count
+        while (n < maxSamples && (int)(position + (double)n * increment) <= lastStart)
+            ++n;
+        while (n > 1 && (int)(position + (double)(n - 1) * increment) > lastStart)
+            --n;
+        return juce::jmax(1, n);
+    }
+
+    namespace detail
+    {
+        template <Interp I>
+        constexpr std::array<Kernel, 8> row() noexcept
+        {
+            return { &render<I, false, false, false>, &render<I, false, false, true>,
+                     &render<I, false, true,  false>, &render<I, false, true,  true>,
+                     &render<I, true,  false, false>, &render<I, true,  false, true>,
+                     &render<I, true,  true,  false>, &render<I, true,  true,  true> };
+        }
+    }
+
+    inline Kernel get(Interp interp, bool stereoSource, bool stereoOut, bool fading) noexcept
+    {
+        static constexpr std::array<std::array<Kernel, 8>, numInterp> table
+            { detail::row<Interp::none>(),  detail::row<Interp::linear>(),
+              detail::row<Interp::cubic>(), detail::row<Interp::sinc>() };
+
+        return table[(size_t)interp][(size_t)((stereoSource ? 4 : 0) | (stereoOut ? 2 : 0) | (fading ? 1 : 0))];
+    }
+}
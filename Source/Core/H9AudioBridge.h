@@ -0,0 +1,123 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include "H9SpscQueue.h"
+
+// ── H9AudioBridge ───────────────────────────────────────────────────────────
+// One-way audio → UI channel. The audio thread never takes a lock here:
+//   • discrete events (note on/off, voice starts) go through a wait-free
+//     SPSC queue and may be dropped if the UI is not draining them
+//   • held notes (per MIDI channel, so a note-off on one channel leaves the
+//     same key held on another) and per-pad peaks are kept as atomic
+//     snapshots, so the UI can always resynchronise even after drops or
+//     while the editor is closed
+// Replaces feeding juce::MidiKeyboardState from processBlock, which shares a
+// CriticalSection with the message thread's MidiKeyboardComponent.
+
+struct H9ActivityEvent
+{
+    enum Type : juce::uint8 { noteOn, noteOff, voiceStart };
+
+    Type        type     { noteOn };
+    juce::uint8 channel  { 1 };
+    juce::uint8 note     { 0 };
+    juce::int8  pad      { -1 };   // pad index for voiceStart, -1 otherwise
+    float       velocity { 0.0f };
+};
+
+class H9AudioBridge
+{
+public:
+    static constexpr int numPads     = 8;
+    static constexpr int numChannels = 16;
+
+    // ── Audio thread ─────────────────────────────────────────────────────────
+
+    void noteOn(int channel, int note, float velocity) noexcept
+    {
+        if (!juce::isPositiveAndBelow(note, 128)) return;
+        if (auto* mask = maskFor(channel, note))
+            mask->fetch_or(bitFor(note), std::memory_order_release);
+        events.push({ H9ActivityEvent::noteOn, (juce::uint8)channel, (juce::uint8)note, -1, velocity });
+    }
+
+    void noteOff(int channel, int note) noexcept
+    {
+        if (!juce::isPositiveAndBelow(note, 128)) return;
+        if (auto* mask = maskFor(channel, note))
+            mask->fetch_and(~bitFor(note), std::memory_order_release);
+        events.push({ H9ActivityEvent::noteOff, (juce::uint8)channel, (juce::uint8)note, -1, 0.0f });
+    }
+
+    // Channel 1–16 clears that channel; anything else clears every channel
+    void allNotesOff(int channel = 0) noexcept
+    {
+        for (int c = 0; c < numChannels; ++c)
+            if (!juce::isPositiveAndBelow(channel - 1, numChannels) || c == channel - 1)
+                for (auto& m : noteMask[(size_t)c])
+                    m.store(0, std::memory_order_release);
+    }
+
+    void voiceStarted(int pad, int note, float velocity) noexcept
+    {
+        if (!juce::isPositiveAndBelow(pad, numPads)) return;
+        events.push({ H9ActivityEvent::voiceStart, 0, (juce::uint8)juce::jlimit(0, 127, note),
+                      (juce::int8)pad, velocity });
+    }
+
+    // Peak-hold: the UI takes and resets it, so short transients between two
+    // UI frames are never lost.
+    void publishPadPeak(int pad, float peak) noexcept
+    {
+        if (!juce::isPositiveAndBelow(pad, numPads)) return;
+        auto& slot = padPeak[(size_t)pad];
+        float prev = slot.load(std::memory_order_relaxed);
+        while (peak > prev && !slot.compare_exchange_weak(prev, peak, std::memory_order_relaxed)) {}
+    }
+
+    // ── Message thread ──────────────────────────────────────────────────────
+
+    template <typename Fn>
+    int drainEvents(Fn&& fn) { return events.drain(std::forward<Fn>(fn)); }
+
+    void discardEvents() noexcept { events.clear(); }
+
+    // Held on any channel
+    bool isNoteOn(int note) const noexcept
+    {
+        return juce::isPositiveAndBelow(note, 128)
+            && (getNoteMask()[(size_t)(note >> 6)] & bitFor(note)) != 0;
+    }
+
+    // Snapshot of all 128 held-note bits, any channel (word 0 = notes 0–63)
+    std::array<juce::uint64, 2> getNoteMask() const noexcept
+    {
+        std::array<juce::uint64, 2> held {};
+        for (auto& channel : noteMask)
+            for (size_t w = 0; w < held.size(); ++w)
+                held[w] |= channel[w].load(std::memory_order_acquire);
+        return held;
+    }
+
+    float takePadPeak(int pad) noexcept
+    {
+        return juce::isPositiveAndBelow(pad, numPads)
+                   ? padPeak[(size_t)pad].exchange(0.0f, std::memory_order_relaxed)
+                   : 0.0f;
+    }
+
+    juce::uint32 getNumDroppedEvents() const noexcept { return events.getNumDropped(); }
+
+private:
+    static juce::uint64 bitFor(int note) noexcept { return (juce::uint64)1 << (note & 63); }
+
+    // nullptr for a channel outside 1–16
+    std::atomic<juce::uint64>* maskFor(int channel, int note) noexcept
+    {
+        return juce::isPositiveAndBelow(channel - 1, numChannels)
+                   ? &noteMask[(size_t)(channel - 1)][(size_t)(note >> 6)] : nullptr;
+    }
+
+    H9SpscQueue<H9ActivityEvent, 256> events;
+    std::array<std::array<std::atomic<juce::uint64>, 2>, numChannels> noteMask {};
+    std::array<std::atomic<float>, numPads>  padPeak  {};
+};
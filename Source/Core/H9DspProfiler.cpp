@@ -0,0 +1,165 @@
+#include "H9DspProfiler.h"
+
+#if defined(_MSC_VER)
+ #include <intrin.h>
+#endif
+
+// ── Stage names ──────────────────────────────────────────────────────────────
+
+const char* H9DspProfiler::getStageName(int stage)
+{
+    static const char* const names[numStages] =
+        { "midi", "voices", "texture", "mix", "loop", "width", "lowpass", "tape", "reverb", "gain", "total" };
+
+    return juce::isPositiveAndBelow(stage, (int)numStages) ? names[stage] : "unknown";
+}
+
+// ── Setup ────────────────────────────────────────────────────────────────────
+
+H9DspProfiler::H9DspProfiler()
+{
+    nsPerTick = 1.0e9 / (double)juce::Time::getHighResolutionTicksPerSecond();
+}
+
+void H9DspProfiler::prepare(double sampleRate, int blockSize)
+{
+    if (sampleRate > 0.0 && blockSize > 0)
+        deadlineUs.store(1.0e6 * (double)blockSize / sampleRate, std::memory_order_relaxed);
+
+    requestReset();
+}
+
+// ── Audio thread ─────────────────────────────────────────────────────────────
+
+void H9DspProfiler::beginBlock() noexcept
+{
+    blockEnabled = enabled.load(std::memory_order_relaxed);
+
+    if (resetRequested.exchange(false, std::memory_order_relaxed))
+    {
+        for (auto& h : stages)
+        {
+            for (auto& b : h.buckets)
+                b.store(0, std::memory_order_relaxed);
+            h.count.store(0, std::memory_order_relaxed);
+            h.totalNs.store(0, std::memory_order_relaxed);
+            h.maxNs.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+int H9DspProfiler::bucketFor(juce::uint64 ns) noexcept
+{
+    if (ns < (1u << subBucketBits))
+        return (int)ns;
+
+   #if defined(_MSC_VER)
+    unsigned long msb = 0;
+    _BitScanReverse64(&msb, ns);
+   #else
+    const int msb = 63 - __builtin_clzll(ns);
+   #endif
+
+    const int sub = (int)(ns >> ((int)msb - subBucketBits)) & ((1 << subBucketBits) - 1);
+    return juce::jmin(numBuckets - 1, ((int)msb << subBucketBits) + sub);
+}
+
+void H9DspProfiler::record(Stage stage, juce::int64 ticks) noexcept
+{
+    const auto ns = (juce::uint64)juce::jmax(0.0, (double)ticks * nsPerTick);
+    auto& h = stages[(size_t)stage];
+
+    // Single writer — plain load/store is enough and avoids locked RMW ops
+    auto& b = h.buckets[(size_t)bucketFor(ns)];
+    b.store(b.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    h.count.store(h.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    h.totalNs.store(h.totalNs.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+
+    if (ns > h.maxNs.load(std::memory_order_relaxed))
+        h.maxNs.store(ns, std::memory_order_relaxed);
+}
+
+// ── Readers ──────────────────────────────────────────────────────────────────
+
+double H9DspProfiler::bucketUpperUs(int bucket) noexcept
+{
+    if (bucket < (1 << subBucketBits))
+        return (double)(bucket + 1) * 1.0e-3;
+
+    const int msb = bucket >> subBucketBits;
+    const int sub = bucket & ((1 << subBucketBits) - 1);
+    const double lower = std::ldexp((double)((1 << subBucketBits) + sub), msb - subBucketBits);
+    const double width = std::ldexp(1.0, msb - subBucketBits);
+    return (lower + width) * 1.0e-3;
+}
+
+double H9DspProfiler::percentileUs(const Histogram& h, double fraction) const
+{
+    std::array<juce::uint32, numBuckets> snapshot;
+    juce::uint64 total = 0;
+    for (int i = 0; i < numBuckets; ++i)
+    {
+        snapshot[(size_t)i] = h.buckets[(size_t)i].load(std::memory_order_relaxed);
+        total += snapshot[(size_t)i];
+    }
+    if (total == 0) return 0.0;
+
+    const auto target = (juce::uint64)std::ceil(fraction * (double)total);
+    juce::uint64 seen = 0;
+    for (int i = 0; i < numBuckets; ++i)
+    {
+        seen += snapshot[(size_t)i];
+        if (seen >= target)
+            return bucketUpperUs(i);
+    }
+    return bucketUpperUs(numBuckets - 1);
+}
+
+H9DspProfiler::StageStats H9DspProfiler::getStats(Stage stage) const
+{
+    auto& h = stages[(size_t)stage];
+
+    StageStats s;
+    s.count = h.count.load(std::memory_order_relaxed);
+    if (s.count == 0) return s;
+
+    s.p50Us  = percentileUs(h, 0.50);
+    s.p99Us  = percentileUs(h, 0.99);
+    s.maxUs  = (double)h.maxNs.load(std::memory_order_relaxed) * 1.0e-3;
+    s.meanUs = (double)h.totalNs.load(std::memory_order_relaxed) * 1.0e-3 / (double)s.count;
+
+    const double deadline = getDeadlineUs();
+    if (deadline > 0.0)
+    {
+        s.p99DeadlineRatio = s.p99Us / deadline;
+        s.maxDeadlineRatio = s.maxUs / deadline;
+    }
+    return s;
+}
+
+juce::String H9DspProfiler::toJson() const
+{
+    auto* root = new juce::DynamicObject();
+    root->setProperty("deadlineUs", getDeadlineUs());
+    root->setProperty("enabled", isEnabled());
+
+    juce::Array<juce::var> stageList;
+    for (int i = 0; i < numStages; ++i)
+    {
+        const auto s = getStats((Stage)i);
+
+        auto* o = new juce::DynamicObject();
+        o->setProperty("stage",            getStageName(i));
+        o->setProperty("count",            (juce::int64)s.count);
+        o->setProperty("p50Us",            s.p50Us);
+        o->setProperty("p99Us",            s.p99Us);
+        o->setProperty("maxUs",            s.maxUs);
+        o->setProperty("meanUs",           s.meanUs);
+        o->setProperty("p99DeadlineRatio", s.p99DeadlineRatio);
+        o->setProperty("maxDeadlineRatio", s.maxDeadlineRatio);
+        stageList.add(juce::var(o));
+    }
+    root->setProperty("stages", stageList);
+
+    return juce::JSON::toString(juce::var(root));
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include <juce_core/juce_core.h>
+
+// ── H9DspProfiler ───────────────────────────────────────────────────────────
+// Per-stage block timing for processBlock. Each stage keeps a log-linear
+// histogram (4 sub-buckets per octave of nanoseconds) written only by the
+// audio thread with relaxed atomics, so recording costs two clock reads and
+// one increment. Readers derive p50 / p99 / max and the ratio against the
+// block deadline (blockSize / sampleRate) at any time.
+
+class H9DspProfiler
+{
+public:
+    enum Stage
+    {
+        midi = 0,
+        voices,
+        texture,    // grain clouds, part of `voices` — CPU time over all voice threads
+        mix,
+        loop,
+        width,
+        lowpass,
+        tape,
+        reverb,
+        gain,
+        total,
+        numStages
+    };
+
+    static const char* getStageName(int stage);
+
+    H9DspProfiler();
+
+    // Deadline = blockSize / sampleRate. Non-RT; call from prepareToPlay.
+    void prepare(double sampleRate, int blockSize);
+
+    void setEnabled(bool shouldBeEnabled) noexcept { enabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const noexcept                { return enabled.load(std::memory_order_relaxed); }
+
+    // Any thread — the audio thread applies it at the next beginBlock()
+    void requestReset() noexcept { resetRequested.store(true, std::memory_order_relaxed); }
+
+    // ── Audio thread ────────────────────────────────────────────────────────
+
+    void beginBlock() noexcept;
+
+    void record(Stage stage, juce::int64 ticks) noexcept;
+
+    class ScopedStage
+    {
+    public:
+        ScopedStage(H9DspProfiler& p, Stage s) noexcept
+            : profiler(p), stage(s),
+              start(p.blockEnabled ? juce::Time::getHighResolutionTicks() : 0) {}
+
+        ~ScopedStage() noexcept
+        {
+            if (profiler.blockEnabled)
+                profiler.record(stage, juce::Time::getHighResolutionTicks() - start);
+        }
+
+    private:
+        H9DspProfiler& profiler;
+        Stage stage;
+        juce::int64 start;
+        JUCE_DECLARE_NON_COPYABLE(ScopedStage)
+    };
+
+    // ── Readers (any thread) ────────────────────────────────────────────────
+
+    struct StageStats
+    {
+        juce::uint64 count { 0 };
+        double p50Us  { 0.0 };
+        double p99Us  { 0.0 };
+        double maxUs  { 0.0 };
+        double meanUs { 0.0 };
+        double p99DeadlineRatio { 0.0 };   // p99 / deadline
+        double maxDeadlineRatio { 0.0 };
+    };
+
+    StageStats getStats(Stage) const;
+    double getDeadlineUs() const noexcept { return deadlineUs.load(std::memory_order_relaxed); }
+
+    juce::String toJson() const;
+
+private:
+    static constexpr int subBucketBits = 2;
+    static constexpr int numBuckets    = 48 << subBucketBits;   // up to ~2^48 ns
+
+    struct Histogram
+    {
+        std::array<std::atomic<juce::uint32>, numBuckets> buckets {};
+        std::atomic<juce::uint64> count   { 0 };
+        std::atomic<juce::uint64> totalNs { 0 };
+        std::atomic<juce::uint64> maxNs   { 0 };
+    };
+
+    std::array<Histogram, numStages> stages;
+
+    std::atomic<bool>   enabled        { true };
+    std::atomic<bool>   resetRequested { false };
+    std::atomic<double> deadlineUs     { 0.0 };
+
+    bool   blockEnabled { false };   // enabled, latched once per block
+    double nsPerTick    { 1.0 };
+
+    static int bucketFor(juce::uint64 ns) noexcept;
+    static double bucketUpperUs(int bucket) noexcept;
+    double percentileUs(const Histogram&, double fraction) const;
+
+    JUCE_DECLARE_NON_COPYABLE(H9DspProfiler)
+};
@@ -0,0 +1,228 @@
+#include "H9JobSystem.h"
+
+#if JUCE_LINUX
+ #include <sys/resource.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+#endif
+
+const char* H9JobSystem::getPriorityName(Priority p)
+{
+    static const char* const names[numPriorities] = { "user", "background" };
+    return names[(int)p];
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  Worker thread
+// ═══════════════════════════════════════════════════════════════════════════════
+
+class H9JobSystem::Worker : private juce::Thread
+{
+public:
+    Worker(H9JobSystem& o, H9JobSystem::Priority p, int threadIndex)
+        : juce::Thread(juce::String("HALO9 ") + getPriorityName(p) + " job " + juce::String(threadIndex)),
+          owner(o), priority(p)
+    {
+        startThread(p == H9JobSystem::Priority::user ? juce::Thread::Priority::normal
+                                                     : juce::Thread::Priority::background);
+    }
+
+    ~Worker() override
+    {
+        // The owner has already set `stopping` and woken the queue
+        stopThread(10000);
+    }
+
+private:
+    H9JobSystem& owner;
+    const H9JobSystem::Priority priority;   // juce::Thread has its own Priority
+
+    void run() override
+    {
+       #if JUCE_LINUX
+        // JUCE leaves non-realtime threads at the default nice level on
+        // Linux, where the per-thread nice value is what the scheduler
+        // actually weighs. An unprivileged thread can't raise it back, which
+        // is why background work has a thread of its own.
+        if (priority == H9JobSystem::Priority::background)
+            setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), 10);
+       #endif
+
+        owner.serve(priority);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(Worker)
+};
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  Job system
+// ═══════════════════════════════════════════════════════════════════════════════
+
+H9JobSystem::H9JobSystem()
+{
+    msPerTick = 1000.0 / (double)juce::Time::getHighResolutionTicksPerSecond();
+
+    // One core is the host's audio thread; leave it alone where we can
+    const int numUserThreads = juce::jlimit(1, 3, juce::SystemStats::getNumCpus() - 2);
+    const int counts[numPriorities] = { numUserThreads, 1 };
+
+    const auto now = juce::Time::getHighResolutionTicks();
+    for (int p = 0; p < numPriorities; ++p)
+    {
+        queues[(size_t)p].statsSince = now;
+        for (int i = 0; i < counts[p]; ++i)
+            queues[(size_t)p].workers.push_back(std::make_unique<Worker>(*this, (Priority)p, i));
+    }
+}
+
+H9JobSystem::~H9JobSystem()
+{
+    stopping.store(true);
+
+    for (auto& q : queues)
+    {
+        {
+            std::lock_guard<std::mutex> sl(q.lock);
+            for (auto& e : q.entries)
+                e.token.cancel();
+            for (auto& r : q.running)
+                r.token.cancel();
+            q.entries.clear();
+        }
+        q.wake.notify_all();
+    }
+
+    for (auto& q : queues)
+        q.workers.clear();
+}
+
+void H9JobSystem::submit(Priority p, const char* name, H9JobToken token, Work work)
+{
+    if (token.isCancelled() || stopping.load())
+        return;
+
+    auto& q = queues[(size_t)p];
+    {
+        std::lock_guard<std::mutex> sl(q.lock);
+        q.entries.push_back({ name, std::move(token), std::move(work), juce::Time::getHighResolutionTicks() });
+        q.maxQueued = juce::jmax(q.maxQueued, (int)q.entries.size());
+    }
+    q.wake.notify_one();
+}
+
+void H9JobSystem::cancelAndWait(H9JobToken token)
+{
+    token.cancel();
+
+    for (auto& q : queues)
+    {
+        std::unique_lock<std::mutex> sl(q.lock);
+
+        const auto before = q.entries.size();
+        q.entries.erase(std::remove_if(q.entries.begin(), q.entries.end(),
+                                       [&](const Entry& e) { return e.token == token; }),
+                        q.entries.end());
+        q.cancelled += (juce::int64)(before - q.entries.size());
+
+        q.idle.wait(sl, [&] { return !q.isRunning(token); });
+    }
+}
+
+bool H9JobSystem::Queue::isRunning(const H9JobToken& token) const
+{
+    return std::any_of(running.begin(), running.end(),
+                       [&](const Running& r) { return r.token == token; });
+}
+
+void H9JobSystem::serve(Priority p)
+{
+    auto& q = queues[(size_t)p];
+    std::unique_lock<std::mutex> sl(q.lock);
+
+    for (;;)
+    {
+        q.wake.wait(sl, [&] { return stopping.load() || !q.entries.empty(); });
+        if (stopping.load())
+            return;
+
+        auto entry = std::move(q.entries.front());
+        q.entries.pop_front();
+
+        // Stale — a newer request has replaced it
+        if (entry.token.isCancelled())
+        {
+            ++q.cancelled;
+            continue;
+        }
+
+        const auto started = juce::Time::getHighResolutionTicks();
+        const double waitMs = (double)(started - entry.submitted) * msPerTick;
+        q.totalWaitMs += waitMs;
+        q.maxWaitMs    = juce::jmax(q.maxWaitMs, waitMs);
+        q.running.push_back({ entry.token, started });
+
+        sl.unlock();
+        entry.work(entry.token);
+        entry.work = nullptr;   // release captures off the lock
+        sl.lock();
+
+        // Tokens may be shared by several jobs; this worker's is the one
+        // with its start time
+        q.running.erase(std::find_if(q.running.begin(), q.running.end(), [&](const Queue::Running& r)
+                                     { return r.token == entry.token && r.started == started; }));
+        q.busyMs += (double)(juce::Time::getHighResolutionTicks() - juce::jmax(started, q.statsSince)) * msPerTick;
+        ++q.completed;
+        q.idle.notify_all();
+    }
+}
+
+// ── Stats ────────────────────────────────────────────────────────────────────
+
+H9JobSystem::Stats H9JobSystem::getStats(Priority p) const
+{
+    const auto& q = queues[(size_t)p];
+    std::lock_guard<std::mutex> sl(q.lock);
+
+    Stats s;
+    s.threads   = (int)q.workers.size();
+    s.busy      = (int)q.running.size();
+    s.queued    = (int)q.entries.size();
+    s.maxQueued = q.maxQueued;
+    s.completed = q.completed;
+    s.cancelled = q.cancelled;
+    s.maxWaitMs = q.maxWaitMs;
+
+    // Every job that started has had its wait counted, including the ones
+    // still running
+    const auto started = q.completed + (juce::int64)q.running.size();
+    s.meanWaitMs = started > 0 ? q.totalWaitMs / (double)started : 0.0;
+
+    // Jobs still running count up to now, so a long one shows as busy
+    // while it runs rather than all at once when it ends
+    const auto now = juce::Time::getHighResolutionTicks();
+    double busyMs = q.busyMs;
+    for (auto& r : q.running)
+        busyMs += (double)(now - juce::jmax(r.started, q.statsSince)) * msPerTick;
+
+    const double windowMs = (double)(now - q.statsSince) * msPerTick;
+    s.saturation = windowMs > 0.0 && s.threads > 0
+                 ? juce::jlimit(0.0, 1.0, busyMs / (windowMs * s.threads)) : 0.0;
+    return s;
+}
+
+void H9JobSystem::resetStats()
+{
+    const auto now = juce::Time::getHighResolutionTicks();
+
+    for (auto& q : queues)
+    {
+        std::lock_guard<std::mutex> sl(q.lock);
+        q.maxQueued   = (int)q.entries.size();
+        q.completed   = 0;
+        q.cancelled   = 0;
+        q.totalWaitMs = 0.0;
+        q.maxWaitMs   = 0.0;
+        q.busyMs      = 0.0;
+        q.statsSince  = now;
+    }
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+// ── H9JobToken ──────────────────────────────────────────────────────────────
+// Cancellation flag shared by every job submitted with it. Cancelling drops
+// the jobs still queued and tells running ones (which poll isCancelled()) to
+// stop. Cheap to copy; copies refer to the same flag.
+
+class H9JobToken
+{
+public:
+    H9JobToken() : state(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void cancel() noexcept            { state->store(true, std::memory_order_release); }
+    bool isCancelled() const noexcept { return state->load(std::memory_order_acquire); }
+
+    bool operator==(const H9JobToken& other) const noexcept { return state == other.state; }
+
+private:
+    std::shared_ptr<std::atomic<bool>> state;
+};
+
+// ── H9JobSystem ─────────────────────────────────────────────────────────────
+// The one set of background threads for the whole process, shared by every
+// plugin instance through SharedResourcePointer. Thread count is fixed,
+// however many instances a session holds. Two priority classes, each with
+// its own threads so a long background job never delays a user one:
+//   user         1–3 threads — kit loads and anything the user is waiting on
+//   background   1 thread, lowest priority (nice 10 on Linux) — cache
+//                pruning, analysis, thumbnails
+// Jobs within a class run in submission order. Stats per class (busy
+// threads, queue depth, queue latency, saturation) can be read from any
+// thread.
+//
+// Every job must finish. A service loop submitted as a job would hold one
+// of its class's threads for good (the whole class, for background) and
+// starve every job queued behind it; loops that live as long as their
+// owner run on a thread of their own, as H9DiskIoScheduler's does.
+
+class H9JobSystem
+{
+public:
+    enum class Priority { user = 0, background };
+    static constexpr int numPriorities = 2;
+
+    static const char* getPriorityName(Priority);
+
+    using Work = std::function<void(const H9JobToken&)>;
+
+    H9JobSystem();
+    ~H9JobSystem();
+
+    // Any thread. `work` runs unless `token` is cancelled first; it should
+    // poll the token it is given and return early once cancelled.
+    void submit(Priority, const char* name, H9JobToken token, Work work);
+    void submit(Priority p, const char* name, Work work) { submit(p, name, H9JobToken(), std::move(work)); }
+
+    // Cancels `token` and blocks until no job holding it is running.
+    // Don't call from a job on the same token.
+    void cancelAndWait(H9JobToken token);
+
+    struct Stats
+    {
+        int         threads   { 0 };
+        int         busy      { 0 };
+        int         queued    { 0 };
+        int         maxQueued { 0 };
+        juce::int64 completed { 0 };
+        juce::int64 cancelled { 0 };   // dropped before they ran
+        double      meanWaitMs { 0.0 };   // submit → start
+        double      maxWaitMs  { 0.0 };
+        double      saturation { 0.0 };   // busy thread-time / available, since the last reset
+    };
+
+    Stats getStats(Priority) const;
+    void  resetStats();
+
+private:
+    class Worker;
+
+    struct Entry
+    {
+        const char* name;
+        H9JobToken  token;
+        Work        work;
+        juce::int64 submitted;   // high-resolution ticks
+    };
+
+    struct Queue
+    {
+        mutable std::mutex lock;
+        std::condition_variable wake;   // work queued, or stopping
+        std::condition_variable idle;   // a job ended — for cancelAndWait
+        std::deque<Entry> entries;
+
+        struct Running
+        {
+            H9JobToken  token;
+            juce::int64 started;   // high-resolution ticks
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::vector<Running> running;   // one per busy worker, under `lock`
+
+        int         maxQueued { 0 };
+        juce::int64 completed { 0 }, cancelled { 0 };
+        double      totalWaitMs { 0.0 }, maxWaitMs { 0.0 };
+        double      busyMs { 0.0 };   // jobs that ended since statsSince
+        juce::int64 statsSince { 0 };
+
+        bool isRunning(const H9JobToken&) const;
+    };
+
+    std::array<Queue, numPriorities> queues;
+    std::atomic<bool> stopping { false };
+    double msPerTick { 0.0 };
+
+    void serve(Priority);
+
+    JUCE_DECLARE_NON_COPYABLE(H9JobSystem)
+};
@@ -0,0 +1,97 @@
+#include "H9LoadGuard.h"
+#include <cmath>
+
+const char* H9LoadGuard::getTierName(int t)
+{
+    static const char* const names[numTiers] = { "full", "reverb", "interp", "voices" };
+    return juce::isPositiveAndBelow(t, (int)numTiers) ? names[t] : "unknown";
+}
+
+H9LoadGuard::H9LoadGuard()
+{
+    nsPerTick = 1.0e9 / (double)juce::Time::getHighResolutionTicksPerSecond();
+}
+
+void H9LoadGuard::prepare(double newSampleRate, int /*blockSize*/)
+{
+    sampleRate   = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+    smoothed     = 0.0;
+    sinceChange  = 0.0;
+    underFor     = 0.0;
+    recoverAfter = recoverSeconds;
+    justRecovered = false;
+
+    tier.store(full, std::memory_order_relaxed);
+    load.store(0.0, std::memory_order_relaxed);
+}
+
+// ── Audio thread ─────────────────────────────────────────────────────────────
+
+H9LoadGuard::Tier H9LoadGuard::beginBlock(bool isRealtime) noexcept
+{
+    timing = isRealtime && enabled.load(std::memory_order_relaxed);
+
+    if (!timing)
+    {
+        if (tier.load(std::memory_order_relaxed) != full)
+            setTier(full);
+        return full;
+    }
+
+    blockStart = juce::Time::getHighResolutionTicks();
+    return getTier();
+}
+
+void H9LoadGuard::endBlock(int numSamples) noexcept
+{
+    if (!timing || numSamples <= 0)
+        return;
+
+    const double blockSeconds = (double)numSamples / sampleRate;
+    const double elapsedNs    = (double)(juce::Time::getHighResolutionTicks() - blockStart) * nsPerTick;
+    const double blockLoad    = elapsedNs * 1.0e-9 / blockSeconds;
+
+    // Rise within a couple of blocks, fall over ~100 ms
+    const double release = 1.0 - std::exp(-blockSeconds / 0.1);
+    smoothed += (blockLoad - smoothed) * (blockLoad > smoothed ? 0.5 : release);
+    load.store(smoothed, std::memory_order_relaxed);
+
+    sinceChange += blockSeconds;
+    const int current = tier.load(std::memory_order_relaxed);
+
+    // A block past its deadline has already been heard — act at once
+    const bool overloaded = smoothed > stepDownLoad || blockLoad > 1.0;
+
+    if (overloaded && current < numTiers - 1 && sinceChange >= holdSeconds)
+    {
+        // Straight back into overload after a recovery: wait longer next time
+        if (justRecovered && sinceChange < recoverAfter)
+            recoverAfter = juce::jmin(maxRecoverSeconds, recoverAfter * 2.0);
+
+        setTier(current + 1);
+        stepDowns.store(stepDowns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        justRecovered = false;
+        return;
+    }
+
+    underFor = smoothed < stepUpLoad ? underFor + blockSeconds : 0.0;
+
+    if (current > full && underFor >= recoverAfter)
+    {
+        setTier(current - 1);
+        justRecovered = true;
+    }
+    else if (justRecovered && sinceChange >= recoverAfter)
+    {
+        // Held up for a whole recovery period — back to the normal pace
+        justRecovered = false;
+        recoverAfter  = recoverSeconds;
+    }
+}
+
+void H9LoadGuard::setTier(int newTier) noexcept
+{
+    tier.store(newTier, std::memory_order_relaxed);
+    sinceChange = 0.0;
+    underFor    = 0.0;
+}
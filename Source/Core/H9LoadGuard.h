@@ -0,0 +1,77 @@
+#pragma once
+#include <juce_core/juce_core.h>
+
+// ── H9LoadGuard ─────────────────────────────────────────────────────────────
+// Times every processBlock against its deadline (numSamples / sampleRate)
+// and trades fidelity for headroom before the host drops out. The load is
+// smoothed with a fast attack and a slow release; above stepDownLoad the
+// guard moves one tier down, waits holdSeconds for the saving to show, and
+// steps again if it is still too high. It climbs back one tier at a time
+// after the load has stayed under stepUpLoad for recoverSeconds — doubled
+// each time a recovery immediately overloads again, so a session sitting on
+// the edge doesn't flap between tiers.
+//
+// The guard only decides; the processor applies the tier at the top of the
+// next block. Offline rendering has no deadline and always runs at full.
+
+class H9LoadGuard
+{
+public:
+    enum Tier
+    {
+        full = 0,
+        cheapReverb,    // reverb down to 4 delay lines, tape to 2× oversampling
+        lowerInterp,    // realtime interpolation one tier down
+        fewerVoices,    // voice limit halved
+        numTiers
+    };
+
+    static const char* getTierName(int tier);
+
+    static constexpr double stepDownLoad   = 0.80;   // smoothed fraction of the deadline
+    static constexpr double stepUpLoad     = 0.50;
+    static constexpr double holdSeconds    = 0.25;
+    static constexpr double recoverSeconds = 2.0;
+    static constexpr double maxRecoverSeconds = 16.0;
+
+    H9LoadGuard();
+
+    // Non-RT; call from prepareToPlay. Returns to full quality.
+    void prepare(double sampleRate, int blockSize);
+
+    void setEnabled(bool shouldBeEnabled) noexcept { enabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const noexcept                { return enabled.load(std::memory_order_relaxed); }
+
+    // ── Audio thread ────────────────────────────────────────────────────────
+
+    // Returns the tier to render this block at
+    Tier beginBlock(bool isRealtime) noexcept;
+    void endBlock(int numSamples) noexcept;
+
+    // ── Readers (any thread) ────────────────────────────────────────────────
+
+    Tier   getTier() const noexcept     { return (Tier)tier.load(std::memory_order_relaxed); }
+    double getLoad() const noexcept     { return load.load(std::memory_order_relaxed); }   // smoothed
+    juce::int64 getNumStepDowns() const noexcept { return stepDowns.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool>        enabled   { true };
+    std::atomic<int>         tier      { full };
+    std::atomic<double>      load      { 0.0 };
+    std::atomic<juce::int64> stepDowns { 0 };
+
+    // Audio thread only
+    double sampleRate { 44100.0 };
+    double nsPerTick  { 1.0 };
+    double smoothed   { 0.0 };
+    juce::int64 blockStart { 0 };
+    bool   timing      { false };
+    double sinceChange { 0.0 };   // seconds since the last tier change
+    double underFor    { 0.0 };   // seconds continuously under stepUpLoad
+    double recoverAfter { recoverSeconds };
+    bool   justRecovered { false };
+
+    void setTier(int newTier) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE(H9LoadGuard)
+};
@@ -0,0 +1,87 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include "H9SpscQueue.h"
+
+// ── H9ObjectHandoff ─────────────────────────────────────────────────────────
+// Publishes heap objects (sample sets, tables, IRs…) from a non-real-time
+// thread to the audio thread without locks and without freeing on the audio
+// thread:
+//   publish()        non-RT: offers a new object; an offer the audio thread
+//                    never picked up is deleted immediately
+//   acquire()        audio:  adopts the newest offer, retiring the old one
+//   collectGarbage() non-RT: deletes retired objects
+// Exactly one publishing thread and one audio thread.
+
+template <typename T>
+class H9ObjectHandoff
+{
+public:
+    H9ObjectHandoff() = default;
+
+    ~H9ObjectHandoff()
+    {
+        delete pending.exchange(nullptr);
+        delete current;
+        collectGarbage();
+    }
+
+    // ── Publishing thread ───────────────────────────────────────────────────
+
+    void publish(std::unique_ptr<T> next)
+    {
+        if (auto* stale = pending.exchange(next.release(), std::memory_order_acq_rel))
+            delete stale;   // never seen by the audio thread
+
+        collectGarbage();
+    }
+
+    void collectGarbage()
+    {
+        T* old = nullptr;
+        while (retired.pop(old))
+            delete old;
+    }
+
+    // ── Audio thread ────────────────────────────────────────────────────────
+
+    // Returns the object to use for this block. `changed` is set when a new
+    // object was adopted (so callers can reset state that referred to the old).
+    T* acquire(bool& changed) noexcept
+    {
+        return acquire(changed, [] {});
+    }
+
+    // As above; `beforeRetire` runs just before the old object becomes
+    // deletable, so anything else still pointing into it can be detached
+    template <typename Callback>
+    T* acquire(bool& changed, Callback&& beforeRetire) noexcept
+    {
+        changed = false;
+
+        // Only adopt when the retired queue can take the old object —
+        // otherwise keep using it and try again next block
+        if (retired.getFreeSpace() > 0)
+        {
+            if (auto* next = pending.exchange(nullptr, std::memory_order_acq_rel))
+            {
+                if (current != nullptr)
+                {
+                    beforeRetire();
+                    retired.push(current);
+                }
+                current = next;
+                changed = true;
+            }
+        }
+        return current;
+    }
+
+    T* get() const noexcept { return current; }   // audio thread
+
+private:
+    std::atomic<T*> pending { nullptr };
+    T* current { nullptr };
+    H9SpscQueue<T*, 16> retired;
+
+    JUCE_DECLARE_NON_COPYABLE(H9ObjectHandoff)
+};
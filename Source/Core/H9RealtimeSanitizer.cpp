@@ -0,0 +1,454 @@
+#include "H9RealtimeSanitizer.h"
+
+#if HALO9_RT_SANITIZER
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if JUCE_LINUX || JUCE_MAC
+ #include <execinfo.h>
+ #include <unistd.h>
+#endif
+
+#if JUCE_WINDOWS
+ #include <malloc.h>
+#endif
+
+#if JUCE_LINUX
+ #include <dlfcn.h>
+ #include <fcntl.h>
+ #include <pthread.h>
+ #include <semaphore.h>
+ #include <stdarg.h>
+ #include <time.h>
+#endif
+
+// JUCE builds with -fvisibility=hidden, and a hidden definition is never
+// bound by the dynamic linker: libc, libstdc++ and JUCE would keep calling
+// the real functions. Every interposer is exported explicitly.
+#if defined(__GNUC__)
+ #define H9_RT_EXPORT __attribute__((visibility("default")))
+#else
+ #define H9_RT_EXPORT
+#endif
+
+// initial-exec TLS never allocates on first access, which matters because
+// these are read from inside the malloc interposers
+#if defined(__GNUC__) && !defined(_WIN32)
+ #define H9_RT_TLS __thread __attribute__((tls_model("initial-exec")))
+#else
+ #define H9_RT_TLS thread_local
+#endif
+
+namespace
+{
+    H9_RT_TLS int realtimeDepth = 0;
+    H9_RT_TLS int allowDepth    = 0;
+    H9_RT_TLS int inReport      = 0;
+
+    constexpr int maxRecords = 64;
+    constexpr int maxFrames  = 32;
+
+    struct Record
+    {
+        H9RealtimeSanitizer::Violation kind;
+        const char* what;
+        void* frames[maxFrames];
+        int   numFrames;
+    };
+
+    Record records[maxRecords];
+    std::atomic<int> numViolations { 0 };
+
+    const char* kindName(H9RealtimeSanitizer::Violation v)
+    {
+        switch (v)
+        {
+            case H9RealtimeSanitizer::Violation::allocation:   return "allocation";
+            case H9RealtimeSanitizer::Violation::deallocation: return "deallocation";
+            case H9RealtimeSanitizer::Violation::lock:         return "lock";
+            case H9RealtimeSanitizer::Violation::wait:         return "blocking wait";
+            case H9RealtimeSanitizer::Violation::fileIo:       return "file I/O";
+        }
+        return "unknown";
+    }
+
+    inline bool shouldReport() noexcept
+    {
+        return realtimeDepth > 0 && allowDepth == 0 && inReport == 0;
+    }
+
+    // Prints the report and fails the process at exit if anything was caught
+    struct ExitReporter
+    {
+        ExitReporter()
+        {
+           #if JUCE_LINUX || JUCE_MAC
+            // First backtrace() call loads libgcc_s and allocates — do it now
+            void* warmup[2];
+            backtrace(warmup, 2);
+           #endif
+        }
+
+        ~ExitReporter()
+        {
+            if (numViolations.load() == 0) return;
+
+            H9RealtimeSanitizer::printReport();
+
+            const char* fatal = std::getenv("HALO9_RT_SANITIZER_FATAL");
+            if (fatal == nullptr || std::strcmp(fatal, "0") != 0)
+                std::_Exit(1);
+        }
+    };
+
+    ExitReporter exitReporter;
+}
+
+namespace H9RealtimeSanitizer
+{
+    ScopedRealtime::ScopedRealtime() noexcept  { ++realtimeDepth; }
+    ScopedRealtime::~ScopedRealtime() noexcept { --realtimeDepth; }
+
+    ScopedAllow::ScopedAllow() noexcept  { ++allowDepth; }
+    ScopedAllow::~ScopedAllow() noexcept { --allowDepth; }
+
+    void report(Violation kind, const char* what) noexcept
+    {
+        if (!shouldReport()) return;
+
+        ++inReport;
+        const int index = numViolations.fetch_add(1);
+        if (index < maxRecords)
+        {
+            auto& r = records[index];
+            r.kind = kind;
+            r.what = what;
+           #if JUCE_LINUX || JUCE_MAC
+            r.numFrames = backtrace(r.frames, maxFrames);
+           #else
+            r.numFrames = 0;
+           #endif
+        }
+        --inReport;
+    }
+
+    int getNumViolations() noexcept { return numViolations.load(); }
+
+    void reset() noexcept { numViolations.store(0); }
+
+    void printReport() noexcept
+    {
+        ++inReport;
+        const int total = numViolations.load();
+        std::fprintf(stderr, "\n=== HALO9 real-time sanitizer: %d violation(s) on the audio thread ===\n",
+                     total);
+
+        for (int i = 0; i < juce::jmin(total, maxRecords); ++i)
+        {
+            auto& r = records[i];
+            std::fprintf(stderr, "\n#%d %s: %s\n", i + 1, kindName(r.kind), r.what);
+            std::fflush(stderr);
+           #if JUCE_LINUX || JUCE_MAC
+            backtrace_symbols_fd(r.frames, r.numFrames, STDERR_FILENO);
+           #endif
+        }
+
+        if (total > maxRecords)
+            std::fprintf(stderr, "\n… %d more not recorded\n", total - maxRecords);
+        --inReport;
+    }
+}
+
+using H9RealtimeSanitizer::Violation;
+using H9RealtimeSanitizer::report;
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  Linux — libc symbol interposition
+// ═══════════════════════════════════════════════════════════════════════════════
+
+#if JUCE_LINUX
+
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void* __libc_memalign(size_t, size_t);
+    void  __libc_free(void*);
+
+    H9_RT_EXPORT void* malloc(size_t size)
+    {
+        report(Violation::allocation, "malloc");
+        return __libc_malloc(size);
+    }
+
+    H9_RT_EXPORT void* calloc(size_t n, size_t size)
+    {
+        report(Violation::allocation, "calloc");
+        return __libc_calloc(n, size);
+    }
+
+    H9_RT_EXPORT void* realloc(void* p, size_t size)
+    {
+        report(Violation::allocation, "realloc");
+        return __libc_realloc(p, size);
+    }
+
+    H9_RT_EXPORT void* memalign(size_t alignment, size_t size)
+    {
+        report(Violation::allocation, "memalign");
+        return __libc_memalign(alignment, size);
+    }
+
+    H9_RT_EXPORT void* aligned_alloc(size_t alignment, size_t size)
+    {
+        report(Violation::allocation, "aligned_alloc");
+        return __libc_memalign(alignment, size);
+    }
+
+    H9_RT_EXPORT int posix_memalign(void** out, size_t alignment, size_t size)
+    {
+        report(Violation::allocation, "posix_memalign");
+        *out = __libc_memalign(alignment, size);
+        return *out != nullptr ? 0 : ENOMEM;
+    }
+
+    H9_RT_EXPORT void free(void* p)
+    {
+        if (p != nullptr)
+            report(Violation::deallocation, "free");
+        __libc_free(p);
+    }
+}
+
+// Functions without a __libc_ alias are resolved once at load time.
+// (dlsym takes the loader's internal lock, not pthread_mutex_lock, so
+// resolving from inside an interposer cannot recurse.)
+namespace
+{
+    template <typename Fn>
+    Fn resolveNext(const char* name)
+    {
+        return reinterpret_cast<Fn>(dlsym(RTLD_NEXT, name));
+    }
+
+    using MutexLockFn = int (*)(pthread_mutex_t*);
+    using OpenFn      = int (*)(const char*, int, ...);
+    using FopenFn     = FILE* (*)(const char*, const char*);
+    using ReadFn      = ssize_t (*)(int, void*, size_t);
+    using WriteFn     = ssize_t (*)(int, const void*, size_t);
+    using CloseFn     = int (*)(int);
+    using CondWaitFn  = int (*)(pthread_cond_t*, pthread_mutex_t*);
+    using SemWaitFn   = int (*)(sem_t*);
+    using NanosleepFn = int (*)(const struct timespec*, struct timespec*);
+    using UsleepFn    = int (*)(useconds_t);
+
+    struct Real
+    {
+        MutexLockFn mutexLock = nullptr;
+        OpenFn      open      = nullptr;
+        OpenFn      open64    = nullptr;
+        FopenFn     fopen     = nullptr;
+        ReadFn      read      = nullptr;
+        WriteFn     write     = nullptr;
+        CloseFn     close     = nullptr;
+        CondWaitFn  condWait  = nullptr;
+        SemWaitFn   semWait   = nullptr;
+        NanosleepFn nanosleep = nullptr;
+        UsleepFn    usleep    = nullptr;
+    };
+
+    Real real;
+    std::atomic<bool> resolved { false };
+
+    void resolveRealFunctions()
+    {
+        real.mutexLock = resolveNext<MutexLockFn>("pthread_mutex_lock");
+        real.open      = resolveNext<OpenFn>     ("open");
+        real.open64    = resolveNext<OpenFn>     ("open64");
+        real.fopen     = resolveNext<FopenFn>    ("fopen");
+        real.read      = resolveNext<ReadFn>     ("read");
+        real.write     = resolveNext<WriteFn>    ("write");
+        real.close     = resolveNext<CloseFn>    ("close");
+        real.condWait  = resolveNext<CondWaitFn> ("pthread_cond_wait");
+        real.semWait   = resolveNext<SemWaitFn>  ("sem_wait");
+        real.nanosleep = resolveNext<NanosleepFn>("nanosleep");
+        real.usleep    = resolveNext<UsleepFn>   ("usleep");
+        resolved.store(true);
+    }
+
+    __attribute__((constructor(101))) void resolveAtLoad() { resolveRealFunctions(); }
+
+    // In case another library's constructor does I/O before ours has run
+    inline const Real& getReal()
+    {
+        if (!resolved.load(std::memory_order_acquire))
+            resolveRealFunctions();
+        return real;
+    }
+}
+
+extern "C"
+{
+    H9_RT_EXPORT int pthread_mutex_lock(pthread_mutex_t* m)
+    {
+        report(Violation::lock, "pthread_mutex_lock");
+        return getReal().mutexLock(m);
+    }
+
+    H9_RT_EXPORT int open(const char* path, int flags, ...)
+    {
+        report(Violation::fileIo, "open");
+        mode_t mode = 0;
+        if ((flags & O_CREAT) != 0)
+        {
+            va_list args;
+            va_start(args, flags);
+            mode = (mode_t)va_arg(args, int);
+            va_end(args);
+        }
+        return getReal().open(path, flags, mode);
+    }
+
+    H9_RT_EXPORT int open64(const char* path, int flags, ...)
+    {
+        report(Violation::fileIo, "open64");
+        mode_t mode = 0;
+        if ((flags & O_CREAT) != 0)
+        {
+            va_list args;
+            va_start(args, flags);
+            mode = (mode_t)va_arg(args, int);
+            va_end(args);
+        }
+        return getReal().open64(path, flags, mode);
+    }
+
+    H9_RT_EXPORT FILE* fopen(const char* path, const char* mode)
+    {
+        report(Violation::fileIo, "fopen");
+        return getReal().fopen(path, mode);
+    }
+
+    H9_RT_EXPORT ssize_t read(int fd, void* buf, size_t n)
+    {
+        report(Violation::fileIo, "read");
+        return getReal().read(fd, buf, n);
+    }
+
+    H9_RT_EXPORT ssize_t write(int fd, const void* buf, size_t n)
+    {
+        report(Violation::fileIo, "write");
+        return getReal().write(fd, buf, n);
+    }
+
+    H9_RT_EXPORT int close(int fd)
+    {
+        report(Violation::fileIo, "close");
+        return getReal().close(fd);
+    }
+
+    H9_RT_EXPORT int pthread_cond_wait(pthread_cond_t* c, pthread_mutex_t* m)
+    {
+        report(Violation::wait, "pthread_cond_wait");
+        return getReal().condWait(c, m);
+    }
+
+    H9_RT_EXPORT int sem_wait(sem_t* s)
+    {
+        report(Violation::wait, "sem_wait");
+        return getReal().semWait(s);
+    }
+
+    H9_RT_EXPORT int nanosleep(const struct timespec* req, struct timespec* rem)
+    {
+        report(Violation::wait, "nanosleep");
+        return getReal().nanosleep(req, rem);
+    }
+
+    H9_RT_EXPORT int usleep(useconds_t us)
+    {
+        report(Violation::wait, "usleep");
+        return getReal().usleep(us);
+    }
+}
+
+#endif // JUCE_LINUX
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  operator new / delete — every platform
+// ═══════════════════════════════════════════════════════════════════════════════
+// On Linux these take memory straight from __libc_* so one allocation is
+// reported once, as operator new, and not again by the malloc interposer.
+
+namespace
+{
+   #if JUCE_LINUX
+    inline void* rawAlloc(size_t n) noexcept                  { return __libc_malloc(n); }
+    inline void  rawFree(void* p) noexcept                    { __libc_free(p); }
+    inline void* rawAlignedAlloc(size_t a, size_t n) noexcept { return __libc_memalign(a, n); }
+    inline void  rawAlignedFree(void* p) noexcept             { __libc_free(p); }
+   #elif JUCE_WINDOWS
+    inline void* rawAlloc(size_t n) noexcept                  { return std::malloc(n); }
+    inline void  rawFree(void* p) noexcept                    { std::free(p); }
+    inline void* rawAlignedAlloc(size_t a, size_t n) noexcept { return _aligned_malloc(n, a); }
+    inline void  rawAlignedFree(void* p) noexcept             { _aligned_free(p); }
+   #else
+    inline void* rawAlloc(size_t n) noexcept                  { return std::malloc(n); }
+    inline void  rawFree(void* p) noexcept                    { std::free(p); }
+    inline void  rawAlignedFree(void* p) noexcept             { std::free(p); }
+    inline void* rawAlignedAlloc(size_t a, size_t n) noexcept
+    {
+        void* p = nullptr;
+        return posix_memalign(&p, a < sizeof(void*) ? sizeof(void*) : a, n) == 0 ? p : nullptr;
+    }
+   #endif
+
+    void* checkedNew(size_t size, const char* what)
+    {
+        report(Violation::allocation, what);
+        if (auto* p = rawAlloc(size == 0 ? 1 : size)) return p;
+        throw std::bad_alloc();
+    }
+
+    void* checkedAlignedNew(size_t size, std::align_val_t alignment, const char* what)
+    {
+        report(Violation::allocation, what);
+        if (auto* p = rawAlignedAlloc((size_t)alignment, size == 0 ? 1 : size)) return p;
+        throw std::bad_alloc();
+    }
+
+    void checkedDelete(void* p, const char* what) noexcept
+    {
+        if (p != nullptr) report(Violation::deallocation, what);
+        rawFree(p);
+    }
+
+    void checkedAlignedDelete(void* p, const char* what) noexcept
+    {
+        if (p != nullptr) report(Violation::deallocation, what);
+        rawAlignedFree(p);
+    }
+}
+
+H9_RT_EXPORT void* operator new  (size_t size) { return checkedNew(size, "operator new"); }
+H9_RT_EXPORT void* operator new[](size_t size) { return checkedNew(size, "operator new[]"); }
+
+H9_RT_EXPORT void operator delete  (void* p) noexcept         { checkedDelete(p, "operator delete"); }
+H9_RT_EXPORT void operator delete[](void* p) noexcept         { checkedDelete(p, "operator delete[]"); }
+H9_RT_EXPORT void operator delete  (void* p, size_t) noexcept { checkedDelete(p, "operator delete"); }
+H9_RT_EXPORT void operator delete[](void* p, size_t) noexcept { checkedDelete(p, "operator delete[]"); }
+
+H9_RT_EXPORT void* operator new  (size_t size, std::align_val_t a) { return checkedAlignedNew(size, a, "operator new"); }
+H9_RT_EXPORT void* operator new[](size_t size, std::align_val_t a) { return checkedAlignedNew(size, a, "operator new[]"); }
+
+H9_RT_EXPORT void operator delete  (void* p, std::align_val_t) noexcept         { checkedAlignedDelete(p, "operator delete"); }
+H9_RT_EXPORT void operator delete[](void* p, std::align_val_t) noexcept         { checkedAlignedDelete(p, "operator delete[]"); }
+H9_RT_EXPORT void operator delete  (void* p, size_t, std::align_val_t) noexcept { checkedAlignedDelete(p, "operator delete"); }
+H9_RT_EXPORT void operator delete[](void* p, size_t, std::align_val_t) noexcept { checkedAlignedDelete(p, "operator delete[]"); }
+
+#endif // HALO9_RT_SANITIZER
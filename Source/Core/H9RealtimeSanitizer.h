@@ -0,0 +1,69 @@
+#pragma once
+#include <juce_core/juce_core.h>
+
+// ── H9RealtimeSanitizer ─────────────────────────────────────────────────────
+// Opt-in (cmake -DHALO9_RT_SANITIZER=ON) instrumentation that flags anything
+// a real-time thread must not do while inside an H9_RT_SCOPE:
+//   • heap allocation / deallocation (operator new / delete; on Linux also
+//     the malloc family)
+//   • blocking mutex / condition-variable / semaphore waits, sleeps
+//   • file I/O (open / fopen / read / write / close)
+// Interception is symbol interposition on Linux (the interposers are
+// exported despite -fvisibility=hidden), so it covers JUCE and libc callers
+// too. Each violation is recorded with a raw backtrace (captured
+// without allocating); the report is printed at exit and, unless
+// HALO9_RT_SANITIZER_FATAL=0, the process exits with status 1 so headless
+// runs fail. Compiles to nothing when the option is off.
+
+#ifndef HALO9_RT_SANITIZER
+ #define HALO9_RT_SANITIZER 0
+#endif
+
+namespace H9RealtimeSanitizer
+{
+    enum class Violation
+    {
+        allocation,
+        deallocation,
+        lock,
+        wait,
+        fileIo
+    };
+
+   #if HALO9_RT_SANITIZER
+    // Marks the calling thread as real-time for the lifetime of the scope
+    struct ScopedRealtime
+    {
+        ScopedRealtime() noexcept;
+        ~ScopedRealtime() noexcept;
+        JUCE_DECLARE_NON_COPYABLE(ScopedRealtime)
+    };
+
+    // Suspends checking inside a real-time scope (e.g. for a deliberate,
+    // reviewed exception). Use sparingly.
+    struct ScopedAllow
+    {
+        ScopedAllow() noexcept;
+        ~ScopedAllow() noexcept;
+        JUCE_DECLARE_NON_COPYABLE(ScopedAllow)
+    };
+
+    // Called by the interceptors; safe to call from any thread
+    void report(Violation, const char* what) noexcept;
+
+    int  getNumViolations() noexcept;
+    void printReport() noexcept;   // stderr, with symbolised backtraces
+    void reset() noexcept;
+   #else
+    struct ScopedRealtime { ScopedRealtime() noexcept {} };
+    struct ScopedAllow    { ScopedAllow()    noexcept {} };
+
+    inline void report(Violation, const char*) noexcept {}
+    inline int  getNumViolations() noexcept { return 0; }
+    inline void printReport() noexcept {}
+    inline void reset() noexcept {}
+   #endif
+}
+
+#define H9_RT_SCOPE     const H9RealtimeSanitizer::ScopedRealtime h9RealtimeScope_
+#define H9_RT_ALLOW     const H9RealtimeSanitizer::ScopedAllow h9RealtimeAllow_
@@ -0,0 +1,316 @@
+#include "H9RealtimeWorkers.h"
+#include "H9RealtimeSanitizer.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+#endif
+
+#if JUCE_LINUX || JUCE_ANDROID
+ #include <linux/futex.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+#elif JUCE_MAC || JUCE_IOS
+ #include <dispatch/dispatch.h>
+#elif JUCE_WINDOWS
+ #ifndef NOMINMAX
+  #define NOMINMAX
+ #endif
+ #include <windows.h>
+#endif
+
+namespace
+{
+    inline void spinPause() noexcept
+    {
+       #if JUCE_INTEL
+        _mm_pause();
+       #elif JUCE_ARM && (defined(__GNUC__) || defined(__clang__))
+        __asm__ __volatile__ ("yield");
+       #endif
+    }
+
+    inline int beginOf(juce::uint64 b) noexcept { return (int)(b >> 32); }
+    inline int endOf  (juce::uint64 b) noexcept { return (int)(b & 0xffffffffu); }
+
+    // Auto-reset wake-up for one sleeping thread that the audio thread can
+    // post without a lock: juce::WaitableEvent signals under a mutex, which
+    // the audio thread may then wait on. A futex on Linux, a dispatch
+    // semaphore on Apple platforms and a kernel event on Windows — each
+    // posts with an atomic and, at most, one system call that never blocks.
+    class WakeSignal
+    {
+    public:
+        WakeSignal()
+        {
+           #if JUCE_MAC || JUCE_IOS
+            semaphore = dispatch_semaphore_create(0);
+           #elif JUCE_WINDOWS
+            event = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+           #endif
+        }
+
+        ~WakeSignal()
+        {
+           #if JUCE_MAC || JUCE_IOS
+            dispatch_release(semaphore);
+           #elif JUCE_WINDOWS
+            CloseHandle(event);
+           #endif
+        }
+
+        // Any thread; never blocks. Posts pending since the last wait()
+        // collapse into one.
+        void signal() noexcept
+        {
+            if (pending.exchange(1, std::memory_order_acq_rel) != 0)
+                return;
+
+           #if JUCE_LINUX || JUCE_ANDROID
+            syscall(SYS_futex, futexWord(), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+           #elif JUCE_MAC || JUCE_IOS
+            dispatch_semaphore_signal(semaphore);
+           #elif JUCE_WINDOWS
+            SetEvent(event);
+           #endif
+        }
+
+        // The sleeping thread: returns once signalled, or after `timeoutMs`
+        void wait(int timeoutMs) noexcept
+        {
+            if (pending.exchange(0, std::memory_order_acq_rel) != 0)
+                return;
+
+           #if JUCE_LINUX || JUCE_ANDROID
+            const timespec timeout { timeoutMs / 1000, (long)(timeoutMs % 1000) * 1000000L };
+            syscall(SYS_futex, futexWord(), FUTEX_WAIT_PRIVATE, 0, &timeout, nullptr, 0);
+           #elif JUCE_MAC || JUCE_IOS
+            dispatch_semaphore_wait(semaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t)timeoutMs * (int64_t)NSEC_PER_MSEC));
+           #elif JUCE_WINDOWS
+            WaitForSingleObject(event, (DWORD)timeoutMs);
+           #else
+            juce::Thread::sleep(1);
+           #endif
+
+            pending.store(0, std::memory_order_release);
+        }
+
+    private:
+        std::atomic<int> pending { 0 };
+
+       #if JUCE_LINUX || JUCE_ANDROID
+        static_assert(sizeof(std::atomic<int>) == sizeof(int), "futex word must be a plain int");
+        int* futexWord() noexcept { return reinterpret_cast<int*>(&pending); }
+       #elif JUCE_MAC || JUCE_IOS
+        dispatch_semaphore_t semaphore;
+       #elif JUCE_WINDOWS
+        HANDLE event;
+       #endif
+    };
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  Worker thread
+// ═══════════════════════════════════════════════════════════════════════════════
+
+class H9RealtimeWorkers::Worker : private juce::Thread
+{
+public:
+    Worker(H9RealtimeWorkers& o, int threadIndex)
+        : juce::Thread("HALO9 voice worker " + juce::String(threadIndex)),
+          owner(o), index(threadIndex)
+    {
+        if (!startRealtimeThread(juce::Thread::RealtimeOptions{}.withPriority(8)))
+            startThread(juce::Thread::Priority::highest);
+    }
+
+    ~Worker() override
+    {
+        signalThreadShouldExit();
+        wake.signal();
+        stopThread(1000);
+    }
+
+    // Audio thread: only posts the wake-up when the worker is asleep
+    void notify() noexcept
+    {
+        if (sleeping.load(std::memory_order_acquire))
+            wake.signal();
+    }
+
+private:
+    // Roughly 50 µs of polling before going to sleep — long enough to catch
+    // the next block's job at small buffer sizes without a wake-up
+    static constexpr int spinIterations = 20000;
+
+    H9RealtimeWorkers& owner;
+    const int index;
+    WakeSignal wake;
+    std::atomic<bool> sleeping { false };
+
+    void run() override
+    {
+        juce::uint32 seen = owner.generation.load(std::memory_order_acquire);
+
+        while (!threadShouldExit())
+        {
+            auto g = owner.generation.load(std::memory_order_acquire);
+            for (int i = 0; g == seen && i < spinIterations; ++i)
+            {
+                spinPause();
+                g = owner.generation.load(std::memory_order_acquire);
+            }
+
+            if (g == seen)
+            {
+                sleeping.store(true, std::memory_order_seq_cst);
+                // Re-check after announcing sleep, so a run() that missed
+                // the flag can't leave us waiting
+                if (owner.generation.load(std::memory_order_seq_cst) == seen)
+                    wake.wait(100);
+                sleeping.store(false, std::memory_order_relaxed);
+                continue;
+            }
+
+            seen = g;
+
+            // Register before looking at the job, so run() can't return
+            // (and reuse the slices) while this thread is still inside
+            owner.inFlight.fetch_add(1, std::memory_order_seq_cst);
+            if (owner.generation.load(std::memory_order_seq_cst) == g
+                && !owner.finished.load(std::memory_order_seq_cst))
+            {
+                // Rendering for the audio thread, under its rules — but not
+                // the spin / sleep above, which is this thread's own business
+                H9_RT_SCOPE;
+                owner.work(index);
+            }
+            owner.inFlight.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(Worker)
+};
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  Pool
+// ═══════════════════════════════════════════════════════════════════════════════
+
+H9RealtimeWorkers::H9RealtimeWorkers(int numThreads)
+{
+    const int n = juce::jlimit(1, maxThreads, numThreads);
+    for (int i = 1; i < n; ++i)
+        workers.push_back(std::make_unique<Worker>(*this, i));
+}
+
+H9RealtimeWorkers::~H9RealtimeWorkers()
+{
+    workers.clear();
+}
+
+void H9RealtimeWorkers::runErased(int numTasks, void* ctx, Invoke fn) noexcept
+{
+    if (numTasks <= 0)
+        return;
+
+    const int numThreads = getNumThreads();
+    if (numThreads == 1 || numTasks == 1)
+    {
+        for (int t = 0; t < numTasks; ++t)
+            fn(ctx, t, 0);
+        return;
+    }
+
+    context = ctx;
+    invoke  = fn;
+    remaining.store(numTasks, std::memory_order_relaxed);
+
+    for (int t = 0; t < numThreads; ++t)
+        slices[(size_t)t].bounds.store(pack(numTasks * t / numThreads, numTasks * (t + 1) / numThreads),
+                                       std::memory_order_relaxed);
+
+    finished.store(false, std::memory_order_seq_cst);
+    generation.fetch_add(1, std::memory_order_seq_cst);
+
+    for (auto& w : workers)
+        w->notify();
+
+    work(0);
+
+    // Sleeping or late workers have their tasks stolen by whoever is awake,
+    // so this only waits on tasks that are actually running
+    while (remaining.load(std::memory_order_acquire) > 0)
+        spinPause();
+
+    finished.store(true, std::memory_order_seq_cst);
+    while (inFlight.load(std::memory_order_seq_cst) > 0)
+        spinPause();
+}
+
+void H9RealtimeWorkers::work(int thread) noexcept
+{
+    for (;;)
+    {
+        int task;
+        while (pop(thread, task))
+        {
+            invoke(context, task, thread);
+            remaining.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+        if (!steal(thread))
+            return;
+    }
+}
+
+bool H9RealtimeWorkers::pop(int thread, int& task) noexcept
+{
+    auto& bounds = slices[(size_t)thread].bounds;
+    auto b = bounds.load(std::memory_order_acquire);
+
+    while (beginOf(b) < endOf(b))
+    {
+        if (bounds.compare_exchange_weak(b, pack(beginOf(b) + 1, endOf(b)),
+                                         std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            task = beginOf(b);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Takes the upper half of the fullest slice into this thread's own (empty)
+// slice. False once nothing is left to take.
+bool H9RealtimeWorkers::steal(int thread) noexcept
+{
+    const int numThreads = getNumThreads();
+
+    for (;;)
+    {
+        int victim = -1, most = 0;
+        juce::uint64 vb = 0;
+
+        for (int t = 0; t < numThreads; ++t)
+        {
+            const auto b = slices[(size_t)t].bounds.load(std::memory_order_acquire);
+            if (t != thread && endOf(b) - beginOf(b) > most)
+            {
+                victim = t;
+                most   = endOf(b) - beginOf(b);
+                vb     = b;
+            }
+        }
+
+        if (victim < 0)
+            return false;
+
+        const int mid = beginOf(vb) + most / 2;
+        if (slices[(size_t)victim].bounds.compare_exchange_strong(vb, pack(beginOf(vb), mid),
+                                                                  std::memory_order_acq_rel))
+        {
+            slices[(size_t)thread].bounds.store(pack(mid, endOf(vb)), std::memory_order_release);
+            return true;
+        }
+        // Lost a race with the owner or another thief — rescan
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <juce_core/juce_core.h>
+
+// ── H9RealtimeWorkers ───────────────────────────────────────────────────────
+// Fork-join helper for splitting one processBlock stage across cores.
+// run() hands each thread an even slice of [0, numTasks); a thread that
+// finishes its slice steals the upper half of the fullest remaining slice,
+// so one slow task (a voice crossing into a disk stream, say) doesn't hold
+// the others up. The calling audio thread works as thread 0 and spins until
+// every task is done. It never allocates or locks — a worker that has gone to
+// sleep is woken with a futex / semaphore post (see WakeSignal).
+//
+// Workers are real-time threads. They spin briefly after each job, then
+// sleep until the next run() wakes them. Tasks must write only to memory
+// of their own; callers that need a bit-exact result reduce per-task
+// output in a fixed order afterwards.
+//
+// Built and destroyed off the audio thread (threads start and stop there).
+
+class H9RealtimeWorkers
+{
+public:
+    static constexpr int maxThreads = 16;   // including the calling thread
+
+    explicit H9RealtimeWorkers(int numThreads);
+    ~H9RealtimeWorkers();
+
+    int getNumThreads() const noexcept { return 1 + (int)workers.size(); }
+
+    // Audio thread. Calls fn(task, thread) once for every task, with
+    // thread in [0, getNumThreads()); returns when all have finished.
+    template <typename Fn>
+    void run(int numTasks, Fn&& fn) noexcept
+    {
+        using F = std::remove_reference_t<Fn>;
+        runErased(numTasks, (void*)&fn, [](void* c, int task, int thread) { (*static_cast<F*>(c))(task, thread); });
+    }
+
+private:
+    class Worker;
+
+    using Invoke = void (*)(void*, int task, int thread);
+
+    // Slice of task indices, (begin << 32 | end), changed only by CAS
+    struct alignas(64) Slice { std::atomic<juce::uint64> bounds { 0 }; };
+
+    std::array<Slice, maxThreads> slices;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    // Current job, published by bumping `generation`
+    void*  context { nullptr };
+    Invoke invoke  { nullptr };
+    std::atomic<juce::uint32> generation { 0 };
+    std::atomic<bool> finished  { true };
+    std::atomic<int>  remaining { 0 };
+    std::atomic<int>  inFlight  { 0 };   // workers inside work()
+
+    void runErased(int numTasks, void* context, Invoke) noexcept;
+    void work(int thread) noexcept;
+    bool pop(int thread, int& task) noexcept;
+    bool steal(int thread) noexcept;
+
+    static juce::uint64 pack(int begin, int end) noexcept
+    {
+        return ((juce::uint64)(juce::uint32)begin << 32) | (juce::uint32)end;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE(H9RealtimeWorkers)
+};
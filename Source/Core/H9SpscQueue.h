@@ -0,0 +1,66 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <array>
+
+// ── H9SpscQueue ─────────────────────────────────────────────────────────────
+// Fixed-capacity, wait-free single-producer / single-consumer queue built on
+// juce::AbstractFifo. No allocation after construction; push() fails (and
+// counts a drop) instead of blocking when the consumer falls behind.
+// T must be trivially copyable — elements are copied in and out by value.
+
+template <typename T, int Capacity>
+class H9SpscQueue
+{
+public:
+    static_assert(Capacity > 1, "capacity must be at least 2");
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+    // Producer side
+    bool push(const T& item) noexcept
+    {
+        auto scope = fifo.write(1);
+        if (scope.blockSize1 + scope.blockSize2 != 1)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        storage[(size_t)(scope.blockSize1 == 1 ? scope.startIndex1 : scope.startIndex2)] = item;
+        return true;
+    }
+
+    // Consumer side
+    bool pop(T& item) noexcept
+    {
+        auto scope = fifo.read(1);
+        if (scope.blockSize1 + scope.blockSize2 != 1)
+            return false;
+
+        item = storage[(size_t)(scope.blockSize1 == 1 ? scope.startIndex1 : scope.startIndex2)];
+        return true;
+    }
+
+    // Consumer side — calls fn(const T&) for everything currently queued
+    template <typename Fn>
+    int drain(Fn&& fn)
+    {
+        const int ready = fifo.getNumReady();
+        if (ready <= 0) return 0;
+
+        fifo.read(ready).forEach([&](int index) { fn(storage[(size_t)index]); });
+        return ready;
+    }
+
+    // Consumer side — discard everything queued so far
+    void clear() noexcept { fifo.read(fifo.getNumReady()); }
+
+    int getNumReady() const noexcept { return fifo.getNumReady(); }
+    int getFreeSpace() const noexcept { return fifo.getFreeSpace(); }
+    juce::uint32 getNumDropped() const noexcept { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    // AbstractFifo keeps one slot free to tell full from empty
+    juce::AbstractFifo fifo { Capacity + 1 };
+    std::array<T, (size_t)Capacity + 1> storage {};
+    std::atomic<juce::uint32> dropped { 0 };
+};
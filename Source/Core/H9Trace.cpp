@@ -0,0 +1,153 @@
+#include "H9Trace.h"
+#include <map>
+#include <mutex>
+
+namespace
+{
+    struct Event
+    {
+        const char* name;
+        const char* category;
+        juce::int64 ts;
+        juce::int64 dur;
+        int         tid;
+    };
+
+    bool writeEvents(const std::vector<Event>& events, const juce::File& file)
+    {
+        const int pid = juce::Process::getProcessId();
+
+        juce::MemoryOutputStream out;
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            auto& e = events[i];
+            out << "{\"name\":" << juce::JSON::toString(juce::var(e.name))
+                << ",\"cat\":"  << juce::JSON::toString(juce::var(e.category))
+                << ",\"ph\":\"X\",\"ts\":" << e.ts
+                << ",\"dur\":" << e.dur
+                << ",\"pid\":" << pid
+                << ",\"tid\":" << e.tid << "}"
+                << (i + 1 < events.size() ? ",\n" : "\n");
+        }
+        out << "]}\n";
+
+        file.getParentDirectory().createDirectory();
+        return file.replaceWithText(out.toString());
+    }
+
+    // Process-wide collector. Written out at exit when tracing was switched
+    // on through the environment.
+    struct Collector
+    {
+        Collector()
+        {
+            auto env = juce::SystemStats::getEnvironmentVariable("HALO9_TRACE", {});
+            if (env.isNotEmpty() && env != "0")
+            {
+                enabled.store(true);
+                outputFile = env.endsWithIgnoreCase(".json")
+                    ? juce::File(env)
+                    : juce::File::getSpecialLocation(juce::File::tempDirectory)
+                          .getChildFile("halo9-trace-" + juce::String(juce::Process::getProcessId()) + ".json");
+            }
+        }
+
+        ~Collector()
+        {
+            if (outputFile != juce::File() && !events.empty())
+                writeEvents(events, outputFile);
+        }
+
+        int threadIndex()
+        {
+            auto id = juce::Thread::getCurrentThreadId();
+            auto it = threadIds.find(id);
+            if (it != threadIds.end()) return it->second;
+
+            const int index = (int)threadIds.size() + 1;
+            threadIds[id] = index;
+            return index;
+        }
+
+        std::atomic<bool> enabled { false };
+        std::mutex lock;
+        std::vector<Event> events;
+        std::map<juce::Thread::ThreadID, int> threadIds;
+        juce::File outputFile;
+        const juce::int64 epochTicks = juce::Time::getHighResolutionTicks();
+    };
+
+    Collector& collector()
+    {
+        static Collector c;
+        return c;
+    }
+}
+
+namespace H9Trace
+{
+    bool isEnabled() noexcept { return collector().enabled.load(std::memory_order_relaxed); }
+
+    void setEnabled(bool shouldBeEnabled) { collector().enabled.store(shouldBeEnabled); }
+
+    juce::int64 nowMicros() noexcept
+    {
+        const auto ticks = juce::Time::getHighResolutionTicks() - collector().epochTicks;
+        return (juce::int64)((double)ticks * 1.0e6
+                             / (double)juce::Time::getHighResolutionTicksPerSecond());
+    }
+
+    void addComplete(const char* name, const char* category,
+                     juce::int64 startMicros, juce::int64 durationMicros)
+    {
+        auto& c = collector();
+        const std::lock_guard<std::mutex> sl(c.lock);
+        c.events.push_back({ name, category, startMicros, durationMicros, c.threadIndex() });
+    }
+
+    bool writeChromeJson(const juce::File& file)
+    {
+        auto& c = collector();
+        std::vector<Event> copy;
+        {
+            const std::lock_guard<std::mutex> sl(c.lock);
+            copy = c.events;
+        }
+
+        return writeEvents(copy, file);
+    }
+
+    juce::String getSummary()
+    {
+        struct Total { int count { 0 }; juce::int64 total { 0 }; juce::int64 max { 0 }; };
+        std::map<juce::String, Total> totals;
+
+        {
+            auto& c = collector();
+            const std::lock_guard<std::mutex> sl(c.lock);
+            for (auto& e : c.events)
+            {
+                auto& t = totals[juce::String(e.name)];
+                ++t.count;
+                t.total += e.dur;
+                t.max = juce::jmax(t.max, e.dur);
+            }
+        }
+
+        juce::String s;
+        for (auto& [name, t] : totals)
+            s << name.paddedRight(' ', 32)
+              << juce::String(t.count).paddedLeft(' ', 6) << "x  total "
+              << juce::String((double)t.total / 1000.0, 2).paddedLeft(' ', 10) << " ms  max "
+              << juce::String((double)t.max / 1000.0, 2).paddedLeft(' ', 8) << " ms\n";
+        return s;
+    }
+
+    void clear()
+    {
+        auto& c = collector();
+        const std::lock_guard<std::mutex> sl(c.lock);
+        c.events.clear();
+    }
+}
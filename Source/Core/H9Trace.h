@@ -0,0 +1,76 @@
+#pragma once
+#include <juce_core/juce_core.h>
+
+// ── H9Trace ─────────────────────────────────────────────────────────────────
+// Lightweight phase tracing for instantiation and editor-open, exported as
+// Chrome trace-event JSON (chrome://tracing, Perfetto). Off unless the
+// HALO9_TRACE environment variable is set (or setEnabled(true) is called):
+//   HALO9_TRACE=1                  → <temp>/halo9-trace-<pid>.json at exit
+//   HALO9_TRACE=/path/trace.json   → that file at exit
+// Not for the audio thread — recording takes a mutex.
+
+namespace H9Trace
+{
+    bool isEnabled() noexcept;
+    void setEnabled(bool shouldBeEnabled);
+
+    juce::int64 nowMicros() noexcept;
+
+    // `name` / `category` must be string literals (stored by pointer)
+    void addComplete(const char* name, const char* category,
+                     juce::int64 startMicros, juce::int64 durationMicros);
+
+    bool writeChromeJson(const juce::File& file);
+
+    // Per-name count / total / max, one line each — for harnesses and logs
+    juce::String getSummary();
+
+    void clear();
+
+    // Records [construction, destruction) as one complete event
+    class Scope
+    {
+    public:
+        explicit Scope(const char* n, const char* cat = "startup") noexcept
+            : name(n), category(cat), start(isEnabled() ? nowMicros() : -1) {}
+
+        ~Scope()
+        {
+            if (start >= 0)
+                addComplete(name, category, start, nowMicros() - start);
+        }
+
+    private:
+        const char* name;
+        const char* category;
+        juce::int64 start;
+        JUCE_DECLARE_NON_COPYABLE(Scope)
+    };
+
+    // Like Scope, but can be ended early (e.g. a member constructed before
+    // another member and ended in the constructor body)
+    class Span
+    {
+    public:
+        explicit Span(const char* n, const char* cat = "startup") noexcept
+            : name(n), category(cat), start(isEnabled() ? nowMicros() : -1) {}
+
+        ~Span() { end(); }
+
+        void end()
+        {
+            if (start >= 0)
+                addComplete(name, category, start, nowMicros() - start);
+            start = -1;
+        }
+
+    private:
+        const char* name;
+        const char* category;
+        juce::int64 start;
+        JUCE_DECLARE_NON_COPYABLE(Span)
+    };
+}
+
+#define H9_TRACE_SCOPE(name) \
+    const H9Trace::Scope JUCE_JOIN_MACRO(h9TraceScope_, __LINE__) (name)
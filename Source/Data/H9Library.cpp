@@ -1,27 +1,37 @@
 #include "H9Library.h"
+#include "Core/H9Trace.h"
 
 // ── Library root discovery ───────────────────────────────────────────────────
 
 juce::File H9Library::findLibraryRoot()
 {
+    H9_TRACE_SCOPE("findLibraryRoot");
+
     // 1. Environment variable override (admin/dev)
-    auto envPath = juce::SystemStats::getEnvironmentVariable("HALO9_LIBRARY_PATH", "");
-    if (envPath.isNotEmpty())
     {
-        juce::File f(envPath);
-        if (f.getChildFile("library.json").existsAsFile())
-            return f;
+        H9_TRACE_SCOPE("probe: env");
+        auto envPath = juce::SystemStats::getEnvironmentVariable("HALO9_LIBRARY_PATH", "");
+        if (envPath.isNotEmpty())
+        {
+            juce::File f(envPath);
+            if (f.getChildFile("library.json").existsAsFile())
+                return f;
+        }
     }
 
     // 2. User application data (~/Library/Application Support/HALO9/library)
-    auto userLib = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
-                       .getChildFile("HALO9/library");
-    if (userLib.getChildFile("library.json").existsAsFile())
-        return userLib;
+    {
+        H9_TRACE_SCOPE("probe: user app data");
+        auto userLib = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                           .getChildFile("HALO9/library");
+        if (userLib.getChildFile("library.json").existsAsFile())
+            return userLib;
+    }
 
     // 3. Development path (set by CMake compile definition)
 #ifdef HALO9_DEV_LIBRARY_PATH
     {
+        H9_TRACE_SCOPE("probe: dev path");
         juce::File devLib(HALO9_DEV_LIBRARY_PATH);
         if (devLib.getChildFile("library.json").existsAsFile())
             return devLib;
@@ -29,10 +39,13 @@ juce::File H9Library::findLibraryRoot()
 #endif
 
     // 4. App bundle resources (production)
-    auto app = juce::File::getSpecialLocation(juce::File::currentApplicationFile);
-    auto res = app.getChildFile("Contents/Resources/halo9_library");
-    if (res.getChildFile("library.json").existsAsFile())
-        return res;
+    {
+        H9_TRACE_SCOPE("probe: app bundle");
+        auto app = juce::File::getSpecialLocation(juce::File::currentApplicationFile);
+        auto res = app.getChildFile("Contents/Resources/halo9_library");
+        if (res.getChildFile("library.json").existsAsFile())
+            return res;
+    }
 
     return {};
 }
@@ -41,6 +54,8 @@ juce::File H9Library::findLibraryRoot()
 
 bool H9Library::loadFromDirectory(const juce::File& libraryRoot)
 {
+    H9_TRACE_SCOPE("loadFromDirectory");
+
     root = libraryRoot;
     packs.clear();
     kits.clear();
@@ -135,6 +150,36 @@ bool H9Library::loadPackManifest(const juce::File& file, H9PackData& pack)
         }
     }
 
+    // "reverb": { "impulse": "ir/room.wav", "gain": 0.8 } — convolved by the
+    // Atmosphere reverb in place of the algorithmic one
+    auto reverb = m["reverb"];
+    if (reverb.isObject())
+    {
+        pack.impulseFile = reverb["impulse"].toString();
+        auto g = reverb["gain"];
+        if (!g.isVoid())
+            pack.impulseGain = juce::jlimit(0.0f, 4.0f, static_cast<float>(static_cast<double>(g)));
+    }
+
+    // "tape": { "drive": 0.4, "wow": 0.5, "flutter": 0.3, "oversampling": 4 }
+    // — on unless "enabled" is false; missing values keep their defaults
+    auto tape = m["tape"];
+    if (tape.isObject())
+    {
+        auto unit = [&tape](const char* key, float& value)
+        {
+            auto v = tape[key];
+            if (!v.isVoid())
+                value = juce::jlimit(0.0f, 1.0f, static_cast<float>(static_cast<double>(v)));
+        };
+
+        pack.tape.enabled = (bool)tape.getProperty("enabled", true);
+        unit("drive",   pack.tape.drive);
+        unit("wow",     pack.tape.wow);
+        unit("flutter", pack.tape.flutter);
+        pack.tape.oversampling = (int)tape.getProperty("oversampling", 2) >= 4 ? 4 : 2;
+    }
+
     return true;
 }
 
@@ -148,6 +193,16 @@ bool H9Library::loadKitManifest(const juce::File& file, H9KitData& kit)
     kit.rootDir     = file.getParentDirectory();
     kit.description = m["description"].toString();
     kit.accentColor = parseColor(m["accentColor"].toString(), juce::Colour(0xff33ffc8));
+    kit.storage     = m["storage"].toString();
+
+    // "streaming": true, or { "preloadFrames": N } — large kits keep only each
+    // pad's attack resident and read the rest from disk while it plays
+    auto streaming = m["streaming"];
+    if (streaming.isObject())
+        kit.preloadFrames = juce::jlimit(256, 1 << 20,
+            (int)streaming.getProperty("preloadFrames", H9KitData::defaultPreloadFrames));
+    else if ((bool)streaming)
+        kit.preloadFrames = H9KitData::defaultPreloadFrames;
 
     auto ui = m["ui"];
     if (ui.isObject())
@@ -173,6 +228,9 @@ bool H9Library::loadKitManifest(const juce::File& file, H9KitData& kit)
                 info.file  = p["file"].toString();
                 auto g = p["gain"];
                 info.gain  = g.isVoid() ? 1.0f : static_cast<float>(static_cast<double>(g));
+                info.chokeGroup = juce::jmax(0, static_cast<int>(p["chokeGroup"]));
+                info.tune = juce::jlimit(-48.0f, 48.0f, static_cast<float>(static_cast<double>(p["tune"])));
+                info.velocityToPitch = juce::jlimit(-24.0f, 24.0f, static_cast<float>(static_cast<double>(p["velocityToPitch"])));
                 kit.pads.push_back(info);
             }
         }
@@ -12,6 +12,19 @@ struct H9PadInfo
     juce::String slot;      // routing slot name
     juce::String file;      // sample file path (drum kits)
     float        gain { 1.0f };
+    int          chokeGroup { 0 };   // drum kits: pads sharing a non-zero group cut each other
+    float        tune       { 0.0f };   // semitones
+    float        velocityToPitch { 0.0f };   // semitones added at full velocity
+};
+
+// Tape stage settings from a pack manifest (see H9TapeStage)
+struct H9TapeInfo
+{
+    bool  enabled      { false };
+    float drive        { 0.3f };
+    float wow          { 0.3f };
+    float flutter      { 0.2f };
+    int   oversampling { 2 };   // 2 or 4
 };
 
 struct H9PackData
@@ -24,17 +37,24 @@ struct H9PackData
     float        padGlowIntensity { 0.85f };
     juce::String badge;
     std::vector<H9PadInfo> padBank;
+    juce::String impulseFile;             // Atmosphere reverb IR, relative to rootDir
+    float        impulseGain { 1.0f };
+    H9TapeInfo   tape;                    // applied when the pack is selected
     juce::File   rootDir;
 };
 
 struct H9KitData
 {
+    static constexpr int defaultPreloadFrames = 4096;
+
     juce::String id;
     juce::String name;
     juce::String description;
     juce::Colour accentColor      { 0xff33ffc8 };
     float        padGlowIntensity { 0.95f };
     juce::String badge;
+    juce::String storage;   // resident sample encoding: float32 / int24 / int16 / compressed
+    int          preloadFrames { 0 };   // > 0: stream pads from disk past this many frames
     std::vector<H9PadInfo> pads;
     juce::File   rootDir;
 };
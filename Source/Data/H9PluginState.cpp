@@ -0,0 +1,195 @@
+#include "H9PluginState.h"
+
+namespace
+{
+    constexpr juce::uint32 fourCC(const char (&s)[5])
+    {
+        return (juce::uint32)(juce::uint8)s[0]
+             | ((juce::uint32)(juce::uint8)s[1] << 8)
+             | ((juce::uint32)(juce::uint8)s[2] << 16)
+             | ((juce::uint32)(juce::uint8)s[3] << 24);
+    }
+
+    constexpr juce::uint32 magic       = fourCC("H9ST");
+    constexpr juce::uint32 tagParams   = fourCC("PRMS");
+    constexpr juce::uint32 tagLibrary  = fourCC("LIBR");
+    constexpr juce::uint32 tagPads     = fourCC("PADS");
+    constexpr juce::uint32 tagLoop     = fourCC("LOOP");
+    constexpr juce::uint32 tagSlices   = fourCC("SLCE");
+    constexpr juce::uint32 tagSteps    = fourCC("STEP");
+
+    constexpr int hashBytes = 16;
+
+    void writeRef(juce::OutputStream& out, const H9SampleRef& ref)
+    {
+        out.writeString(ref.path);
+
+        juce::MemoryBlock hash;
+        if (ref.hash.length() == hashBytes * 2)
+            hash.loadFromHexString(ref.hash);
+        hash.setSize(hashBytes, true);
+        out.write(hash.getData(), hashBytes);
+
+        out.writeInt64(ref.size);
+    }
+
+    H9SampleRef readRef(juce::InputStream& in)
+    {
+        H9SampleRef ref;
+        ref.path = in.readString();
+
+        juce::uint8 hash[hashBytes] {};
+        in.read(hash, hashBytes);
+
+        bool allZero = true;
+        for (auto b : hash) allZero = allZero && b == 0;
+        if (!allZero)
+            ref.hash = juce::String::toHexString(hash, hashBytes, 0);
+
+        ref.size = in.readInt64();
+        return ref;
+    }
+
+    void writeChunk(juce::OutputStream& out, juce::uint32 tag,
+                    const std::function<void(juce::OutputStream&)>& body)
+    {
+        juce::MemoryOutputStream payload;
+        body(payload);
+
+        out.writeInt((int)tag);
+        out.writeCompressedInt((int)payload.getDataSize());
+        out.write(payload.getData(), payload.getDataSize());
+    }
+}
+
+void H9PluginState::writeTo(juce::MemoryBlock& dest) const
+{
+    juce::MemoryOutputStream out(dest, false);
+
+    out.writeInt((int)magic);
+    out.writeShort((short)currentVersion);
+
+    writeChunk(out, tagParams, [this](juce::OutputStream& o)
+    {
+        o.writeCompressedInt((int)parameters.size());
+        for (auto& [id, value] : parameters)
+        {
+            o.writeString(id);
+            o.writeFloat(value);
+        }
+    });
+
+    writeChunk(out, tagLibrary, [this](juce::OutputStream& o)
+    {
+        o.writeString(activePackId);
+        o.writeString(activeKitId);
+    });
+
+    writeChunk(out, tagPads, [this](juce::OutputStream& o)
+    {
+        o.writeCompressedInt(numPads);
+        for (auto& ref : pads)
+            writeRef(o, ref);
+    });
+
+    if (!loop.isEmpty())
+        writeChunk(out, tagLoop, [this](juce::OutputStream& o) { writeRef(o, loop); });
+
+    if (!slices.isEmpty())
+        writeChunk(out, tagSlices, [this](juce::OutputStream& o) { writeRef(o, slices); });
+
+    if (!steps.isEmpty())
+        writeChunk(out, tagSteps, [this](juce::OutputStream& o)
+        {
+            o.writeByte((char)steps.stepsPerBeat);
+            o.writeByte((char)steps.numSteps);
+            o.writeByte((char)H9StepPattern::numTracks);
+            for (auto& track : steps.velocity)
+                o.write(track.data(), (size_t)steps.numSteps);
+        });
+}
+
+bool H9PluginState::readFrom(const void* data, size_t sizeInBytes)
+{
+    juce::MemoryInputStream in(data, sizeInBytes, false);
+
+    if (sizeInBytes < 6 || (juce::uint32)in.readInt() != magic)
+        return false;
+
+    const int version = in.readShort();
+    if (version < 1 || version > currentVersion)
+        return false;
+
+    *this = {};
+
+    while (!in.isExhausted())
+    {
+        const auto tag  = (juce::uint32)in.readInt();
+        const int  size = in.readCompressedInt();
+
+        if (size < 0 || size > in.getNumBytesRemaining())
+            return false;   // truncated
+
+        const auto chunkEnd = in.getPosition() + size;
+        juce::MemoryInputStream chunk((const char*)data + in.getPosition(), (size_t)size, false);
+
+        if (tag == tagParams)
+        {
+            const int count = chunk.readCompressedInt();
+            for (int i = 0; i < count && !chunk.isExhausted(); ++i)
+            {
+                auto id = chunk.readString();
+                parameters.emplace_back(id, chunk.readFloat());
+            }
+        }
+        else if (tag == tagLibrary)
+        {
+            activePackId = chunk.readString();
+            activeKitId  = chunk.readString();
+        }
+        else if (tag == tagPads)
+        {
+            const int count = chunk.readCompressedInt();
+            for (int i = 0; i < count && !chunk.isExhausted(); ++i)
+            {
+                auto ref = readRef(chunk);
+                if (i < numPads)
+                    pads[(size_t)i] = std::move(ref);
+            }
+        }
+        else if (tag == tagLoop)
+        {
+            loop = readRef(chunk);
+        }
+        else if (tag == tagSlices)
+        {
+            slices = readRef(chunk);
+        }
+        else if (tag == tagSteps)
+        {
+            const int perBeat  = (juce::uint8)chunk.readByte();
+            const int numSteps = (juce::uint8)chunk.readByte();
+            const int tracks   = (juce::uint8)chunk.readByte();
+
+            if (perBeat >= 1 && perBeat <= H9StepPattern::maxStepsPerBeat
+                && numSteps >= 1 && numSteps <= H9StepPattern::maxSteps)
+            {
+                steps.stepsPerBeat = perBeat;
+                steps.numSteps     = numSteps;
+
+                juce::uint8 row[H9StepPattern::maxSteps] {};
+                for (int t = 0; t < tracks && !chunk.isExhausted(); ++t)
+                {
+                    const int got = chunk.read(row, numSteps);
+                    if (t < H9StepPattern::numTracks)
+                        for (int i = 0; i < got; ++i)
+                            steps.velocity[(size_t)t][(size_t)i] = (juce::uint8)juce::jmin(127, (int)row[i]);
+                }
+            }
+        }
+
+        in.setPosition(chunkEnd);
+    }
+
+    return true;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <juce_core/juce_core.h>
+
+// ── Sample reference ────────────────────────────────────────────────────────
+// Where a sample was at save time plus enough to find it again if it moved:
+// the MD5 of the file bytes and the file size (a cheap pre-filter).
+
+struct H9SampleRef
+{
+    juce::String path;           // absolute path at save time
+    juce::String hash;           // MD5 of the file contents, 32 hex chars
+    juce::int64  size { 0 };     // file size in bytes
+
+    bool isEmpty() const { return path.isEmpty() && hash.isEmpty(); }
+};
+
+// ── Step pattern ────────────────────────────────────────────────────────────
+// The internal step sequencer's pattern (see H9StepSequencer): one track
+// per pad, `numSteps` steps of a 1 / (4 × stepsPerBeat) note each, repeating
+// from bar 1. A step's velocity is 1 – 127; 0 is a rest.
+
+struct H9StepPattern
+{
+    static constexpr int numTracks       = 8;
+    static constexpr int maxSteps        = 64;
+    static constexpr int maxStepsPerBeat = 16;   // 1/64 notes
+
+    int stepsPerBeat { 4 };   // 1 (1/4) … 16 (1/64); 3, 6, 12 for triplets
+    int numSteps     { 16 };
+    std::array<std::array<juce::uint8, maxSteps>, numTracks> velocity {};
+
+    bool isEmpty() const
+    {
+        for (auto& track : velocity)
+            for (int i = 0; i < numSteps; ++i)
+                if (track[(size_t)i] != 0)
+                    return false;
+        return true;
+    }
+};
+
+// ── H9PluginState ───────────────────────────────────────────────────────────
+// Everything getStateInformation saves. Binary layout (little endian):
+//
+//   u32 magic 'H9ST'   u16 version
+//   chunk*             u32 tag, compressed-int size, payload
+//
+//   'PRMS'  count, { utf8 id, f32 value (denormalised) }*
+//   'LIBR'  utf8 pack id, utf8 kit id
+//   'PADS'  count, { ref }*          ref = utf8 path, u8[16] md5, i64 size
+//   'LOOP'  ref
+//   'SLCE'  ref                      loop the pads are sliced from (replaces
+//                                    the kit; slices are found again on load)
+//   'STEP'  u8 steps per beat, u8 steps, u8 tracks, { u8 velocity × steps }*
+//
+// Unknown chunks are skipped, so newer builds can add chunks without
+// breaking older ones; `version` only changes for incompatible layouts.
+
+struct H9PluginState
+{
+    static constexpr int numPads        = 8;
+    static constexpr int currentVersion = 1;
+
+    std::vector<std::pair<juce::String, float>> parameters;
+    juce::String activePackId;
+    juce::String activeKitId;
+    std::array<H9SampleRef, numPads> pads;
+    H9SampleRef  loop;
+    H9SampleRef  slices;
+    H9StepPattern steps;
+
+    void writeTo(juce::MemoryBlock& dest) const;
+
+    // False when the data isn't binary state (e.g. legacy APVTS XML) or is
+    // truncated / from an incompatible version
+    bool readFrom(const void* data, size_t sizeInBytes);
+};
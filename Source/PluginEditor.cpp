@@ -13,11 +13,13 @@ HALO9PlayerAudioProcessorEditor::HALO9PlayerAudioProcessorEditor(
       atmosphereAtt(p.apvts, "atmosphere",     atmosphereSlider),
       synthLevelAtt(p.apvts, "synth_level",    synthLevelSlider),
       keyboardComponent(p.getKeyboardState(),
-                        juce::MidiKeyboardComponent::horizontalKeyboard)
+                        juce::MidiKeyboardComponent::horizontalKeyboard),
+      seqAtt(p.apvts, "seq_enabled", seqToggle)
 {
     setLookAndFeel(&lookAndFeel);
 
     // ── Logo: try embedded memory first, then file system fallback ──────────
+    H9Trace::Span logoTrace { "logo decode" };
     if (halo9_png_len > 0)
         logoImage = juce::ImageCache::getFromMemory(halo9_png, halo9_png_len);
 
@@ -45,6 +47,7 @@ HALO9PlayerAudioProcessorEditor::HALO9PlayerAudioProcessorEditor(
             }
         }
     }
+    logoTrace.end();
 
     // ── Knob setup ─────────────────────────────────────────────────────────
     auto setupKnob = [&](juce::Slider& s, juce::Label& lbl, const char* name)
@@ -93,26 +96,46 @@ HALO9PlayerAudioProcessorEditor::HALO9PlayerAudioProcessorEditor(
         juce::Colour(0xff1e3634));
     keyboardComponent.setKeyWidth(23.0f);
     keyboardComponent.setAvailableRange(48, 84);
+
+    // Start from a clean slate — anything queued while no editor was open
+    // is stale; held notes are picked up from the snapshot on the first tick
+    processor.getActivityBridge().discardEvents();
+    processor.getKeyboardState().allNotesOff(0);
     updateKeyboardHighlight(activeKeyHighlightColor);
     addAndMakeVisible(keyboardComponent);
 
+    // ── Step grid — every edit goes straight to the processor ─────────────
+    stepGrid.onPatternChanged = [this](const H9StepPattern& pattern)
+    {
+        processor.setStepPattern(pattern);
+    };
+    addAndMakeVisible(stepGrid);
+
+    seqToggle.setColour(juce::ToggleButton::textColourId, H9::dimText);
+    addAndMakeVisible(seqToggle);
+
     // ── Library panel (populated from real data) ──────────────────────────
     auto& lib = processor.getLibrary();
-    libraryPanel.populate(lib);
+    {
+        H9_TRACE_SCOPE("libraryPanel.populate");
+        libraryPanel.populate(lib);
+    }
 
     libraryPanel.onPackSelected = [this](int index) { setActivePack(index); };
     libraryPanel.onKitSelected  = [this](int index) { setActiveKit(index); };
 
     addAndMakeVisible(libraryPanel);
 
-    // ── Apply initial pack if available ───────────────────────────────────
-    if (libraryPanel.selectedPack >= 0)
-        setActivePack(libraryPanel.selectedPack);
+    // ── Restore the processor's pack / kit (or the first pack) ────────────
+    {
+        H9_TRACE_SCOPE("setActivePack");
+        syncSelectionFromProcessor();
+    }
 
     setWantsKeyboardFocus(true);
     startTimer(60);
     setOpaque(true);
-    setSize(540, 760);
+    setSize(540, 860);
 
     // Defer window show/center until editor is attached to the host
     juce::MessageManager::callAsync([this]()
@@ -152,6 +175,7 @@ void HALO9PlayerAudioProcessorEditor::setActivePack(int index)
     if (index < 0 || index >= (int)packs.size()) return;
 
     auto& pack = packs[(size_t)index];
+    processor.setActivePackId(pack.id);
     activePackId   = pack.id;
     activePackName = pack.name;
     activeAccentColor       = pack.accentColor;
@@ -166,11 +190,21 @@ void HALO9PlayerAudioProcessorEditor::setActivePack(int index)
     }
 
     circleLAF.glowColour = activeAccentColor;
+    stepGrid.setAccent(activeAccentColor);
     updateKeyboardHighlight(activeKeyHighlightColor);
     repaint();
 }
 
 void HALO9PlayerAudioProcessorEditor::setActiveKit(int index)
+{
+    auto& kits = processor.getLibrary().getKits();
+    const bool valid = index >= 0 && index < (int)kits.size();
+
+    processor.loadKit(valid ? kits[(size_t)index].id : juce::String());
+    showKit(index);
+}
+
+void HALO9PlayerAudioProcessorEditor::showKit(int index)
 {
     auto& lib = processor.getLibrary();
     auto& kits = lib.getKits();
@@ -213,6 +247,49 @@ void HALO9PlayerAudioProcessorEditor::setActiveKit(int index)
     repaint();
 }
 
+// The processor owns the session (it is what gets saved); the editor only
+// mirrors it — on open, and whenever the host restores a different state.
+void HALO9PlayerAudioProcessorEditor::syncSelectionFromProcessor()
+{
+    shownStateGeneration = processor.getStateGeneration();
+
+    auto& lib = processor.getLibrary();
+    auto indexOf = [](const auto& items, const juce::String& id)
+    {
+        for (size_t i = 0; i < items.size(); ++i)
+            if (items[i].id == id) return (int)i;
+        return -1;
+    };
+
+    const int packIndex = indexOf(lib.getPacks(), processor.getActivePackId());
+    if (packIndex >= 0)
+        libraryPanel.selectedPack = packIndex;
+
+    if (libraryPanel.selectedPack >= 0)
+        setActivePack(libraryPanel.selectedPack);
+
+    stepGrid.setPattern(processor.getStepPattern());
+
+    libraryPanel.selectedKit = indexOf(lib.getKits(), processor.getActiveKitId());
+    const auto sliced = processor.getSlicedLoopRef();
+    if (!sliced.isEmpty())
+        showSlices(juce::File(sliced.path));
+    else
+        showKit(libraryPanel.selectedKit);
+    libraryPanel.repaint();
+}
+
+void HALO9PlayerAudioProcessorEditor::showSlices(const juce::File& loop)
+{
+    activeKitId   = "";
+    activeKitName = loop.getFileNameWithoutExtension();
+
+    for (int i = 0; i < NUM_PADS; ++i)
+        padButtons[i].setButtonText("S" + juce::String(i + 1));
+
+    repaint();
+}
+
 void HALO9PlayerAudioProcessorEditor::updateKeyboardHighlight(juce::Colour color)
 {
     keyboardComponent.setColour(
@@ -413,22 +490,31 @@ void HALO9PlayerAudioProcessorEditor::paint(juce::Graphics& g)
                       (float)textR.getHeight());
     }
 
-    // ── Pad flash overlays (circles) ─────────────────────────────────────
+    // ── Pad glow overlays (circles) — trigger flash + audio peak level ───
     const double now = juce::Time::getMillisecondCounterHiRes();
     for (int i = 0; i < NUM_PADS; ++i)
     {
-        if (padFlashEnd[i] > now)
+        const float flash = padFlashEnd[i] > now ? (float)(padFlashEnd[i] - now) / 120.0f : 0.0f;
+        const float level = juce::jmax(flash, padLevel[i]);
+        if (level > 0.01f)
         {
-            const float alpha = (float)(padFlashEnd[i] - now) / 120.0f;
             auto pb = padButtons[i].getBounds().toFloat().reduced(2.0f);
-            g.setColour(activeAccentColor.withAlpha(juce::jmin(alpha * 0.35f, 0.35f)));
+            g.setColour(activeAccentColor.withAlpha(juce::jmin(level * 0.35f, 0.35f)));
             g.fillEllipse(pb);
         }
     }
 }
 
+// The admin overlay goes over everything, the library panel, step grid and
+// keyboard included
+void HALO9PlayerAudioProcessorEditor::paintOverChildren(juce::Graphics& g)
+{
+    if (libraryPanel.adminMode)
+        paintProfilerOverlay(g);
+}
+
 // ═══════════════════════════════════════════════════════════════════════════════
-//  Layout — Top Hub + disc + pad ring + library + keyboard
+//  Layout — Top Hub + disc + pad ring + library + step grid + keyboard
 // ═══════════════════════════════════════════════════════════════════════════════
 
 void HALO9PlayerAudioProcessorEditor::resized()
@@ -467,6 +553,11 @@ void HALO9PlayerAudioProcessorEditor::resized()
     auto kbArea = r.removeFromBottom(160);
     keyboardComponent.setBounds(kbArea.reduced(kbMargin, 10));
 
+    // Step grid just above it, the SEQ switch to its left
+    auto gridArea = r.removeFromBottom(100).reduced(kbMargin, 6);
+    seqToggle.setBounds(gridArea.removeFromLeft(48).withSizeKeepingCentre(48, 20));
+    stepGrid.setBounds(gridArea);
+
     // Disc fills remaining space
     auto discArea = r.toFloat().reduced(16.0f);
     float diameter = juce::jmin(discArea.getWidth(), discArea.getHeight()) * 0.88f;
@@ -502,14 +593,48 @@ void HALO9PlayerAudioProcessorEditor::resized()
         const int libH = 90;
         int libX = (getWidth() - libW) / 2;
         int discBot = (int)discBounds.getBottom();
-        int kbTop = kbArea.getY();
-        int libY = discBot + (kbTop - discBot - libH) / 2;
+        int gridTop = r.getBottom();
+        int libY = discBot + (gridTop - discBot - libH) / 2;
         libraryPanel.setBounds(libX, libY, libW, libH);
     }
 }
 
 // ═══════════════════════════════════════════════════════════════════════════════
-//  Keyboard — keys 1-8 trigger pads, Cmd+Shift+L toggles admin
+//  Loop file drop — on the disc: slice to pads, elsewhere: loop player
+// ═══════════════════════════════════════════════════════════════════════════════
+
+bool HALO9PlayerAudioProcessorEditor::isInterestedInFileDrag(const juce::StringArray& files)
+{
+    for (auto& f : files)
+        if (juce::File(f).hasFileExtension("wav;aif;aiff;flac;ogg;mp3"))
+            return true;
+    return false;
+}
+
+void HALO9PlayerAudioProcessorEditor::filesDropped(const juce::StringArray& files, int x, int y)
+{
+    for (auto& f : files)
+        if (juce::File(f).hasFileExtension("wav;aif;aiff;flac;ogg;mp3"))
+        {
+            if (discCentre.getDistanceFrom({ (float)x, (float)y }) <= discRadius)
+            {
+                processor.sliceLoopToPads(juce::File(f));
+                libraryPanel.selectedKit = -1;
+                libraryPanel.repaint();
+                showSlices(juce::File(f));
+            }
+            else
+            {
+                processor.loadLoop(juce::File(f));
+            }
+            return;
+        }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  Keyboard — keys 1-8 trigger pads, Cmd+Shift+L toggles admin,
+//  admin: Cmd+Shift+J exports the DSP profile (+ sample-store measurements),
+//         Cmd+Shift+R resets it
 // ═══════════════════════════════════════════════════════════════════════════════
 
 bool HALO9PlayerAudioProcessorEditor::keyPressed(const juce::KeyPress& key)
@@ -519,11 +644,30 @@ bool HALO9PlayerAudioProcessorEditor::keyPressed(const juce::KeyPress& key)
         && key.getModifiers().isShiftDown())
     {
         libraryPanel.adminMode = !libraryPanel.adminMode;
+        processor.setMeasureSampleStorage(libraryPanel.adminMode);
+        if (libraryPanel.adminMode)
+            jobs->resetStats();   // overlay reports from here on
         libraryPanel.repaint();
         repaint();
         return true;
     }
 
+    if (libraryPanel.adminMode
+        && key.getModifiers().isCommandDown()
+        && key.getModifiers().isShiftDown())
+    {
+        if (key.getKeyCode() == 'j' || key.getKeyCode() == 'J')
+        {
+            exportProfile();
+            return true;
+        }
+        if (key.getKeyCode() == 'r' || key.getKeyCode() == 'R')
+        {
+            processor.getProfiler().requestReset();
+            return true;
+        }
+    }
+
     const int code = key.getTextCharacter();
     if (code >= '1' && code <= '8')
     {
@@ -541,24 +685,228 @@ void HALO9PlayerAudioProcessorEditor::triggerPad(int padIndex)
 {
     if (padIndex < 0 || padIndex >= NUM_PADS) return;
 
-    // Visual flash (audio trigger will be added when PadSampler is restored)
+    // Audio: timestamped and queued to processBlock (lock-free)
+    processor.triggerPadFromUI(padIndex, 1.0f);
+
+    // Immediate visual flash — the bridge's voice-start arrives a tick later
     padFlashEnd[padIndex] = juce::Time::getMillisecondCounterHiRes() + 120.0;
     repaint();
 }
 
 // ═══════════════════════════════════════════════════════════════════════════════
-//  Timer — repaint during pad flash animations
+//  Audio activity — drained from the processor's lock-free bridge
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void HALO9PlayerAudioProcessorEditor::syncActivityFromAudio()
+{
+    auto& bridge = processor.getActivityBridge();
+    const double now = juce::Time::getMillisecondCounterHiRes();
+
+    bridge.drainEvents([this, now](const H9ActivityEvent& e)
+    {
+        if (e.type == H9ActivityEvent::voiceStart && juce::isPositiveAndBelow((int)e.pad, NUM_PADS))
+            padFlashEnd[e.pad] = now + 120.0;
+    });
+
+    // Keyboard highlight follows the held-note snapshot, so dropped queue
+    // events can never leave a key stuck
+    auto& kb = processor.getKeyboardState();
+    const auto mask = bridge.getNoteMask();
+    for (int word = 0; word < 2; ++word)
+    {
+        auto changed = mask[(size_t)word] ^ shownNoteMask[(size_t)word];
+        while (changed != 0)
+        {
+            const int bit  = juce::countNumberOfBits((juce::uint64)((changed & (~changed + 1)) - 1));
+            const int note = word * 64 + bit;
+            const auto bitMask = (juce::uint64)1 << bit;
+
+            if ((mask[(size_t)word] & bitMask) != 0) kb.noteOn(1, note, 1.0f);
+            else                                     kb.noteOff(1, note, 0.0f);
+
+            changed &= ~bitMask;
+        }
+    }
+    shownNoteMask = mask;
+
+    for (int i = 0; i < NUM_PADS; ++i)
+        padLevel[i] = juce::jmax(bridge.takePadPeak(i), padLevel[i] * 0.75f);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  Timer — sync audio activity, repaint during pad glow animations
 // ═══════════════════════════════════════════════════════════════════════════════
 
 void HALO9PlayerAudioProcessorEditor::timerCallback()
 {
+    if (processor.getStateGeneration() != shownStateGeneration)
+        syncSelectionFromProcessor();
+
+    syncActivityFromAudio();
+
     const double now = juce::Time::getMillisecondCounterHiRes();
     for (int i = 0; i < NUM_PADS; ++i)
     {
-        if (padFlashEnd[i] > now)
+        if (padFlashEnd[i] > now || padLevel[i] > 0.01f)
         {
             repaint();
             return;
         }
     }
+
+    if (libraryPanel.adminMode)
+        repaint(getProfilerOverlayBounds());
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  Admin — DSP profiler overlay + JSON export
+// ═══════════════════════════════════════════════════════════════════════════════
+
+juce::Rectangle<int> HALO9PlayerAudioProcessorEditor::getProfilerOverlayBounds() const
+{
+    const int rows = H9DspProfiler::numStages + 10;
+    return { 10, (int)hubBounds.getBottom() + 6, 250, 14 + rows * 11 };
+}
+
+void HALO9PlayerAudioProcessorEditor::paintProfilerOverlay(juce::Graphics& g)
+{
+    auto& profiler = processor.getProfiler();
+    auto area = getProfilerOverlayBounds().toFloat();
+
+    g.setColour(juce::Colour(0xff0d1117).withAlpha(0.88f));
+    g.fillRoundedRectangle(area, 6.0f);
+    g.setColour(juce::Colour(0xffff6b6b).withAlpha(0.35f));
+    g.drawRoundedRectangle(area, 6.0f, 0.8f);
+
+    auto rows = area.reduced(8.0f, 6.0f);
+    const float rowH = 11.0f;
+    const float cols[] = { 0.0f, 62.0f, 110.0f, 158.0f, 206.0f };
+
+    auto drawRow = [&](const juce::String& a, const juce::String& b, const juce::String& c,
+                       const juce::String& d, const juce::String& e)
+    {
+        auto r = rows.removeFromTop(rowH);
+        const juce::String cells[] = { a, b, c, d, e };
+        for (int i = 0; i < 5; ++i)
+            g.drawText(cells[i], juce::Rectangle<float>(r.getX() + cols[i], r.getY(), 48.0f, rowH),
+                       i == 0 ? juce::Justification::left : juce::Justification::right, false);
+    };
+
+    g.setFont(juce::Font(8.0f, juce::Font::bold));
+    g.setColour(juce::Colour(0xffff6b6b).withAlpha(0.8f));
+    drawRow("DSP  " + juce::String(profiler.getDeadlineUs() / 1000.0, 2) + "ms",
+            "p50 us", "p99 us", "max us", "p99 %");
+
+    g.setFont(juce::Font(8.0f));
+    for (int i = 0; i < H9DspProfiler::numStages; ++i)
+    {
+        const auto st = profiler.getStats((H9DspProfiler::Stage)i);
+        const bool hot = st.p99DeadlineRatio > 0.5;
+
+        g.setColour(hot ? juce::Colour(0xffff6b6b) : H9::text.withAlpha(0.8f));
+        drawRow(H9DspProfiler::getStageName(i),
+                juce::String(st.p50Us, 1),
+                juce::String(st.p99Us, 1),
+                juce::String(st.maxUs, 1),
+                juce::String(st.p99DeadlineRatio * 100.0, 1));
+    }
+
+    // Disk streaming: active streams, underrun events / frames, MB read
+    const auto disk = processor.getDiskStreamStats();
+    g.setColour(disk.underrunEvents > 0 ? juce::Colour(0xffff6b6b) : H9::text.withAlpha(0.8f));
+    drawRow("disk",
+            juce::String(disk.activeStreams) + " str",
+            juce::String(disk.underrunEvents) + " xr",
+            juce::String(disk.underrunFrames) + " fr",
+            juce::String((double)disk.bytesRead / (1024.0 * 1024.0), 1) + "MB");
+
+    // Load guard: current quality tier, smoothed load, step-downs so far
+    auto& guard = processor.getLoadGuard();
+    g.setColour(guard.getTier() != H9LoadGuard::full ? juce::Colour(0xffff6b6b) : H9::text.withAlpha(0.8f));
+    drawRow("guard",
+            H9LoadGuard::getTierName(guard.getTier()),
+            juce::String(guard.getLoad() * 100.0, 0) + "%",
+            juce::String(guard.getNumStepDowns()) + " dn",
+            {});
+
+    // Pack impulse response: length and partitions — what the reverb
+    // stage's cost above scales with when it is in use
+    const auto ir = processor.getConvolutionInfo();
+    g.setColour(H9::text.withAlpha(ir.seconds > 0.0 ? 0.8f : 0.4f));
+    drawRow("ir",
+            ir.seconds > 0.0 ? juce::String(ir.seconds, 2) + " s" : juce::String("none"),
+            juce::String(ir.partitions) + " pt",
+            juce::String(ir.segments) + " seg",
+            {});
+
+    // Loop: its tempo (n = from the file name), the stretch to the host's
+    // and the furthest a grain started from its bar position last second
+    const auto& loop = processor.getLoopPlayer();
+    const auto loopInfo = loop.getInfo();
+    g.setColour(H9::text.withAlpha(loopInfo.seconds > 0.0 ? 0.8f : 0.4f));
+    drawRow("loop",
+            loopInfo.seconds > 0.0 ? juce::String(loopInfo.bpm, 1) + (loopInfo.tempoFromName ? " n" : "") : juce::String("none"),
+            juce::String(loopInfo.beats, 0) + " bt",
+            "x" + juce::String(loop.getStretch(), 2),
+            juce::String(loop.getDriftMs(), 1) + "ms");
+
+    // Sliced pads: slices kept of the onsets found, and what finding them took
+    const auto slices = processor.getSliceInfo();
+    g.setColour(H9::text.withAlpha(slices.slices > 0 ? 0.8f : 0.4f));
+    drawRow("slice",
+            slices.slices > 0 ? juce::String(slices.slices) + " sl" : juce::String("none"),
+            juce::String(slices.onsets) + " on",
+            juce::String(slices.analysisMs, 1) + "ms",
+            {});
+
+    // Texture pads: grains sounding, most at once, turned away by full pools
+    const auto grains = processor.getGrainStats();
+    g.setColour(grains.dropped > 0 ? juce::Colour(0xffff6b6b) : H9::text.withAlpha(grains.peak > 0 ? 0.8f : 0.4f));
+    drawRow("grains",
+            juce::String(grains.active) + " gr",
+            juce::String(grains.peak) + " pk",
+            juce::String((juce::int64)grains.dropped) + " drop",
+            {});
+
+    // Step sequencer: hits played, transport jumps it restarted on, hits
+    // over a block's event list
+    const auto seq = processor.getSequencerStats();
+    g.setColour(seq.dropped > 0 ? juce::Colour(0xffff6b6b) : H9::text.withAlpha(seq.events > 0 ? 0.8f : 0.4f));
+    drawRow("seq",
+            juce::String((juce::int64)seq.events) + " hit",
+            juce::String((juce::int64)seq.jumps) + " jmp",
+            juce::String((juce::int64)seq.dropped) + " drop",
+            {});
+
+    // Job system (process-wide): busy / threads, queued, saturation, worst
+    // queue wait, one row per class
+    for (auto p : { H9JobSystem::Priority::user, H9JobSystem::Priority::background })
+    {
+        const auto st = jobs->getStats(p);
+        g.setColour(st.queued > st.threads ? juce::Colour(0xffff6b6b) : H9::text.withAlpha(0.8f));
+        drawRow(p == H9JobSystem::Priority::user ? "jobs usr" : "jobs bg",
+                juce::String(st.busy) + "/" + juce::String(st.threads),
+                juce::String(st.queued) + " q",
+                juce::String(st.saturation * 100.0, 0) + "%",
+                juce::String(st.maxWaitMs, 0) + "ms");
+    }
+}
+
+void HALO9PlayerAudioProcessorEditor::exportProfile()
+{
+    auto dir = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+                   .getChildFile("HALO9/Profiles");
+    dir.createDirectory();
+
+    auto file = dir.getChildFile("halo9-dsp-"
+                                 + juce::Time::getCurrentTime().formatted("%Y%m%d-%H%M%S")
+                                 + ".json");
+    file.replaceWithText(processor.getProfiler().toJson());
+
+    // Sample-store measurements for the current kit (taken on load while
+    // admin mode is on)
+    auto storage = processor.getSampleStorageReport();
+    if (storage.isNotEmpty())
+        file.getSiblingFile(file.getFileNameWithoutExtension().replace("halo9-dsp-", "halo9-storage-")
+                            + ".json").replaceWithText(storage);
 }
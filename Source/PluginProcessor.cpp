@@ -1,5 +1,6 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "Core/H9RealtimeSanitizer.h"
 
 HALO9PlayerAudioProcessor::HALO9PlayerAudioProcessor()
     : AudioProcessor(BusesProperties()
@@ -7,13 +8,92 @@ HALO9PlayerAudioProcessor::HALO9PlayerAudioProcessor()
         .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
       apvts(*this, nullptr, "Parameters", createParameterLayout())
 {
+    apvtsTrace.end();
+    H9_TRACE_SCOPE("processor constructor body");
+
+    masterVolumeParam = apvts.getRawParameterValue("master_volume");
+    cutoffParam       = apvts.getRawParameterValue("lowpass_cutoff");
+    atmosphereParam   = apvts.getRawParameterValue("atmosphere");
+    interpRealtimeParam = apvts.getRawParameterValue("interp_realtime");
+    interpOfflineParam  = apvts.getRawParameterValue("interp_offline");
+    voiceThreadsParam   = apvts.getRawParameterValue("voice_threads");
+    reverbLinesParam    = apvts.getRawParameterValue("reverb_lines");
+    reverbTypeParam     = apvts.getRawParameterValue("reverb_type");
+    tapeEnabledParam    = apvts.getRawParameterValue("tape_enabled");
+    tapeDriveParam      = apvts.getRawParameterValue("tape_drive");
+    tapeWowParam        = apvts.getRawParameterValue("tape_wow");
+    tapeFlutterParam    = apvts.getRawParameterValue("tape_flutter");
+    tapeOversamplingParam = apvts.getRawParameterValue("tape_oversampling");
+    loopVolumeParam     = apvts.getRawParameterValue("loop_volume");
+    loopSyncParam       = apvts.getRawParameterValue("loop_sync");
+    textureDensityParam = apvts.getRawParameterValue("texture_density");
+    textureSizeParam    = apvts.getRawParameterValue("texture_size");
+    textureScanParam    = apvts.getRawParameterValue("texture_scan");
+    textureSprayParam   = apvts.getRawParameterValue("texture_spray");
+    textureSpreadParam  = apvts.getRawParameterValue("texture_spread");
+    textureWindowParam  = apvts.getRawParameterValue("texture_window");
+    seqEnabledParam     = apvts.getRawParameterValue("seq_enabled");
+
+    for (int pad = 0; pad < NUM_PADS; ++pad)
+    {
+        const juce::String id = "pad" + juce::String(pad + 1) + "_";
+        auto& p = padToneParams[(size_t)pad];
+        p.attack    = apvts.getRawParameterValue(id + "attack");
+        p.decay     = apvts.getRawParameterValue(id + "decay");
+        p.sustain   = apvts.getRawParameterValue(id + "sustain");
+        p.filter    = apvts.getRawParameterValue(id + "filter");
+        p.cutoff    = apvts.getRawParameterValue(id + "cutoff");
+        p.resonance = apvts.getRawParameterValue(id + "resonance");
+    }
+
+    sampleLoader.onLoaded = [this](H9SampleLoader::Result&& result)
+    {
+        auto report = makeStorageReport(result.storage);
+        {
+            const juce::ScopedLock sl(sessionLock);
+            if (!sliceRef.isEmpty())
+                return;   // superseded by slicing a loop
+
+            padRefs = result.refs;
+            if (report.isNotEmpty())
+                sampleStorageReport = report;
+        }
+        padSampler.setSampleSet(std::move(result.set));
+    };
+
+    loopSlicer.onSliced = [this](H9LoopSlicer::Result&& result)
+    {
+        {
+            const juce::ScopedLock sl(sessionLock);
+            if (sliceRef.isEmpty())
+                return;   // a kit was loaded meanwhile
+
+            sliceRef = result.ref;
+        }
+        padSampler.setSampleSet(std::move(result.set));
+    };
+
+    loopPlayer.onLoaded = [this](const H9SampleRef& ref)
+    {
+        const juce::ScopedLock sl(sessionLock);
+        loopRef = ref;
+    };
+
     // Load library data (packs/kits manifests)
-    auto libRoot = H9Library::findLibraryRoot();
+    auto libRoot = H9Library::findLibraryRoot();   // traced inside H9Library
     if (libRoot.isDirectory())
         library.loadFromDirectory(libRoot);
+
+    updateVoiceWorkers();
+
+    // Frees sample sets the audio thread has retired
+    startTimer(1000);
 }
 
-HALO9PlayerAudioProcessor::~HALO9PlayerAudioProcessor() = default;
+HALO9PlayerAudioProcessor::~HALO9PlayerAudioProcessor()
+{
+    stopTimer();
+}
 
 juce::AudioProcessorValueTreeState::ParameterLayout
 HALO9PlayerAudioProcessor::createParameterLayout() const
@@ -36,6 +116,117 @@ HALO9PlayerAudioProcessor::createParameterLayout() const
         "synth_level", "Synth Level",
         juce::NormalisableRange<float>(0.0f, 1.0f), 0.5f));
 
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        "loop_volume", "Loop Volume",
+        juce::NormalisableRange<float>(0.0f, 1.0f), 0.8f));
+
+    // Resampling quality for pitched / rate-converted pads — a setup choice,
+    // not a performance control, so hidden from automation. Bounces use the
+    // offline tier.
+    const juce::StringArray interpChoices { "Linear", "Cubic", "Sinc" };
+    const auto notAutomatable = juce::AudioParameterChoiceAttributes().withAutomatable(false);
+
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "interp_realtime", "Interpolation (Realtime)", interpChoices, 1, notAutomatable));
+
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "interp_offline", "Interpolation (Offline)", interpChoices, 2, notAutomatable));
+
+    // Threads rendering pad voices, counting the host's audio thread
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "voice_threads", "Voice Threads", juce::StringArray { "Off", "2", "4", "8", "16" }, 0, notAutomatable));
+
+    // Delay lines in the Atmosphere reverb — density of the tail against CPU
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "reverb_lines", "Reverb Lines", juce::StringArray { "4", "8", "16" }, 1, notAutomatable));
+
+    // Pack IR: convolve with the active pack's impulse response, falling
+    // back to the algorithmic reverb when the pack has none
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "reverb_type", "Reverb Type", juce::StringArray { "Algorithmic", "Pack IR" }, 1, notAutomatable));
+
+    // Host: the loop follows the host's tempo and bar position, stretched
+    // to fit. Off: it plays at its own tempo.
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "loop_sync", "Loop Sync", juce::StringArray { "Off", "Host" }, 1, notAutomatable));
+
+    // Tape stage after the lowpass — lo-fi packs switch it on and set it up
+    // from their manifest
+    layout.add(std::make_unique<juce::AudioParameterBool>("tape_enabled", "Tape", false));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        "tape_drive", "Tape Drive", juce::NormalisableRange<float>(0.0f, 1.0f), 0.3f));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        "tape_wow", "Tape Wow", juce::NormalisableRange<float>(0.0f, 1.0f), 0.3f));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        "tape_flutter", "Tape Flutter", juce::NormalisableRange<float>(0.0f, 1.0f), 0.2f));
+
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "tape_oversampling", "Tape Oversampling", juce::StringArray { "2x", "4x" }, 0, notAutomatable));
+
+    // Grain clouds on the active pack's texture pads (H9GranularEngine)
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        "texture_density", "Texture Density",
+        juce::NormalisableRange<float>(1.0f, 2000.0f, 0.0f, 0.3f), 60.0f));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        "texture_size", "Texture Grain Size",
+        juce::NormalisableRange<float>(H9GranularEngine::minSizeMs, 500.0f, 0.0f, 0.5f), 120.0f));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        "texture_scan", "Texture Scan",
+        juce::NormalisableRange<float>(0.05f, 2.0f, 0.0f, 0.5f), 0.5f));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        "texture_spray", "Texture Spray",
+        juce::NormalisableRange<float>(0.0f, 1.0f), 0.2f));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        "texture_spread", "Texture Spread",
+        juce::NormalisableRange<float>(0.0f, 1.0f), 0.5f));
+
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "texture_window", "Texture Window", juce::StringArray { "Hann", "Gauss", "Tukey" }, 0));
+
+    // Internal step sequencer (H9StepSequencer): plays the session's
+    // pattern on the pads while the host transport runs
+    layout.add(std::make_unique<juce::AudioParameterBool>("seq_enabled", "Sequencer", false));
+
+    // Per-pad tone: amp envelope and filter on every voice of the pad. The
+    // defaults leave a pad untouched (and skip the processing entirely).
+    const juce::StringArray filterChoices { "Off", "Lowpass", "Bandpass", "Highpass" };
+
+    for (int pad = 1; pad <= NUM_PADS; ++pad)
+    {
+        const juce::String id   = "pad" + juce::String(pad) + "_";
+        const juce::String name = "Pad " + juce::String(pad) + " ";
+
+        layout.add(std::make_unique<juce::AudioParameterFloat>(
+            id + "attack", name + "Attack",
+            juce::NormalisableRange<float>(0.0f, 500.0f, 0.0f, 0.4f), 0.0f));
+
+        layout.add(std::make_unique<juce::AudioParameterFloat>(
+            id + "decay", name + "Decay",
+            juce::NormalisableRange<float>(10.0f, 10000.0f, 0.0f, 0.3f), 300.0f));
+
+        layout.add(std::make_unique<juce::AudioParameterFloat>(
+            id + "sustain", name + "Sustain",
+            juce::NormalisableRange<float>(0.0f, 1.0f), 1.0f));
+
+        layout.add(std::make_unique<juce::AudioParameterChoice>(
+            id + "filter", name + "Filter", filterChoices, 0));
+
+        layout.add(std::make_unique<juce::AudioParameterFloat>(
+            id + "cutoff", name + "Cutoff",
+            juce::NormalisableRange<float>(20.0f, 20000.0f, 0.0f, 0.25f), 20000.0f));
+
+        layout.add(std::make_unique<juce::AudioParameterFloat>(
+            id + "resonance", name + "Resonance",
+            juce::NormalisableRange<float>(0.0f, 1.0f), 0.0f));
+    }
+
     return layout;
 }
 
@@ -43,31 +234,784 @@ void HALO9PlayerAudioProcessor::prepareToPlay(double sr, int blockSize)
 {
     currentSampleRate = sr;
     currentBlockSize = blockSize;
+
+    padSampler.prepare(sr, blockSize);
+    lastBlockStartMs = 0.0;
+
+    // Pads are converted to the host rate off-thread — redo it if that changed
+    if (loaderSampleRate.exchange(sr) != sr)
+        reloadSamples();
+
+    padBus.setSize(2, juce::jmax(1, blockSize));
+    loopPlayer.prepare(sr, blockSize);
+    sequencer.prepare(sr);
+
+    const juce::dsp::ProcessSpec spec { sr, (juce::uint32)juce::jmax(1, blockSize), 2 };
+    lowpass.prepare(spec);
+    lowpass.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
+    tape.prepare(sr, blockSize);
+    setLatencySamples(tape.getLatencySamples());   // on or off, so it never changes under the host
+    reverb.prepare(sr);
+    convolution.prepare(sr, blockSize);
+    usingConvolution = false;
+
+    widthAmount.reset(sr, 0.05);
+    masterGain.reset(sr, 0.02);
+    masterGain.setCurrentAndTargetValue(masterVolumeParam->load());
+
+    profiler.prepare(sr, blockSize);
+    loadGuard.prepare(sr, blockSize);
+}
+
+void HALO9PlayerAudioProcessor::releaseResources()
+{
+    loopPlayer.reset();
+    sequencer.reset();
+    lowpass.reset();
+    tape.reset();
+    reverb.reset();
+    convolution.reset();
+}
+
+// The Atmosphere reverb's tail: the FDN's decay at the current room size,
+// or the pack's IR when it is selected and loaded. The load guard can drop
+// back to the FDN at any block, so the IR case reports the longer of the
+// two. Silent while Atmosphere is at zero.
+double HALO9PlayerAudioProcessor::getTailLengthSeconds() const
+{
+    const float atmos = atmosphereParam->load();
+    if (atmos <= 0.0f)
+        return 0.0;
+
+    double tail = H9FdnReverb::getDecaySeconds(atmosphereRoomSize * atmos);
+    if (juce::roundToInt(reverbTypeParam->load()) == 1)
+        tail = juce::jmax(tail, convolution.getTailSeconds());
+
+    return tail;
+}
+
+void HALO9PlayerAudioProcessor::timerCallback()
+{
+    padSampler.collectGarbage();
+    convolution.collectGarbage();
+    loopPlayer.collectGarbage();
+
+    {
+        // Patterns may be published from the host's thread by setStateInformation
+        const juce::ScopedLock sl(sessionLock);
+        sequencer.collectGarbage();
+    }
+
+    updateVoiceWorkers();
+}
+
+void HALO9PlayerAudioProcessor::updateVoiceWorkers()
+{
+    const int threads = 1 << juce::jlimit(0, 4, juce::roundToInt(voiceThreadsParam->load()));
+
+    // Retired pools stop their threads here, off the audio thread
+    voiceWorkers.collectGarbage();
+
+    if (threads != voiceWorkerThreads)
+    {
+        voiceWorkers.publish(std::make_unique<H9RealtimeWorkers>(threads));
+        voiceWorkerThreads = threads;
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  Kit loading (message thread)
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void HALO9PlayerAudioProcessor::loadKit(const juce::String& kitId)
+{
+    {
+        const juce::ScopedLock sl(sessionLock);
+        activeKitId = kitId;
+        padRefs = {};
+        sliceRef = {};
+    }
+    loopSlicer.cancel();
+    requestSampleLoad(kitId, {});
+}
+
+void HALO9PlayerAudioProcessor::requestSampleLoad(const juce::String& kitId,
+                                                  const std::array<H9SampleRef, NUM_PADS>& refs)
+{
+    H9SampleLoader::Request request;
+    request.refs        = refs;
+    request.libraryRoot = library.getRoot();
+    request.targetSampleRate = loaderSampleRate.load();
+
+    request.measureStorage   = measureSampleStorage.load();
+
+    if (auto* kit = library.findKit(kitId))
+    {
+        request.storage = H9SampleStore::parseFormat(kit->storage);
+        request.preloadFrames = kit->preloadFrames;
+
+        const int n = juce::jmin(NUM_PADS, (int)kit->pads.size());
+        for (int i = 0; i < n; ++i)
+        {
+            auto& info = kit->pads[(size_t)i];
+            request.kitFiles[(size_t)i] = kit->rootDir.getChildFile(info.file);
+            request.gains[(size_t)i]    = info.gain;
+            request.chokeGroups[(size_t)i] = info.chokeGroup;
+            request.tunes[(size_t)i]       = info.tune;
+            request.velocityToPitch[(size_t)i] = info.velocityToPitch;
+        }
+    }
+
+    sampleLoader.load(std::move(request));
+}
+
+void HALO9PlayerAudioProcessor::sliceLoopToPads(const juce::File& file)
+{
+    if (!file.existsAsFile())
+        return;
+
+    {
+        const juce::ScopedLock sl(sessionLock);
+        activeKitId = {};
+        padRefs     = {};
+        sliceRef    = { file.getFullPathName(), {}, file.getSize() };
+    }
+    loopSlicer.slice(file, loaderSampleRate.load());
+}
+
+H9SampleRef HALO9PlayerAudioProcessor::getSlicedLoopRef() const
+{
+    const juce::ScopedLock sl(sessionLock);
+    return sliceRef;
+}
+
+void HALO9PlayerAudioProcessor::reloadSamples()
+{
+    juce::String kitId;
+    std::array<H9SampleRef, NUM_PADS> refs;
+    H9SampleRef slices;
+    {
+        const juce::ScopedLock sl(sessionLock);
+        kitId  = activeKitId;
+        refs   = padRefs;
+        slices = sliceRef;
+    }
+
+    if (!slices.isEmpty())
+    {
+        loopSlicer.slice(slices, library.getRoot(), loaderSampleRate.load());
+        return;
+    }
+
+    const bool anyRef = std::any_of(refs.begin(), refs.end(),
+                                    [](const H9SampleRef& r) { return !r.isEmpty(); });
+    if (kitId.isNotEmpty() || anyRef)
+        requestSampleLoad(kitId, refs);
+}
+
+void HALO9PlayerAudioProcessor::setMeasureSampleStorage(bool shouldMeasure)
+{
+    if (measureSampleStorage.exchange(shouldMeasure) != shouldMeasure && shouldMeasure)
+        reloadSamples();
+}
+
+juce::String HALO9PlayerAudioProcessor::getSampleStorageReport() const
+{
+    const juce::ScopedLock sl(sessionLock);
+    return sampleStorageReport;
+}
+
+juce::String HALO9PlayerAudioProcessor::makeStorageReport(
+    const std::vector<H9SampleStore::Measurement>& measurements) const
+{
+    if (measurements.empty()) return {};
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("kit", getActiveKitId());
+
+    juce::Array<juce::var> formats;
+    for (auto& m : measurements)
+    {
+        auto* o = new juce::DynamicObject();
+        o->setProperty("format",           H9SampleStore::getFormatName(m.format));
+        o->setProperty("bytes",            (juce::int64)m.bytes);
+        o->setProperty("ratio",            m.ratio);
+        o->setProperty("decodeNsPerFrame", m.decodeNsPerFrame);
+        o->setProperty("maxError",         m.maxError);
+        formats.add(juce::var(o));
+    }
+    root->setProperty("formats", formats);
+
+    return juce::JSON::toString(juce::var(root));
+}
+
+void HALO9PlayerAudioProcessor::setActivePackId(const juce::String& packId)
+{
+    bool changed = false;
+    {
+        const juce::ScopedLock sl(sessionLock);
+        changed = activePackId != packId;
+        activePackId = packId;
+    }
+    loadPackImpulse(packId);
+    applyPackRoles(packId);
+
+    // Only on a real change: the editor re-selects the active pack when it
+    // opens, which mustn't undo the user's tape settings
+    if (changed)
+        applyPackTape(packId);
+}
+
+void HALO9PlayerAudioProcessor::loadPackImpulse(const juce::String& packId)
+{
+    const auto* pack = library.findPack(packId);
+    if (pack != nullptr && pack->impulseFile.isNotEmpty())
+        convolution.load(pack->rootDir.getChildFile(pack->impulseFile), pack->impulseGain);
+    else
+        convolution.load({}, 1.0f);
+}
+
+// Pads the pack's padBank gives the "texture" role play grain clouds
+void HALO9PlayerAudioProcessor::applyPackRoles(const juce::String& packId)
+{
+    int mask = 0;
+    if (const auto* pack = library.findPack(packId))
+        for (const auto& info : pack->padBank)
+        {
+            const int pad = info.pad.getTrailingIntValue() - 1;
+            if (info.role == "texture" && juce::isPositiveAndBelow(pad, NUM_PADS))
+                mask |= 1 << pad;
+        }
+
+    texturePadMask.store(mask, std::memory_order_relaxed);
 }
 
-void HALO9PlayerAudioProcessor::releaseResources() {}
+void HALO9PlayerAudioProcessor::applyPackTape(const juce::String& packId)
+{
+    const auto* pack = library.findPack(packId);
+    const auto tapeInfo = pack != nullptr ? pack->tape : H9TapeInfo {};
+
+    auto set = [this](const char* id, float value)
+    {
+        if (auto* p = apvts.getParameter(id))
+            p->setValueNotifyingHost(p->convertTo0to1(value));
+    };
+
+    set("tape_enabled", tapeInfo.enabled ? 1.0f : 0.0f);
+    if (!tapeInfo.enabled)
+        return;
+
+    set("tape_drive",        tapeInfo.drive);
+    set("tape_wow",          tapeInfo.wow);
+    set("tape_flutter",      tapeInfo.flutter);
+    set("tape_oversampling", tapeInfo.oversampling == 4 ? 1.0f : 0.0f);
+}
+
+void HALO9PlayerAudioProcessor::loadLoop(const juce::File& file)
+{
+    {
+        const juce::ScopedLock sl(sessionLock);
+        loopRef = file.existsAsFile() ? H9SampleRef { file.getFullPathName(), {}, file.getSize() } : H9SampleRef {};
+    }
+    loopPlayer.load(file);
+}
+
+juce::String HALO9PlayerAudioProcessor::getActivePackId() const
+{
+    const juce::ScopedLock sl(sessionLock);
+    return activePackId;
+}
+
+juce::String HALO9PlayerAudioProcessor::getActiveKitId() const
+{
+    const juce::ScopedLock sl(sessionLock);
+    return activeKitId;
+}
+
+H9SampleRef HALO9PlayerAudioProcessor::getPadSampleRef(int pad) const
+{
+    const juce::ScopedLock sl(sessionLock);
+    return juce::isPositiveAndBelow(pad, NUM_PADS) ? padRefs[(size_t)pad] : H9SampleRef {};
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  Step sequencer
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void HALO9PlayerAudioProcessor::setStepPattern(const H9StepPattern& pattern)
+{
+    const juce::ScopedLock sl(sessionLock);
+    stepPattern = pattern;
+    sequencer.setPattern(pattern);
+}
+
+H9StepPattern HALO9PlayerAudioProcessor::getStepPattern() const
+{
+    const juce::ScopedLock sl(sessionLock);
+    return stepPattern;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  UI pad triggers
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void HALO9PlayerAudioProcessor::triggerPadFromUI(int pad, float velocity)
+{
+    if (!juce::isPositiveAndBelow(pad, NUM_PADS)) return;
+    padTriggers.push({ pad, velocity, juce::Time::getMillisecondCounterHiRes() });
+}
+
+void HALO9PlayerAudioProcessor::startPad(int pad, float velocity, int sampleOffset,
+                                         float semitones) noexcept
+{
+    padSampler.startVoice(pad, velocity, sampleOffset, semitones);
+    keysPad = pad;
+
+    // Pads glow on every hit, even when the slot has no sample loaded
+    activityBridge.voiceStarted(pad, PAD_BASE_NOTE + pad, velocity);
+}
 
 void HALO9PlayerAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                             juce::MidiBuffer& midiMessages)
 {
-    auto masterVol = apvts.getRawParameterValue("master_volume")->load();
+    H9_RT_SCOPE;
+    juce::ScopedNoDenormals noDenormals;
+    const int numSamples = buffer.getNumSamples();
+    if (numSamples <= 0) return;
+
+    using Stage = H9DspProfiler::Stage;
+    profiler.beginBlock();
+    H9DspProfiler::ScopedStage totalTimer(profiler, Stage::total);
+
+    // Quality for this block: the guard's tier reflects the blocks before
+    const auto guardTier = loadGuard.beginBlock(!isNonRealtime());
+
+    padSampler.beginBlock();
+
+    {
+        bool workersChanged = false;
+        voiceWorkers.acquire(workersChanged);
+
+        int interp = juce::roundToInt((isNonRealtime() ? interpOfflineParam : interpRealtimeParam)->load());
+        if (guardTier >= H9LoadGuard::lowerInterp)
+            interp = juce::jmax(0, interp - 1);
+
+        padSampler.setInterpolation((H9VoiceKernels::Interp)((int)H9VoiceKernels::Interp::linear + interp));
+        padSampler.setVoiceLimit(guardTier >= H9LoadGuard::fewerVoices ? H9PadSampler::maxVoices / 2
+                                                                       : H9PadSampler::maxVoices);
+
+        // Pad tones, snapshotted once per block
+        for (int pad = 0; pad < NUM_PADS; ++pad)
+        {
+            const auto& p = padToneParams[(size_t)pad];
+
+            H9VoiceDsp::Tone tone;
+            tone.attackMs  = p.attack->load();
+            tone.decayMs   = p.decay->load();
+            tone.sustain   = p.sustain->load();
+            tone.filter    = (H9VoiceDsp::Filter)juce::jlimit(0, H9VoiceDsp::numFilters - 1,
+                                                              juce::roundToInt(p.filter->load()));
+            tone.cutoffHz  = p.cutoff->load();
+            tone.resonance = p.resonance->load();
+            padSampler.setPadTone(pad, tone);
+        }
+
+        const int textures = texturePadMask.load(std::memory_order_relaxed);
+        for (int pad = 0; pad < NUM_PADS; ++pad)
+            padSampler.setPadTexture(pad, (textures >> pad) & 1);
+
+        H9GranularEngine::Settings grains;
+        grains.density = textureDensityParam->load();
+        grains.sizeMs  = textureSizeParam->load();
+        grains.scan    = textureScanParam->load();
+        grains.spray   = textureSprayParam->load();
+        grains.spread  = textureSpreadParam->load();
+        grains.window  = (H9GranularEngine::Window)juce::jlimit(0, H9GranularEngine::numWindows - 1,
+                                                                juce::roundToInt(textureWindowParam->load()));
+        padSampler.setTextureSettings(grains);
+    }
+
+    H9LoopPlayer::Transport loopTransport;
+    H9StepSequencer::Transport stepTransport;
+    readTransport(loopTransport, stepTransport);
+
+    {
+        H9DspProfiler::ScopedStage t(profiler, Stage::midi);
+
+        if (seqEnabledParam->load() >= 0.5f)
+            sequencer.schedule(stepTransport, numSamples);
+        else
+            sequencer.reset();
+
+        handleTriggersAndMidi(midiMessages, numSamples);
+    }
+
+    renderPads(buffer, numSamples);
+
+    {
+        H9DspProfiler::ScopedStage t(profiler, Stage::loop);
+        loopPlayer.beginBlock();
+        loopPlayer.setLevel(loopVolumeParam->load());
+        loopPlayer.setSynced(juce::roundToInt(loopSyncParam->load()) == 1);
+        loopPlayer.process(buffer, numSamples, loopTransport);
+    }
+
+    for (int pad = 0; pad < NUM_PADS; ++pad)
+        activityBridge.publishPadPeak(pad, padSampler.getPadPeak(pad));
 
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        buffer.applyGain(ch, 0, buffer.getNumSamples(), masterVol);
+    // ── Atmosphere macro ─────────────────────────────────────────────────
+    const float atmos = atmosphereParam->load();
 
-    // Update keyboard state from incoming MIDI
+    {
+        H9DspProfiler::ScopedStage t(profiler, Stage::width);
+        widthAmount.setTargetValue(1.0f + 1.2f * atmos);          // ×1.0 → ×2.2
+        applyWidth(buffer, numSamples);
+    }
+
+    juce::dsp::AudioBlock<float> block(buffer);
+    juce::dsp::ProcessContextReplacing<float> context(block);
+
+    {
+        H9DspProfiler::ScopedStage t(profiler, Stage::lowpass);
+        const float cutoff = cutoffParam->load() * (1.0f - 0.5f * atmos);   // up to −50%
+        lowpass.setCutoffFrequency(juce::jmin(cutoff, (float)currentSampleRate * 0.45f));
+        lowpass.process(context);
+    }
+
+    {
+        H9DspProfiler::ScopedStage t(profiler, Stage::tape);
+
+        // The guard's cheap tier holds the tape at 2×
+        H9TapeStage::Settings s;
+        s.enabled = tapeEnabledParam->load() >= 0.5f;
+        s.drive   = tapeDriveParam->load();
+        s.wow     = tapeWowParam->load();
+        s.flutter = tapeFlutterParam->load();
+        s.oversampling = juce::roundToInt(tapeOversamplingParam->load()) == 1 && guardTier < H9LoadGuard::cheapReverb
+                       ? H9TapeStage::Oversampling::x4 : H9TapeStage::Oversampling::x2;
+        tape.setSettings(s);
+        tape.process(buffer, numSamples);
+    }
+
+    {
+        H9DspProfiler::ScopedStage t(profiler, Stage::reverb);
+
+        auto* left  = buffer.getWritePointer(0);
+        auto* right = buffer.getNumChannels() > 1 ? buffer.getWritePointer(1) : nullptr;
+
+        // The pack's IR when it has one and it is selected; the guard's
+        // cheap tier always runs the FDN at 4 lines. Switching, or changing
+        // the line count, clears the tail being left — a short gap rather
+        // than a burst of stale reverb on the way back.
+        const bool irReady = convolution.beginBlock();
+        const bool useConvolution = irReady && guardTier < H9LoadGuard::cheapReverb
+                                 && juce::roundToInt(reverbTypeParam->load()) == 1;
+        if (useConvolution != usingConvolution)
+        {
+            if (useConvolution) reverb.reset();
+            else                convolution.reset();
+            usingConvolution = useConvolution;
+        }
+
+        if (useConvolution)
+        {
+            convolution.setWetLevel(0.45f * atmos);
+            convolution.process(left, right, numSamples);
+        }
+        else
+        {
+            const int lines = guardTier >= H9LoadGuard::cheapReverb
+                            ? 4 : 4 << juce::jlimit(0, 2, juce::roundToInt(reverbLinesParam->load()));
+            reverb.setLines(lines);
+            reverb.setParameters(atmosphereRoomSize * atmos, 0.45f * atmos);
+            reverb.process(left, right, numSamples);
+        }
+    }
+
+    {
+        H9DspProfiler::ScopedStage t(profiler, Stage::gain);
+        masterGain.setTargetValue(masterVolumeParam->load());
+        masterGain.applyGain(buffer, numSamples);
+    }
+
+    loadGuard.endBlock(numSamples);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  processBlock stages
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void HALO9PlayerAudioProcessor::handleTriggersAndMidi(juce::MidiBuffer& midiMessages,
+                                                      int numSamples) noexcept
+{
+    // ── UI pad triggers ──────────────────────────────────────────────────
+    // The previous callback period maps onto this block: a hit that arrived
+    // x ms after the last block started plays x ms into this one. Latency is
+    // then a constant one block instead of jittering by up to a block.
+    // Drained here and started in sample order with everything else below;
+    // the queue has one producer, so offsets never go backwards.
+    struct UiHit { int pad; float velocity; int sampleOffset; };
+    std::array<UiHit, 64> uiHits;
+    int numUiHits = 0;
+
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    {
+        PadTrigger t;
+        while (numUiHits < (int)uiHits.size() && padTriggers.pop(t))
+        {
+            int offset = 0;
+            if (lastBlockStartMs > 0.0)
+                offset = juce::jlimit(0, numSamples - 1,
+                                      (int)((t.timeMs - lastBlockStartMs) * currentSampleRate * 0.001));
+
+            uiHits[(size_t)numUiHits++] = { t.pad, t.velocity, offset };
+
+            const auto latency = (float)(nowMs + offset * 1000.0 / currentSampleRate - t.timeMs);
+            lastTriggerLatencyMs.store(latency, std::memory_order_relaxed);
+            if (latency > maxTriggerLatencyMs.load(std::memory_order_relaxed))
+                maxTriggerLatencyMs.store(latency, std::memory_order_relaxed);
+        }
+    }
+    lastBlockStartMs = nowMs;
+
+    // ── UI and sequencer hits, in sample order with the MIDI below ───────
+    // A hit can cut another in its choke group (or steal its voice), so
+    // every source has to start in the order it sounds. At the same sample,
+    // UI hits go first, then MIDI, then the sequencer. Sequencer hits don't
+    // go through startPad: the keyboard range stays on the last pad hit by
+    // hand.
+    const auto* steps  = sequencer.getEvents();
+    const int numSteps = sequencer.getNumEvents();
+    int nextStep = 0, nextUiHit = 0;
+
+    auto playHitsBefore = [&](int sampleOffset) noexcept
+    {
+        constexpr int none = std::numeric_limits<int>::max();
+
+        for (;;)
+        {
+            const int ui   = nextUiHit < numUiHits ? uiHits[(size_t)nextUiHit].sampleOffset : none;
+            const int step = nextStep < numSteps ? steps[nextStep].sampleOffset : none;
+
+            if (ui <= sampleOffset && ui <= step)
+            {
+                const auto& h = uiHits[(size_t)nextUiHit++];
+                startPad(h.pad, h.velocity, h.sampleOffset);
+            }
+            else if (step < sampleOffset)
+            {
+                const auto& e = steps[nextStep++];
+                padSampler.startVoice(e.track, e.velocity, e.sampleOffset);
+                activityBridge.voiceStarted(e.track, PAD_BASE_NOTE + e.track, e.velocity);
+            }
+            else
+            {
+                return;
+            }
+        }
+    };
+
+    // ── MIDI: pad notes, keyboard range + note activity for the UI ───────
+    // (lock-free — never touch midiKeyboardState here, its lock is shared
+    // with the message thread)
     for (const auto metadata : midiMessages)
-        midiKeyboardState.processNextMidiEvent(metadata.getMessage());
+    {
+        const auto msg = metadata.getMessage();
+        playHitsBefore(metadata.samplePosition);
+
+        if (msg.isNoteOn())
+        {
+            activityBridge.noteOn(msg.getChannel(), msg.getNoteNumber(), msg.getFloatVelocity());
+
+            const int note = msg.getNoteNumber();
+            const int pad  = note - PAD_BASE_NOTE;
+            if (juce::isPositiveAndBelow(pad, NUM_PADS))
+                startPad(pad, msg.getFloatVelocity(), metadata.samplePosition);
+            else if (note >= KEYS_LOW_NOTE && note <= KEYS_HIGH_NOTE)
+                startPad(keysPad, msg.getFloatVelocity(), metadata.samplePosition,
+                         (float)(note - KEYS_ROOT_NOTE));
+        }
+        else if (msg.isNoteOff())
+        {
+            activityBridge.noteOff(msg.getChannel(), msg.getNoteNumber());
+        }
+        else if (msg.isAllNotesOff() || msg.isAllSoundOff())
+        {
+            activityBridge.allNotesOff(msg.getChannel());
+            padSampler.allNotesOff();
+        }
+    }
+
+    playHitsBefore(numSamples);
+}
+
+// Voices render into padBus (sized in prepareToPlay); hosts that send a
+// larger block than promised are handled in padBus-sized chunks rather than
+// by reallocating on the audio thread.
+void HALO9PlayerAudioProcessor::renderPads(juce::AudioBuffer<float>& buffer,
+                                           int numSamples) noexcept
+{
+    const int chunk = padBus.getNumSamples();
+    const int outChannels = buffer.getNumChannels();
+
+    for (int pos = 0; pos < numSamples; pos += chunk)
+    {
+        const int n = juce::jmin(chunk, numSamples - pos);
+
+        {
+            H9DspProfiler::ScopedStage t(profiler, H9DspProfiler::voices);
+            padBus.clear(0, n);
+            padSampler.render(padBus, 0, n, voiceWorkers.get());
+        }
+
+        // Measured inside the voices, on whichever threads rendered them
+        const auto textureTicks = padSampler.takeTextureTicks();
+        if (textureTicks > 0 && profiler.isEnabled())
+            profiler.record(H9DspProfiler::texture, textureTicks);
+
+        {
+            H9DspProfiler::ScopedStage t(profiler, H9DspProfiler::mix);
+            for (int ch = 0; ch < outChannels; ++ch)
+                buffer.addFrom(ch, pos, padBus, juce::jmin(ch, padBus.getNumChannels() - 1), 0, n);
+        }
+    }
+}
+
+// The host's tempo and position for the loop player and the sequencer. The
+// beat is counted from bar 1 when the host reports bars, so a loop or a
+// pattern restarts on a bar line even after a time signature change; the
+// host's cycle is moved onto the same count.
+void HALO9PlayerAudioProcessor::readTransport(H9LoopPlayer::Transport& transport,
+                                              H9StepSequencer::Transport& steps) const noexcept
+{
+    transport = {};
+    steps     = {};
+
+    auto* playHead = getPlayHead();
+    if (playHead == nullptr)
+        return;
+
+    const auto position = playHead->getPosition();
+    if (!position.hasValue())
+        return;
+
+    if (const auto bpm = position->getBpm())
+        transport.bpm = *bpm;
+
+    if (const auto ppq = position->getPpqPosition())
+    {
+        transport.synced  = true;
+        transport.playing = position->getIsPlaying();
+        transport.beat    = *ppq;
+
+        const auto barStart = position->getPpqPositionOfLastBarStart();
+        const auto bars     = position->getBarCount();
+        const auto sig      = position->getTimeSignature();
+        if (barStart && bars && sig && sig->denominator > 0)
+            transport.beat = (double)*bars * sig->numerator * 4.0 / sig->denominator + (*ppq - *barStart);
+
+        steps.playing = transport.playing;
+        steps.bpm     = transport.bpm;
+        steps.beat    = transport.beat;
+
+        if (const auto loop = position->getLoopPoints(); loop && position->getIsLooping())
+        {
+            steps.looping   = true;
+            steps.loopStart = loop->ppqStart + (transport.beat - *ppq);
+            steps.loopEnd   = loop->ppqEnd   + (transport.beat - *ppq);
+        }
+    }
+}
+
+void HALO9PlayerAudioProcessor::applyWidth(juce::AudioBuffer<float>& buffer,
+                                           int numSamples) noexcept
+{
+    if (buffer.getNumChannels() < 2)
+    {
+        widthAmount.skip(numSamples);
+        return;
+    }
+
+    auto* l = buffer.getWritePointer(0);
+    auto* r = buffer.getWritePointer(1);
+
+    if (!widthAmount.isSmoothing() && widthAmount.getTargetValue() == 1.0f)
+        return;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float w    = widthAmount.getNextValue();
+        const float mid  = 0.5f * (l[i] + r[i]);
+        const float side = 0.5f * (l[i] - r[i]) * w;
+        l[i] = mid + side;
+        r[i] = mid - side;
+    }
 }
 
 void HALO9PlayerAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = apvts.state.createXml();
-    copyXmlToBinary(*state, destData);
+    H9PluginState state;
+
+    for (auto* p : getParameters())
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(p))
+            state.parameters.emplace_back(ranged->getParameterID(),
+                                          ranged->convertFrom0to1(ranged->getValue()));
+
+    {
+        const juce::ScopedLock sl(sessionLock);
+        state.activePackId = activePackId;
+        state.activeKitId  = activeKitId;
+        state.pads         = padRefs;
+        state.loop         = loopRef;
+        state.slices       = sliceRef;
+        state.steps        = stepPattern;
+    }
+
+    state.writeTo(destData);
 }
 
+// Returns as soon as parameters and ids are applied — decoding and any
+// relinking of moved samples, loops included, finish on the job system.
 void HALO9PlayerAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
+    H9_TRACE_SCOPE("setStateInformation");
+
+    H9PluginState state;
+    if (state.readFrom(data, (size_t)juce::jmax(0, sizeInBytes)))
+    {
+        for (auto& [id, value] : state.parameters)
+            if (auto* p = apvts.getParameter(id))
+                p->setValueNotifyingHost(p->convertTo0to1(value));
+
+        {
+            const juce::ScopedLock sl(sessionLock);
+            activePackId = state.activePackId;
+            activeKitId  = state.activeKitId;
+            padRefs      = state.pads;
+            loopRef      = state.loop;
+            sliceRef     = state.slices;
+            stepPattern  = state.steps;
+            sequencer.setPattern(stepPattern);
+        }
+
+        if (!state.slices.isEmpty())
+        {
+            loopSlicer.slice(state.slices, library.getRoot(), loaderSampleRate.load());
+        }
+        else
+        {
+            loopSlicer.cancel();
+            requestSampleLoad(state.activeKitId, state.pads);
+        }
+
+        loadPackImpulse(state.activePackId);
+        applyPackRoles(state.activePackId);
+        loopPlayer.load(state.loop, library.getRoot());
+        ++stateGeneration;
+        return;
+    }
+
+    // Sessions saved before the binary format: APVTS XML, parameters only
     auto xmlState = getXmlFromBinary(data, sizeInBytes);
     if (xmlState && xmlState->hasTagName(apvts.state.getType()))
         apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
@@ -75,10 +1019,12 @@ void HALO9PlayerAudioProcessor::setStateInformation(const void* data, int sizeIn
 
 juce::AudioProcessorEditor* HALO9PlayerAudioProcessor::createEditor()
 {
+    H9_TRACE_SCOPE("createEditor");
     return new HALO9PlayerAudioProcessorEditor(*this);
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
 {
+    H9_TRACE_SCOPE("createPluginFilter");
     return new HALO9PlayerAudioProcessor();
 }
@@ -2,9 +2,26 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_dsp/juce_dsp.h>
 #include "Data/H9Library.h"
+#include "Core/H9AudioBridge.h"
+#include "Core/H9SpscQueue.h"
+#include "Core/H9DspProfiler.h"
+#include "Core/H9LoadGuard.h"
+#include "Core/H9Trace.h"
+#include "Audio/H9PadSampler.h"
+#include "Audio/H9SampleLoader.h"
+#include "Audio/H9FdnReverb.h"
+#include "Audio/H9ConvolutionReverb.h"
+#include "Audio/H9TapeStage.h"
+#include "Audio/H9LoopPlayer.h"
+#include "Audio/H9LoopSlicer.h"
+#include "Audio/H9StepSequencer.h"
+#include "Data/H9PluginState.h"
 
-class HALO9PlayerAudioProcessor : public juce::AudioProcessor
+class HALO9PlayerAudioProcessor : public juce::AudioProcessor,
+                                  private juce::Timer
 {
 public:
     HALO9PlayerAudioProcessor();
@@ -21,7 +38,7 @@ public:
     bool acceptsMidi() const override { return true; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
+    double getTailLengthSeconds() const override;
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -32,23 +49,223 @@ public:
     void getStateInformation(juce::MemoryBlock& destData) override;
     void setStateInformation(const void* data, int sizeInBytes) override;
 
+private:
+    // Declared ahead of apvts so it times the APVTS construction; ended at
+    // the top of the constructor body
+    H9Trace::Span apvtsTrace { "APVTS construction" };
+
+public:
     // Public APVTS (direct access for attachment init-list)
     juce::AudioProcessorValueTreeState apvts;
 
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
     juce::MidiKeyboardState& getKeyboardState() { return midiKeyboardState; }
+    H9AudioBridge& getActivityBridge() { return activityBridge; }
+    H9DspProfiler& getProfiler() { return profiler; }
+    H9LoadGuard& getLoadGuard() { return loadGuard; }
     H9Library& getLibrary() { return library; }
 
     static constexpr int NUM_PADS = 8;
-    juce::String padSamplePaths[NUM_PADS];
+    static constexpr int PAD_BASE_NOTE = 36;   // C1 → P1 … G1 → P8
+
+    // C3 – C6 play the last-hit pad chromatically, C4 at its own pitch
+    static constexpr int KEYS_LOW_NOTE  = 48;
+    static constexpr int KEYS_HIGH_NOTE = 84;
+    static constexpr int KEYS_ROOT_NOTE = 60;
+
+    // ── Session (message thread) ────────────────────────────────────────────
+    // Makes `kitId` the active kit and decodes its pads in the background;
+    // the sampler switches over once they are ready. Empty / unknown id
+    // clears the pads.
+    void loadKit(const juce::String& kitId);
+
+    // Changing pack also applies its manifest's tape settings (a pack
+    // without a "tape" block turns the stage off). Its padBank's "texture"
+    // pads play grain clouds.
+    void setActivePackId(const juce::String& packId);
+    juce::String getActivePackId() const;
+    juce::String getActiveKitId() const;
+    H9SampleRef getPadSampleRef(int pad) const;
+
+    bool isLoadingSamples() const { return sampleLoader.isLoading() || loopSlicer.isSlicing(); }
+
+    // Chops an audio file across the pads at its onsets, in place of the
+    // kit (which is cleared); loadKit() switches back. A file that doesn't
+    // exist does nothing.
+    void sliceLoopToPads(const juce::File& file);
+    H9SampleRef getSlicedLoopRef() const;   // empty when the pads play a kit
+    H9LoopSlicer::Info getSliceInfo() const { return loopSlicer.getInfo(); }
+
+    // Admin: when on, kit loads also measure every sample-store encoding
+    // (memory vs. decode cost) for choosing a kit's "storage" mode. Turning
+    // it on reloads the current kit.
+    void setMeasureSampleStorage(bool shouldMeasure);
+    juce::String getSampleStorageReport() const;   // JSON, empty until measured
+
+    // Streaming kits: active disk streams and underruns since instantiation
+    H9DiskStreams::Stats getDiskStreamStats() const { return padSampler.getStreamStats(); }
+
+    // Loop player: an audio file looped and stretched to the host tempo.
+    // A file that doesn't exist unloads it.
+    void loadLoop(const juce::File& file);
+    const H9LoopPlayer& getLoopPlayer() const { return loopPlayer; }
+
+    // Grain clouds on texture pads: sounding, peak and dropped grains
+    H9PadSampler::GrainStats getGrainStats() const { return padSampler.getGrainStats(); }
+
+    // Step sequencer: the pads' pattern, played from the host transport
+    // while seq_enabled is on. Saved with the session.
+    void setStepPattern(const H9StepPattern& pattern);
+    H9StepPattern getStepPattern() const;
+    H9StepSequencer::Stats getSequencerStats() const { return sequencer.getStats(); }
+
+    // The active pack's impulse response (0 s when it has none)
+    H9ConvolutionReverb::Info getConvolutionInfo() const { return convolution.getInfo(); }
+
+    // Bumped each time setStateInformation replaces the session, so an open
+    // editor knows to re-sync its selection
+    int getStateGeneration() const { return stateGeneration.load(std::memory_order_relaxed); }
+
+    // UI / computer-keyboard pad hit. Timestamped here and rendered at the
+    // matching sample offset of the next block. Message thread.
+    void triggerPadFromUI(int pad, float velocity);
+
+    // Trigger → first-sample latency of UI pad hits (wall clock, excluding
+    // the device buffer), for monitoring
+    float getLastTriggerLatencyMs() const { return lastTriggerLatencyMs.load(std::memory_order_relaxed); }
+    float getMaxTriggerLatencyMs()  const { return maxTriggerLatencyMs.load(std::memory_order_relaxed); }
 
 private:
+    // Message-thread only — the editor feeds it from activityBridge
     juce::MidiKeyboardState midiKeyboardState;
+    H9AudioBridge activityBridge;
     H9Library library;
 
     double currentSampleRate { 44100.0 };
     int currentBlockSize { 512 };
 
+    // Cached in the constructor — getRawParameterValue(StringRef) builds a
+    // juce::String for the lookup, which allocates on the audio thread
+    std::atomic<float>* masterVolumeParam { nullptr };
+    std::atomic<float>* cutoffParam       { nullptr };
+    std::atomic<float>* atmosphereParam   { nullptr };
+    std::atomic<float>* interpRealtimeParam { nullptr };
+    std::atomic<float>* interpOfflineParam  { nullptr };
+    std::atomic<float>* voiceThreadsParam   { nullptr };
+    std::atomic<float>* reverbLinesParam    { nullptr };
+    std::atomic<float>* reverbTypeParam     { nullptr };
+    std::atomic<float>* tapeEnabledParam    { nullptr };
+    std::atomic<float>* tapeDriveParam      { nullptr };
+    std::atomic<float>* tapeWowParam        { nullptr };
+    std::atomic<float>* tapeFlutterParam    { nullptr };
+    std::atomic<float>* tapeOversamplingParam { nullptr };
+    std::atomic<float>* loopVolumeParam     { nullptr };
+    std::atomic<float>* loopSyncParam       { nullptr };
+    std::atomic<float>* textureDensityParam { nullptr };
+    std::atomic<float>* textureSizeParam    { nullptr };
+    std::atomic<float>* textureScanParam    { nullptr };
+    std::atomic<float>* textureSprayParam   { nullptr };
+    std::atomic<float>* textureSpreadParam  { nullptr };
+    std::atomic<float>* textureWindowParam  { nullptr };
+    std::atomic<float>* seqEnabledParam     { nullptr };
+
+    struct PadToneParams
+    {
+        std::atomic<float>* attack    { nullptr };
+        std::atomic<float>* decay     { nullptr };
+        std::atomic<float>* sustain   { nullptr };
+        std::atomic<float>* filter    { nullptr };
+        std::atomic<float>* cutoff    { nullptr };
+        std::atomic<float>* resonance { nullptr };
+    };
+    std::array<PadToneParams, NUM_PADS> padToneParams;
+
+    H9DspProfiler profiler;
+    H9LoadGuard loadGuard;
+
+    // ── Session — never touched by the audio thread; locked because hosts
+    //    may save / restore state off the message thread ────────────────────
+    juce::CriticalSection sessionLock;
+    juce::String activePackId;
+    juce::String activeKitId;
+    std::array<H9SampleRef, NUM_PADS> padRefs;
+    H9SampleRef loopRef;                  // kept when the file is missing
+    H9SampleRef sliceRef;                 // loop the pads are sliced from; empty = kit
+    H9StepPattern stepPattern;            // also publishes to the sequencer, under the lock
+    std::atomic<int> stateGeneration { 0 };
+
+    std::atomic<bool> measureSampleStorage { false };
+    juce::String sampleStorageReport;
+
+    // Bit p set: the active pack makes pad p a texture pad
+    std::atomic<int> texturePadMask { 0 };
+
+    // Rate pads are converted to (0 until the first prepareToPlay)
+    std::atomic<double> loaderSampleRate { 0.0 };
+
+    void requestSampleLoad(const juce::String& kitId,
+                           const std::array<H9SampleRef, NUM_PADS>& refs);
+    void loadPackImpulse(const juce::String& packId);
+    void applyPackTape(const juce::String& packId);
+    void applyPackRoles(const juce::String& packId);
+    void reloadSamples();
+    juce::String makeStorageReport(const std::vector<H9SampleStore::Measurement>&) const;
+
+    // ── Pad engine ──────────────────────────────────────────────────────────
+    H9PadSampler padSampler;
+    H9SampleLoader sampleLoader;
+    H9LoopSlicer loopSlicer;
+
+    // Parallel voice rendering: rebuilt by the timer when voice_threads
+    // changes, adopted by the audio thread at the next block
+    H9ObjectHandoff<H9RealtimeWorkers> voiceWorkers;
+    int voiceWorkerThreads { 0 };   // message thread — what was last published
+
+    void updateVoiceWorkers();
+
+    struct PadTrigger
+    {
+        int    pad      { 0 };
+        float  velocity { 1.0f };
+        double timeMs   { 0.0 };   // Time::getMillisecondCounterHiRes()
+    };
+
+    H9SpscQueue<PadTrigger, 64> padTriggers;
+    double lastBlockStartMs { 0.0 };
+
+    std::atomic<float> lastTriggerLatencyMs { 0.0f };
+    std::atomic<float> maxTriggerLatencyMs  { 0.0f };
+
+    int keysPad { 0 };   // audio thread — the pad the keyboard range plays
+
+    void startPad(int pad, float velocity, int sampleOffset, float semitones = 0.0f) noexcept;
+    void timerCallback() override;
+
+    // ── Loop player ─────────────────────────────────────────────────────────
+    H9LoopPlayer loopPlayer;
+
+    // ── Step sequencer ──────────────────────────────────────────────────────
+    H9StepSequencer sequencer;
+
+    // The host's position, for the loop player and the sequencer
+    void readTransport(H9LoopPlayer::Transport&, H9StepSequencer::Transport&) const noexcept;
+
+    // ── Signal chain: pads + loop → M/S width → LPF → tape → reverb → master
+    juce::AudioBuffer<float> padBus;
+    juce::dsp::StateVariableTPTFilter<float> lowpass;
+    H9TapeStage tape;
+    H9FdnReverb reverb;
+    H9ConvolutionReverb convolution;   // the pack's IR, when it has one
+    static constexpr float atmosphereRoomSize = 0.85f;   // FDN room size at full Atmosphere
+    bool usingConvolution { false };
+
+    juce::SmoothedValue<float> widthAmount { 1.0f };
+    juce::SmoothedValue<float> masterGain  { 0.8f };
+
+    void handleTriggersAndMidi(juce::MidiBuffer&, int numSamples) noexcept;
+    void renderPads(juce::AudioBuffer<float>&, int numSamples) noexcept;
+    void applyWidth(juce::AudioBuffer<float>&, int numSamples) noexcept;
+
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout() const;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HALO9PlayerAudioProcessor)
@@ -0,0 +1,387 @@
+#include "H9LibraryPanel.h"
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  Construction / population
+// ═══════════════════════════════════════════════════════════════════════════════
+
+H9LibraryPanel::H9LibraryPanel() = default;
+
+void H9LibraryPanel::populate(const H9Library& lib)
+{
+    auto selectedId = [](const ChipRow& row, int index)
+    {
+        return juce::isPositiveAndBelow(index, (int)row.chips.size())
+                   ? row.chips[(size_t)index].id : juce::String();
+    };
+
+    const auto prevPackId = selectedId(packRow, selectedPack);
+    const auto prevKitId  = selectedId(kitRow,  selectedKit);
+
+    std::vector<std::pair<juce::String, juce::String>> entries;
+
+    entries.reserve(lib.getPacks().size());
+    for (auto& p : lib.getPacks())
+        entries.emplace_back(p.id, p.name);
+    syncRow(packRow, entries);
+
+    entries.clear();
+    entries.reserve(lib.getKits().size());
+    for (auto& k : lib.getKits())
+        entries.emplace_back(k.id, k.name);
+    syncRow(kitRow, entries);
+
+    auto indexOf = [](const ChipRow& row, const juce::String& id)
+    {
+        if (id.isEmpty()) return -1;
+        for (int i = 0; i < (int)row.chips.size(); ++i)
+            if (row.chips[(size_t)i].id == id) return i;
+        return -1;
+    };
+
+    selectedPack = indexOf(packRow, prevPackId);
+    if (selectedPack < 0)
+        selectedPack = packRow.chips.empty() ? -1 : 0;
+
+    selectedKit = indexOf(kitRow, prevKitId);
+
+    hoverRow = hoverIndex = -1;
+    repaint();
+}
+
+// Reuses chips whose id and name are unchanged (keeping their measured width
+// and cached glyphs); only new or renamed entries are measured.
+void H9LibraryPanel::syncRow(ChipRow& row,
+                             const std::vector<std::pair<juce::String, juce::String>>& entries)
+{
+    juce::HashMap<juce::String, int> previous;
+    for (int i = 0; i < (int)row.chips.size(); ++i)
+        previous.set(row.chips[(size_t)i].id, i);
+
+    std::vector<Chip> next;
+    next.reserve(entries.size());
+
+    for (auto& [id, name] : entries)
+    {
+        if (previous.contains(id))
+        {
+            auto& old = row.chips[(size_t)previous[id]];
+            if (old.name == name && old.width > 0.0f)
+            {
+                next.push_back(std::move(old));
+                old.width = 0.0f;   // guard against duplicate ids reusing a moved-from chip
+                continue;
+            }
+        }
+
+        Chip chip;
+        chip.id    = id;
+        chip.name  = name;
+        chip.width = chipFont.getStringWidthFloat(name) + chipPadX;
+        next.push_back(std::move(chip));
+    }
+
+    row.chips = std::move(next);
+    relayoutRow(row);
+
+    // Indices moved; only this row's reused chips still hold glyphs
+    row.glyphOrder.clear();
+    for (int i = 0; i < (int)row.chips.size(); ++i)
+        if (row.chips[(size_t)i].glyphs != nullptr)
+            row.glyphOrder.push_back(i);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  Layout + spatial index
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void H9LibraryPanel::relayoutRow(ChipRow& row)
+{
+    float x = 0.0f;
+    for (auto& c : row.chips)
+    {
+        c.x = x;
+        x += c.width + chipGap;
+    }
+    row.contentWidth = row.chips.empty() ? 0.0f : x - chipGap;
+
+    // bucketFirst[b] = first chip whose right edge reaches into bucket b
+    const int numBuckets = (int)(row.contentWidth / bucketWidth) + 1;
+    row.bucketFirst.assign((size_t)numBuckets, (int)row.chips.size());
+
+    int chip = 0;
+    for (int b = 0; b < numBuckets; ++b)
+    {
+        const float bucketStart = (float)b * bucketWidth;
+        while (chip < (int)row.chips.size()
+               && row.chips[(size_t)chip].x + row.chips[(size_t)chip].width <= bucketStart)
+            ++chip;
+        row.bucketFirst[(size_t)b] = chip;
+    }
+
+    clampScroll(row);
+}
+
+void H9LibraryPanel::clampScroll(ChipRow& row)
+{
+    const float total = row.contentWidth + (adminMode ? plusW + 2.0f : 0.0f);
+    row.scroll = juce::jlimit(0.0f, juce::jmax(0.0f, total - row.area.getWidth()), row.scroll);
+}
+
+void H9LibraryPanel::resized()
+{
+    auto b = getLocalBounds().toFloat().reduced(1.0f);
+
+    const float pad = 12.0f;
+    float y = b.getY() + 8.0f;
+    const float left = b.getX() + pad;
+    const float w = b.getWidth() - pad * 2.0f;
+
+    for (auto* row : { &packRow, &kitRow })
+    {
+        row->labelArea = { left, y, w, 10.0f };
+        y += 13.0f;
+        row->area = { left, y, w, chipH };
+        y += chipH + 8.0f;
+        clampScroll(*row);
+    }
+}
+
+int H9LibraryPanel::chipAt(const ChipRow& row, float contentX) const
+{
+    if (contentX < 0.0f || row.bucketFirst.empty()) return -1;
+
+    const int b = (int)(contentX / bucketWidth);
+    if (b >= (int)row.bucketFirst.size()) return -1;
+
+    // At most bucketWidth / (chipPadX + chipGap) chips share a bucket
+    for (int i = row.bucketFirst[(size_t)b]; i < (int)row.chips.size(); ++i)
+    {
+        auto& c = row.chips[(size_t)i];
+        if (c.x > contentX) break;
+        if (contentX < c.x + c.width) return i;
+    }
+    return -1;
+}
+
+H9LibraryPanel::ChipRow* H9LibraryPanel::rowAt(juce::Point<float> p, int& rowIndex)
+{
+    if (packRow.area.contains(p)) { rowIndex = 0; return &packRow; }
+    if (kitRow.area.contains(p))  { rowIndex = 1; return &kitRow;  }
+    rowIndex = -1;
+    return nullptr;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  Mouse
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void H9LibraryPanel::mouseEnter(const juce::MouseEvent&) { hovering = true;  repaint(); }
+
+void H9LibraryPanel::mouseExit(const juce::MouseEvent&)
+{
+    hovering = false;
+    hoverRow = hoverIndex = -1;
+    repaint();
+}
+
+void H9LibraryPanel::mouseMove(const juce::MouseEvent& e)
+{
+    const int prevRow = hoverRow, prevIndex = hoverIndex;
+
+    int rowIndex = -1;
+    hoverIndex = -1;
+    if (auto* row = rowAt(e.position, rowIndex))
+        hoverIndex = chipAt(*row, e.position.x - row->area.getX() + row->scroll);
+    hoverRow = hoverIndex >= 0 ? rowIndex : -1;
+
+    if (hoverRow != prevRow || hoverIndex != prevIndex)
+        repaint();
+}
+
+void H9LibraryPanel::mouseDown(const juce::MouseEvent& e)
+{
+    int rowIndex = -1;
+    auto* row = rowAt(e.position, rowIndex);
+    if (row == nullptr) return;
+
+    const int i = chipAt(*row, e.position.x - row->area.getX() + row->scroll);
+    if (i < 0) return;
+
+    if (rowIndex == 0)
+    {
+        selectedPack = i;
+        if (onPackSelected) onPackSelected(i);
+    }
+    else
+    {
+        selectedKit = (selectedKit == i) ? -1 : i;
+        if (onKitSelected) onKitSelected(selectedKit);
+    }
+    repaint();
+}
+
+void H9LibraryPanel::mouseWheelMove(const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel)
+{
+    int rowIndex = -1;
+    auto* row = rowAt(e.position, rowIndex);
+    if (row == nullptr)
+    {
+        Component::mouseWheelMove(e, wheel);
+        return;
+    }
+
+    const float delta = wheel.deltaX != 0.0f ? wheel.deltaX : wheel.deltaY;
+    row->scroll -= delta * 200.0f;
+    clampScroll(*row);
+
+    mouseMove(e);
+    repaint();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  Paint — only chips intersecting the visible strip are touched
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void H9LibraryPanel::paint(juce::Graphics& g)
+{
+    auto b = getLocalBounds().toFloat().reduced(1.0f);
+
+    g.setColour(juce::Colours::black.withAlpha(0.15f));
+    g.fillRoundedRectangle(b.translated(0.0f, 2.0f), 10.0f);
+
+    juce::ColourGradient grad(
+        juce::Colour(0xff1c2129), b.getX(), b.getY(),
+        juce::Colour(0xff12161c), b.getX(), b.getBottom(), false);
+    g.setGradientFill(grad);
+    g.fillRoundedRectangle(b, 10.0f);
+
+    float glowA = hovering ? 0.20f : 0.08f;
+    g.setColour(juce::Colour(0xff2ee6c9).withAlpha(glowA));
+    g.drawRoundedRectangle(b.reduced(0.5f), 9.5f, 0.8f);
+
+    g.setColour(juce::Colour(0xff2ee6c9).withAlpha(hovering ? 0.16f : 0.10f));
+    g.drawRoundedRectangle(b, 10.0f, 1.0f);
+
+    paintRow(g, packRow, 0, selectedPack, "SOUND PACKS", "No packs installed");
+    paintRow(g, kitRow,  1, selectedKit,  "DRUM KITS",   "No drum kits installed");
+
+    if (adminMode)
+    {
+        g.setColour(juce::Colour(0xffff6b6b).withAlpha(0.50f));
+        g.fillEllipse(b.getRight() - 14.0f, b.getY() + 6.0f, 5.0f, 5.0f);
+    }
+}
+
+void H9LibraryPanel::paintRow(juce::Graphics& g, ChipRow& row, int rowIndex,
+                              int selected, const char* label, const char* emptyMsg)
+{
+    g.setColour(juce::Colour(0xff6e7681));
+    g.setFont(juce::Font(8.0f, juce::Font::bold));
+    g.drawText(juce::String(label), row.labelArea, juce::Justification::left, false);
+
+    if (row.chips.empty())
+    {
+        g.setColour(juce::Colour(0xff6e7681).withAlpha(0.5f));
+        g.setFont(juce::Font(9.0f));
+        g.drawText(juce::String(emptyMsg), row.area, juce::Justification::left, false);
+        return;
+    }
+
+    clampScroll(row);
+
+    juce::Graphics::ScopedSaveState clip(g);
+    g.reduceClipRegion(row.area.getSmallestIntegerContainer());
+
+    const float viewW = row.area.getWidth();
+    const int   n     = (int)row.chips.size();
+    const int   firstBucket = juce::jmin((int)(row.scroll / bucketWidth),
+                                         (int)row.bucketFirst.size() - 1);
+
+    int first = row.bucketFirst[(size_t)juce::jmax(0, firstBucket)];
+    int last  = first - 1;
+
+    for (int i = first; i < n; ++i)
+    {
+        auto& chip = row.chips[(size_t)i];
+        if (chip.x - row.scroll >= viewW) break;
+        last = i;
+
+        auto cr = juce::Rectangle<float>(row.area.getX() + chip.x - row.scroll,
+                                         row.area.getY(), chip.width, chipH);
+
+        const bool sel = (i == selected);
+        const bool hov = (hoverRow == rowIndex && hoverIndex == i);
+
+        if (sel)
+        {
+            g.setColour(juce::Colour(0xff2ee6c9).withAlpha(0.18f));
+            g.fillRoundedRectangle(cr, 5.0f);
+            g.setColour(juce::Colour(0xff2ee6c9).withAlpha(0.35f));
+            g.drawRoundedRectangle(cr, 5.0f, 0.8f);
+        }
+        else
+        {
+            g.setColour(juce::Colour(0xff1a2228).withAlpha(hov ? 0.9f : 0.5f));
+            g.fillRoundedRectangle(cr, 5.0f);
+            if (hov)
+            {
+                g.setColour(juce::Colour(0xff30363d));
+                g.drawRoundedRectangle(cr, 5.0f, 0.5f);
+            }
+        }
+
+        if (chip.glyphs == nullptr)
+        {
+            chip.glyphs = std::make_unique<juce::GlyphArrangement>();
+            chip.glyphs->addFittedText(chipFont, chip.name, 0.0f, 0.0f,
+                                       chip.width, chipH, juce::Justification::centred, 1);
+            row.glyphOrder.push_back(i);
+        }
+
+        g.setColour(sel ? juce::Colour(0xff2ee6c9) :
+                    juce::Colour(0xffe6edf3).withAlpha(hov ? 0.9f : 0.6f));
+        chip.glyphs->draw(g, juce::AffineTransform::translation(cr.getX(), cr.getY()));
+    }
+
+    if (adminMode)
+    {
+        const float plusX = row.area.getX() + row.contentWidth + chipGap + 2.0f - row.scroll;
+        if (plusX < row.area.getRight())
+        {
+            auto plusR = juce::Rectangle<float>(plusX, row.area.getY(), plusW, chipH);
+            g.setColour(juce::Colour(0xff1a2228).withAlpha(0.35f));
+            g.fillRoundedRectangle(plusR, 5.0f);
+            g.setColour(juce::Colour(0xff2ee6c9).withAlpha(0.25f));
+            g.setFont(juce::Font(12.0f));
+            g.drawText("+", plusR, juce::Justification::centred);
+        }
+    }
+
+    trimGlyphCache(row, first, last);
+}
+
+// Keeps glyph memory bounded for huge libraries: once a row holds more than
+// maxCachedGlyphsPerRow layouts, the least recently built ones outside the
+// visible range are released until it is back to half. Visible chips met on
+// the way are moved to the back, so a paint touches O(visible + evicted)
+// entries and never walks the row.
+void H9LibraryPanel::trimGlyphCache(ChipRow& row, int firstVisible, int lastVisible)
+{
+    auto& order = row.glyphOrder;
+    if ((int)order.size() <= maxCachedGlyphsPerRow) return;
+
+    for (size_t budget = order.size();
+         budget > 0 && (int)order.size() > maxCachedGlyphsPerRow / 2; --budget)
+    {
+        const int i = order.front();
+        order.pop_front();
+
+        if (i >= firstVisible && i <= lastVisible)
+        {
+            order.push_back(i);
+            continue;
+        }
+
+        row.chips[(size_t)i].glyphs.reset();
+    }
+}
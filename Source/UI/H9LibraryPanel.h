@@ -0,0 +1,90 @@
+#pragma once
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "Data/H9Library.h"
+#include <deque>
+
+// ── H9LibraryPanel ──────────────────────────────────────────────────────────
+// Pack / kit chip browser. Each section is a horizontally scrolling row of
+// chips that only lays out and paints what is on screen:
+//   • chip widths are measured once, when an entry first appears
+//   • glyph layouts are cached per chip and dropped again once off-screen
+//   • a fixed-width bucket index maps x → first chip, so hit-testing and
+//     finding the first visible chip are O(1) in the library size
+// populate() diffs against the previous contents by id, so only new or
+// renamed entries are re-measured when the library changes.
+
+class H9LibraryPanel : public juce::Component
+{
+public:
+    H9LibraryPanel();
+
+    void populate(const H9Library& lib);
+
+    int  selectedPack  { -1 };
+    int  selectedKit   { -1 };
+    bool adminMode     { false };
+
+    std::function<void(int)> onPackSelected;
+    std::function<void(int)> onKitSelected;
+
+    int getNumPacks() const { return (int)packRow.chips.size(); }
+    int getNumKits()  const { return (int)kitRow.chips.size(); }
+
+    void paint(juce::Graphics&) override;
+    void resized() override;
+
+    void mouseEnter(const juce::MouseEvent&) override;
+    void mouseExit (const juce::MouseEvent&) override;
+    void mouseMove (const juce::MouseEvent&) override;
+    void mouseDown (const juce::MouseEvent&) override;
+    void mouseWheelMove(const juce::MouseEvent&, const juce::MouseWheelDetails&) override;
+
+private:
+    struct Chip
+    {
+        juce::String id;
+        juce::String name;
+        float x     { 0.0f };   // content-space offset within the row
+        float width { 0.0f };
+        std::unique_ptr<juce::GlyphArrangement> glyphs;   // lazily built
+    };
+
+    struct ChipRow
+    {
+        std::vector<Chip> chips;
+        std::vector<int>  bucketFirst;   // bucket → index of first chip touching it
+        std::deque<int>   glyphOrder;    // chips holding glyphs, least recently built first
+        float contentWidth { 0.0f };
+        float scroll       { 0.0f };
+        juce::Rectangle<float> labelArea;
+        juce::Rectangle<float> area;      // visible chip strip
+    };
+
+    ChipRow packRow, kitRow;
+
+    bool hovering    { false };
+    int  hoverRow    { -1 };   // 0 = packs, 1 = kits
+    int  hoverIndex  { -1 };
+
+    juce::Font chipFont { 9.0f };
+
+    static constexpr float chipH          = 19.0f;
+    static constexpr float chipGap        = 4.0f;
+    static constexpr float chipPadX       = 14.0f;
+    static constexpr float plusW          = 24.0f;
+    static constexpr float bucketWidth    = 64.0f;
+    static constexpr int   maxCachedGlyphsPerRow = 128;
+
+    void syncRow(ChipRow& row, const std::vector<std::pair<juce::String, juce::String>>& entries);
+    void relayoutRow(ChipRow& row);
+    void clampScroll(ChipRow& row);
+
+    ChipRow* rowAt(juce::Point<float> p, int& rowIndex);
+    int chipAt(const ChipRow& row, float contentX) const;
+
+    void paintRow(juce::Graphics&, ChipRow& row, int rowIndex, int selected,
+                  const char* label, const char* emptyMsg);
+    void trimGlyphCache(ChipRow& row, int firstVisible, int lastVisible);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(H9LibraryPanel)
+};
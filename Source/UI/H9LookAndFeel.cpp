@@ -73,7 +73,7 @@ H9LookAndFeel::H9LookAndFeel()
 }
 
 // ═══════════════════════════════════════════════════════════════════════════════
-//  drawRotarySlider — arc-style knob with radial gradient glow
+//  drawRotarySlider — blits a cached sprite of the arc-style knob
 // ═══════════════════════════════════════════════════════════════════════════════
 
 void H9LookAndFeel::drawRotarySlider(juce::Graphics& g,
@@ -81,12 +81,58 @@ void H9LookAndFeel::drawRotarySlider(juce::Graphics& g,
                                       float sliderPos,
                                       float rotaryStartAngle,
                                       float rotaryEndAngle,
-                                      juce::Slider& /*slider*/)
+                                      juce::Slider& slider)
 {
-    const float diameter = (float)juce::jmin(width, height) - 8.0f;
+    const auto accent = slider.findColour(juce::Slider::rotarySliderFillColourId);
+
+    if (!sprites->isEnabled() || width <= 0 || height <= 0)
+    {
+        paintRotaryKnob(g, (float)x, (float)y, (float)width, (float)height,
+                        sliderPos, rotaryStartAngle, rotaryEndAngle, accent);
+        return;
+    }
+
+    // Quantise the value to the sprite grid and paint the sprite at that
+    // position — 1/256 of the sweep is well below one pixel of arc travel
+    const int step = juce::jlimit(0, knobValueSteps,
+                                  juce::roundToInt(sliderPos * (float)knobValueSteps));
+    const float qPos = (float)step / (float)knobValueSteps;
+
+    H9SpriteCache::Key key;
+    key.kind   = H9SpriteCache::Kind::rotaryKnob;
+    key.width  = width;
+    key.height = height;
+    key.scale  = H9SpriteCache::quantiseScale(g);
+    key.accent = accent.getARGB();
+    key.state  = step;
+    key.extra  = H9SpriteCache::packPair(juce::roundToInt(rotaryStartAngle * 1000.0f),
+                                         juce::roundToInt(rotaryEndAngle   * 1000.0f));
+
+    auto sprite = sprites->getOrRender(key, [&](juce::Graphics& sg, float w, float h)
+    {
+        paintRotaryKnob(sg, 0.0f, 0.0f, w, h, qPos,
+                        rotaryStartAngle, rotaryEndAngle, accent);
+    });
+
+    g.drawImage(sprite, juce::Rectangle<float>((float)x, (float)y,
+                                               (float)width, (float)height));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  paintRotaryKnob — arc-style knob with radial gradient glow (uncached)
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void H9LookAndFeel::paintRotaryKnob(juce::Graphics& g,
+                                     float x, float y, float width, float height,
+                                     float sliderPos,
+                                     float rotaryStartAngle,
+                                     float rotaryEndAngle,
+                                     juce::Colour accent)
+{
+    const float diameter = juce::jmin(width, height) - 8.0f;
     const float radius   = diameter * 0.5f;
-    const float cx       = (float)x + (float)width  * 0.5f;
-    const float cy       = (float)y + (float)height * 0.5f;
+    const float cx       = x + width  * 0.5f;
+    const float cy       = y + height * 0.5f;
     const float angle    = rotaryStartAngle + sliderPos * (rotaryEndAngle - rotaryStartAngle);
     const float arcR     = radius - 4.0f;
     const float trackW   = 3.0f;
@@ -99,8 +145,8 @@ void H9LookAndFeel::drawRotarySlider(juce::Graphics& g,
         const float glowR = radius + 6.0f;
 
         juce::ColourGradient glow(
-            H9::teal.withAlpha(alpha), cx, cy,
-            H9::teal.withAlpha(0.0f),  cx + glowR, cy, true);
+            accent.withAlpha(alpha), cx, cy,
+            accent.withAlpha(0.0f),  cx + glowR, cy, true);
         g.setGradientFill(glow);
         g.fillEllipse(cx - glowR, cy - glowR, glowR * 2.0f, glowR * 2.0f);
     }
@@ -150,7 +196,7 @@ void H9LookAndFeel::drawRotarySlider(juce::Graphics& g,
         juce::Path arc;
         arc.addCentredArc(cx, cy, arcR, arcR, 0.0f,
                           rotaryStartAngle, angle, true);
-        g.setColour(H9::teal);
+        g.setColour(accent);
         g.strokePath(arc, juce::PathStrokeType(
             valueW, juce::PathStrokeType::curved,
             juce::PathStrokeType::rounded));
@@ -165,14 +211,14 @@ void H9LookAndFeel::drawRotarySlider(juce::Graphics& g,
     // ── 6) Pointer line from center toward current angle ─────────────────
     {
         const float lineLen = radius * 0.42f;
-        g.setColour(H9::teal.withAlpha(0.65f));
+        g.setColour(accent.withAlpha(0.65f));
         g.drawLine(cx, cy,
                    cx + lineLen * std::cos(angle),
                    cy + lineLen * std::sin(angle), 2.0f);
     }
 
     // ── 7) Center dot ────────────────────────────────────────────────────
-    g.setColour(H9::teal);
+    g.setColour(accent);
     g.fillEllipse(cx - 3.0f, cy - 3.0f, 6.0f, 6.0f);
 }
 
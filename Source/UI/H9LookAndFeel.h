@@ -1,5 +1,6 @@
 #pragma once
 #include <juce_gui_basics/juce_gui_basics.h>
+#include "H9SpriteCache.h"
 
 // ── HALO9 colour palette ────────────────────────────────────────────────────
 // Shared by the LookAndFeel and any editor code that needs theme colours.
@@ -24,11 +25,17 @@ class H9LookAndFeel : public juce::LookAndFeel_V4
 public:
     H9LookAndFeel();
 
-    // Rotary slider — arc-style with radial gradient glow
+    // Rotary slider — arc-style with radial gradient glow, blitted from the
+    // shared sprite cache (value quantised to knobValueSteps)
     void drawRotarySlider(juce::Graphics&, int x, int y, int w, int h,
                           float sliderPos, float rotaryStartAngle,
                           float rotaryEndAngle, juce::Slider&) override;
 
+    // Uncached knob painter — used to render sprites and when caching is off
+    static void paintRotaryKnob(juce::Graphics&, float x, float y, float w, float h,
+                                float sliderPos, float rotaryStartAngle,
+                                float rotaryEndAngle, juce::Colour accent);
+
     // Button — rounded rect with hover/press glow
     void drawButtonBackground(juce::Graphics&, juce::Button&,
                               const juce::Colour& backgroundColour,
@@ -51,4 +58,11 @@ public:
 
     int  getDefaultScrollbarWidth() override;
     juce::Font getTextButtonFont(juce::TextButton&, int buttonHeight) override;
+
+    static constexpr int knobValueSteps = 256;
+
+    H9SpriteCache& getSpriteCache() { return *sprites; }
+
+private:
+    juce::SharedResourcePointer<H9SpriteCache> sprites;
 };
@@ -0,0 +1,109 @@
+#include "H9SpriteCache.h"
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  Key hashing
+// ═══════════════════════════════════════════════════════════════════════════════
+
+size_t H9SpriteCache::KeyHash::operator()(const Key& k) const noexcept
+{
+    // FNV-1a over the key fields — cheap and good enough for a few hundred entries
+    juce::uint64 h = 14695981039346656037ull;
+    auto mix = [&h](juce::uint64 v)
+    {
+        h ^= v;
+        h *= 1099511628211ull;
+    };
+
+    mix((juce::uint64)k.kind);
+    mix((juce::uint64)(juce::uint32)k.width);
+    mix((juce::uint64)(juce::uint32)k.height);
+    mix((juce::uint64)(juce::uint32)k.scale);
+    mix((juce::uint64)k.accent);
+    mix((juce::uint64)k.base);
+    mix((juce::uint64)(juce::uint32)k.state);
+    mix(k.extra >> 32);
+    mix(k.extra & 0xffffffffu);
+    return (size_t)h;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  Lookup / insert
+// ═══════════════════════════════════════════════════════════════════════════════
+
+int H9SpriteCache::quantiseScale(juce::Graphics& g)
+{
+    const float s = g.getInternalContext().getPhysicalPixelScaleFactor();
+    // 0.25 steps: covers 100/125/150/175/200% display scaling without
+    // creating a new sprite family for every fractional transform
+    return juce::jlimit(25, 800, juce::roundToInt(s * 4.0f) * 25);
+}
+
+const juce::Image* H9SpriteCache::lookup(const Key& key)
+{
+    auto it = index.find(key);
+    if (it == index.end())
+    {
+        ++stats.misses;
+        return nullptr;
+    }
+
+    ++stats.hits;
+    lru.splice(lru.begin(), lru, it->second);
+    return &it->second->image;
+}
+
+void H9SpriteCache::insert(const Key& key, const juce::Image& image)
+{
+    if (!enabled) return;
+
+    Entry e;
+    e.key   = key;
+    e.image = image;
+    e.bytes = (size_t)image.getWidth() * (size_t)image.getHeight() * 4u;
+
+    lru.push_front(std::move(e));
+    index[key] = lru.begin();
+    stats.bytesUsed += lru.front().bytes;
+    stats.entries    = index.size();
+
+    evictToBudget();
+}
+
+void H9SpriteCache::evictToBudget()
+{
+    // Never evict the entry just inserted, even if it alone exceeds the budget
+    while (stats.bytesUsed > budgetBytes && lru.size() > 1)
+    {
+        auto& victim = lru.back();
+        stats.bytesUsed -= victim.bytes;
+        index.erase(victim.key);
+        lru.pop_back();
+        ++stats.evictions;
+    }
+    stats.entries = index.size();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  Configuration
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void H9SpriteCache::setMemoryBudget(size_t bytes)
+{
+    budgetBytes = bytes;
+    evictToBudget();
+}
+
+void H9SpriteCache::setEnabled(bool shouldBeEnabled)
+{
+    enabled = shouldBeEnabled;
+    if (!enabled)
+        clear();
+}
+
+void H9SpriteCache::clear()
+{
+    lru.clear();
+    index.clear();
+    stats.bytesUsed = 0;
+    stats.entries   = 0;
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <list>
+#include <unordered_map>
+
+// ── H9SpriteCache ───────────────────────────────────────────────────────────
+// Bounded LRU of pre-rendered widget images (knobs, pad glows). Visuals are
+// rendered once per (size, scale, colours, quantised state) at physical pixel
+// resolution and then blitted. Shared process-wide through
+// juce::SharedResourcePointer so 60 editors don't each hold their own copy.
+// Message thread only.
+
+class H9SpriteCache
+{
+public:
+    enum class Kind : juce::uint8 { rotaryKnob = 1, padButton = 2 };
+
+    struct Key
+    {
+        Kind         kind   { Kind::rotaryKnob };
+        int          width  { 0 };
+        int          height { 0 };
+        int          scale  { 100 };   // physical scale factor × 100
+        juce::uint32 accent { 0 };     // primary colour (ARGB)
+        juce::uint32 base   { 0 };     // secondary colour (ARGB)
+        int          state  { 0 };     // quantised value or button state
+        juce::uint64 extra  { 0 };     // e.g. quantised rotary angles, see packPair()
+
+        bool operator==(const Key& o) const noexcept
+        {
+            return kind == o.kind && width == o.width && height == o.height
+                && scale == o.scale && accent == o.accent && base == o.base
+                && state == o.state && extra == o.extra;
+        }
+    };
+
+    // Two values in separate 32-bit halves of `extra`, so no two pairs
+    // share a key
+    static juce::uint64 packPair(int high, int low) noexcept
+    {
+        return ((juce::uint64)(juce::uint32)high << 32) | (juce::uint32)low;
+    }
+
+    struct Stats
+    {
+        juce::int64 hits      { 0 };
+        juce::int64 misses    { 0 };
+        juce::int64 evictions { 0 };
+        size_t      bytesUsed { 0 };
+        size_t      entries   { 0 };
+    };
+
+    H9SpriteCache() = default;
+
+    // Returns the cached sprite for `key`, rendering it with `render` on a
+    // miss. `render(g, w, h)` paints in logical coordinates at the origin;
+    // the transform to physical pixels is already applied.
+    template <typename RenderFn>
+    juce::Image getOrRender(const Key& key, RenderFn&& render)
+    {
+        if (auto* img = lookup(key))
+            return *img;
+
+        const float s = (float)key.scale / 100.0f;
+        const int pw = juce::jmax(1, juce::roundToInt((float)key.width  * s));
+        const int ph = juce::jmax(1, juce::roundToInt((float)key.height * s));
+
+        juce::Image img(juce::Image::ARGB, pw, ph, true);
+        {
+            juce::Graphics ig(img);
+            ig.addTransform(juce::AffineTransform::scale((float)pw / (float)key.width,
+                                                         (float)ph / (float)key.height));
+            render(ig, (float)key.width, (float)key.height);
+        }
+
+        insert(key, img);
+        return img;
+    }
+
+    // Physical scale factor of a Graphics context, quantised for use in Key.
+    static int quantiseScale(juce::Graphics& g);
+
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const { return budgetBytes; }
+
+    void setEnabled(bool shouldBeEnabled);
+    bool isEnabled() const { return enabled; }
+
+    void clear();
+    Stats getStats() const { return stats; }
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const Key& k) const noexcept;
+    };
+
+    struct Entry
+    {
+        Key         key;
+        juce::Image image;
+        size_t      bytes { 0 };
+    };
+
+    using LruList = std::list<Entry>;
+
+    LruList lru;   // front = most recently used
+    std::unordered_map<Key, LruList::iterator, KeyHash> index;
+
+    size_t budgetBytes { 16u * 1024u * 1024u };
+    bool   enabled     { true };
+    Stats  stats;
+
+    const juce::Image* lookup(const Key&);
+    void insert(const Key&, const juce::Image&);
+    void evictToBudget();
+};
@@ -0,0 +1,104 @@
+#include "H9StepGrid.h"
+#include "H9LookAndFeel.h"
+
+void H9StepGrid::setPattern(const H9StepPattern& p)
+{
+    pattern = p;
+    repaint();
+}
+
+juce::Rectangle<float> H9StepGrid::cellArea() const
+{
+    return getLocalBounds().toFloat().withTrimmedLeft(labelW);
+}
+
+juce::Rectangle<float> H9StepGrid::cellBounds(int track, int step) const
+{
+    const auto area = cellArea();
+    const float w = area.getWidth()  / (float)pattern.numSteps;
+    const float h = area.getHeight() / (float)H9StepPattern::numTracks;
+    return { area.getX() + (float)step * w, area.getY() + (float)track * h, w, h };
+}
+
+bool H9StepGrid::cellAt(juce::Point<float> p, int& track, int& step) const
+{
+    const auto area = cellArea();
+    if (!area.contains(p) || pattern.numSteps <= 0)
+        return false;
+
+    step  = juce::jlimit(0, pattern.numSteps - 1,
+                         (int)((p.x - area.getX()) / area.getWidth() * (float)pattern.numSteps));
+    track = juce::jlimit(0, H9StepPattern::numTracks - 1,
+                         (int)((p.y - area.getY()) / area.getHeight() * (float)H9StepPattern::numTracks));
+    return true;
+}
+
+void H9StepGrid::setCell(int track, int step, juce::uint8 velocity)
+{
+    auto& cell = pattern.velocity[(size_t)track][(size_t)step];
+    if (cell == velocity)
+        return;
+
+    cell = velocity;
+    repaint(cellBounds(track, step).toNearestInt().expanded(1));
+
+    if (onPatternChanged)
+        onPatternChanged(pattern);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  Mouse — click toggles, drag paints the clicked cell's new state
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void H9StepGrid::mouseDown(const juce::MouseEvent& e)
+{
+    int track, step;
+    if (!cellAt(e.position, track, step))
+        return;
+
+    dragVelocity = pattern.velocity[(size_t)track][(size_t)step] == 0 ? defaultVelocity : 0;
+    setCell(track, step, dragVelocity);
+}
+
+void H9StepGrid::mouseDrag(const juce::MouseEvent& e)
+{
+    int track, step;
+    if (cellAt(e.position, track, step))
+        setCell(track, step, dragVelocity);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════════
+//  Paint
+// ═══════════════════════════════════════════════════════════════════════════════
+
+void H9StepGrid::paint(juce::Graphics& g)
+{
+    const auto area = cellArea();
+
+    g.setColour(H9::panel);
+    g.fillRoundedRectangle(area, 4.0f);
+
+    g.setFont(juce::Font(7.0f));
+    for (int track = 0; track < H9StepPattern::numTracks; ++track)
+    {
+        const auto row = cellBounds(track, 0);
+        g.setColour(H9::dimText);
+        g.drawText(juce::String(track + 1),
+                   juce::Rectangle<float>(0.0f, row.getY(), labelW - 3.0f, row.getHeight()),
+                   juce::Justification::centredRight, false);
+
+        for (int step = 0; step < pattern.numSteps; ++step)
+        {
+            const auto cell = cellBounds(track, step).reduced(1.0f);
+            const int  velocity = pattern.velocity[(size_t)track][(size_t)step];
+            const bool onBeat = step % juce::jmax(1, pattern.stepsPerBeat) == 0;
+
+            if (velocity > 0)
+                g.setColour(accent.withAlpha(0.35f + 0.65f * (float)velocity / 127.0f));
+            else
+                g.setColour(H9::border.withAlpha(onBeat ? 0.9f : 0.5f));
+
+            g.fillRoundedRectangle(cell, 1.5f);
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "Data/H9PluginState.h"
+
+// ── H9StepGrid ──────────────────────────────────────────────────────────────
+// The step sequencer's pattern as a grid: one row per pad, one cell per
+// step, beats marked. Clicking a cell toggles it; dragging paints the same
+// state across the cells it passes. Every edit is reported whole through
+// onPatternChanged, which the editor hands to the processor.
+
+class H9StepGrid : public juce::Component
+{
+public:
+    static constexpr juce::uint8 defaultVelocity = 100;
+
+    H9StepGrid() = default;
+
+    // Shows `pattern` without reporting it back
+    void setPattern(const H9StepPattern& pattern);
+    const H9StepPattern& getPattern() const noexcept { return pattern; }
+
+    void setAccent(juce::Colour c) { accent = c; repaint(); }
+
+    std::function<void(const H9StepPattern&)> onPatternChanged;
+
+    void paint(juce::Graphics&) override;
+    void mouseDown(const juce::MouseEvent&) override;
+    void mouseDrag(const juce::MouseEvent&) override;
+
+private:
+    H9StepPattern pattern;
+    juce::Colour  accent { 0xff33ffc8 };
+    juce::uint8   dragVelocity { 0 };   // what a drag paints: 0 clears
+
+    static constexpr float labelW = 14.0f;
+
+    juce::Rectangle<float> cellArea() const;
+    juce::Rectangle<float> cellBounds(int track, int step) const;
+
+    // Track and step under `p`, false outside the cells
+    bool cellAt(juce::Point<float> p, int& track, int& step) const;
+    void setCell(int track, int step, juce::uint8 velocity);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(H9StepGrid)
+};
@@ -0,0 +1,151 @@
+// ── HALO9 render bench ──────────────────────────────────────────────────────
+// Opens one editor and paints it into an offscreen image frame after frame,
+// sweeping every knob's value and cycling the pads through idle / hover /
+// pressed, once with the sprite cache on and once with it off. Prints ms per
+// frame for both and the cache hit rate, so H9SpriteCache's win (or a
+// regression in H9LookAndFeel / CircleButtonLAF painting) is a number.
+//
+//   HALO9_RenderBench [frames=600] [scale=2]
+//
+// Build with -DHALO9_BUILD_RENDER_BENCH=ON.
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "PluginProcessor.h"
+#include "UI/H9SpriteCache.h"
+#include <algorithm>
+#include <iostream>
+
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter();
+
+namespace
+{
+    void collect(juce::Component& c, std::vector<juce::Slider*>& knobs,
+                 std::vector<juce::Button*>& pads)
+    {
+        for (auto* child : c.getChildren())
+        {
+            if (auto* s = dynamic_cast<juce::Slider*>(child))
+            {
+                if (s->isRotary()) knobs.push_back(s);
+            }
+            else if (auto* b = dynamic_cast<juce::TextButton*>(child))
+            {
+                pads.push_back(b);
+            }
+            collect(*child, knobs, pads);
+        }
+    }
+
+    struct Result
+    {
+        double firstMs  { 0.0 };
+        double meanMs   { 0.0 };
+        double p99Ms    { 0.0 };
+        H9SpriteCache::Stats stats;
+    };
+
+    Result run(juce::Component& editor, H9SpriteCache& cache, bool cached,
+               int frames, float scale,
+               const std::vector<juce::Slider*>& knobs,
+               const std::vector<juce::Button*>& pads)
+    {
+        cache.clear();
+        cache.setEnabled(cached);
+        const auto before = cache.getStats();
+
+        juce::Image frame(juce::Image::ARGB,
+                          juce::roundToInt((float)editor.getWidth()  * scale),
+                          juce::roundToInt((float)editor.getHeight() * scale), true);
+
+        std::vector<double> ms;
+        ms.reserve((size_t)frames);
+
+        for (int f = 0; f < frames; ++f)
+        {
+            // A slow sweep, as if every knob were being automated
+            for (size_t k = 0; k < knobs.size(); ++k)
+            {
+                const double phase = (double)((f + (int)k * 37) % 240) / 240.0;
+                knobs[k]->setValue(knobs[k]->proportionOfLengthToValue(phase),
+                                   juce::dontSendNotification);
+            }
+
+            static constexpr juce::Button::ButtonState states[] =
+                { juce::Button::buttonNormal, juce::Button::buttonOver, juce::Button::buttonDown };
+            for (size_t p = 0; p < pads.size(); ++p)
+                pads[p]->setState(states[(size_t)(f / 4 + (int)p) % 3]);
+
+            const double t0 = juce::Time::getMillisecondCounterHiRes();
+            {
+                juce::Graphics g(frame);
+                g.addTransform(juce::AffineTransform::scale(scale));
+                editor.paintEntireComponent(g, true);
+            }
+            ms.push_back(juce::Time::getMillisecondCounterHiRes() - t0);
+        }
+
+        Result r;
+        r.firstMs = ms.front();
+        double sum = 0.0;
+        for (auto v : ms) sum += v;
+        r.meanMs = sum / (double)ms.size();
+        std::sort(ms.begin(), ms.end());
+        r.p99Ms = ms[(size_t)((double)(ms.size() - 1) * 0.99)];
+
+        const auto after = cache.getStats();
+        r.stats = after;
+        r.stats.hits   = after.hits   - before.hits;
+        r.stats.misses = after.misses - before.misses;
+        return r;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const int   frames = argc > 1 ? juce::jmax(2, juce::String(argv[1]).getIntValue()) : 600;
+    const float scale  = argc > 2 ? juce::jlimit(0.5f, 4.0f, juce::String(argv[2]).getFloatValue()) : 2.0f;
+
+    juce::ScopedJuceInitialiser_GUI juce;
+
+    std::unique_ptr<HALO9PlayerAudioProcessor> processor(
+        static_cast<HALO9PlayerAudioProcessor*>(createPluginFilter()));
+    std::unique_ptr<juce::AudioProcessorEditor> editor(processor->createEditor());
+
+    std::vector<juce::Slider*> knobs;
+    std::vector<juce::Button*> pads;
+    collect(*editor, knobs, pads);
+
+    juce::SharedResourcePointer<H9SpriteCache> cache;
+    const bool wasEnabled = cache->isEnabled();
+
+    // Uncached first so the cached run can't benefit from a warm glyph cache
+    const auto uncached = run(*editor, *cache, false, frames, scale, knobs, pads);
+    const auto cached   = run(*editor, *cache, true,  frames, scale, knobs, pads);
+    cache->setEnabled(wasEnabled);
+
+    auto row = [](const char* name, const Result& r)
+    {
+        std::cout << juce::String(name).paddedRight(' ', 10)
+                  << juce::String(r.firstMs, 3).paddedLeft(' ', 9)
+                  << juce::String(r.meanMs,  3).paddedLeft(' ', 10)
+                  << juce::String(r.p99Ms,   3).paddedLeft(' ', 10) << "\n";
+    };
+
+    std::cout << "HALO9 render bench — " << editor->getWidth() << "x" << editor->getHeight()
+              << " @ " << juce::String(scale, 2) << "x, " << knobs.size() << " knobs, "
+              << pads.size() << " buttons, " << frames << " frames\n\n"
+              << "mode      first ms   mean ms    p99 ms\n";
+    row("uncached", uncached);
+    row("cached",   cached);
+
+    const auto lookups = cached.stats.hits + cached.stats.misses;
+    std::cout << "\nspeedup:   " << juce::String(uncached.meanMs / juce::jmax(1.0e-9, cached.meanMs), 2) << "x\n"
+              << "hit rate:  " << juce::String(lookups > 0 ? 100.0 * (double)cached.stats.hits / (double)lookups : 0.0, 1)
+              << "% (" << cached.stats.entries << " sprites, "
+              << juce::String((double)cached.stats.bytesUsed / (1024.0 * 1024.0), 2) << " MB)\n";
+
+    // The message loop never runs, so editor callAsync()s are discarded with it
+    editor.reset();
+    processor.reset();
+    return 0;
+}
@@ -0,0 +1,62 @@
+// ── HALO9 trace harness ─────────────────────────────────────────────────────
+// Instantiates N processors and editors the way a host reopening a large
+// project would, with H9Trace switched on, then prints per-phase totals and
+// writes the Chrome trace.
+//
+//   HALO9_TraceHarness [instances=16] [trace.json]
+//
+// Build with -DHALO9_BUILD_TRACE_HARNESS=ON.
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "PluginProcessor.h"
+#include "Core/H9Trace.h"
+#include <iostream>
+
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter();
+
+int main(int argc, char* argv[])
+{
+    const int numInstances = argc > 1 ? juce::jmax(1, juce::String(argv[1]).getIntValue()) : 16;
+    const juce::File traceFile = argc > 2
+        ? juce::File::getCurrentWorkingDirectory().getChildFile(argv[2])
+        : juce::File::getCurrentWorkingDirectory().getChildFile("halo9-startup-trace.json");
+
+    juce::ScopedJuceInitialiser_GUI juce;
+    H9Trace::setEnabled(true);
+
+    std::vector<std::unique_ptr<HALO9PlayerAudioProcessor>> processors;
+    std::vector<std::unique_ptr<juce::AudioProcessorEditor>> editors;
+
+    const auto start = H9Trace::nowMicros();
+    {
+        H9_TRACE_SCOPE("harness: instantiate processors");
+        for (int i = 0; i < numInstances; ++i)
+            processors.push_back(std::unique_ptr<HALO9PlayerAudioProcessor>(
+                static_cast<HALO9PlayerAudioProcessor*>(createPluginFilter())));
+    }
+    const auto processorsDone = H9Trace::nowMicros();
+    {
+        H9_TRACE_SCOPE("harness: open editors");
+        for (auto& p : processors)
+            editors.push_back(std::unique_ptr<juce::AudioProcessorEditor>(p->createEditor()));
+    }
+    const auto editorsDone = H9Trace::nowMicros();
+
+    // The message loop never runs, so editor callAsync()s are discarded with it
+    editors.clear();
+    processors.clear();
+
+    std::cout << "HALO9 trace harness — " << numInstances << " instance(s)\n\n"
+              << H9Trace::getSummary() << "\n"
+              << "processors: " << juce::String((double)(processorsDone - start) / 1000.0, 2) << " ms\n"
+              << "editors:    " << juce::String((double)(editorsDone - processorsDone) / 1000.0, 2) << " ms\n";
+
+    if (!H9Trace::writeChromeJson(traceFile))
+    {
+        std::cerr << "could not write " << traceFile.getFullPathName() << "\n";
+        return 1;
+    }
+
+    std::cout << "trace: " << traceFile.getFullPathName() << "\n";
+    return 0;
+}
@@ -0,0 +1,1815 @@
+// ── HALO9 voice stress benchmark ────────────────────────────────────────────
+// Drives H9PadSampler with a synthetic 8-pad kit at a fixed hit rate (P4/P5
+// in one choke group, like the 808 hats) so the pool is permanently full
+// and every hit steals or chokes. Reports per-hit allocation cost and
+// per-block render cost against the block deadline.
+//
+//   HALO9_VoiceStress [hitsPerSecond=1000] [seconds=30] [storage=float32]
+//
+// `HALO9_VoiceStress kernels` instead times every H9VoiceKernels
+// specialisation against a generic loop that tests the same traits per
+// sample.
+//
+// `HALO9_VoiceStress threads [blockSize=4096] [seconds=10]` renders the same
+// hit sequence (pitched, sinc) with 1 – 16 voice threads, reporting the
+// speedup and checking every mix is bit-identical to the single-threaded one.
+//
+// `HALO9_VoiceStress tone [blockSize=128]` times H9VoiceDsp (amp envelope +
+// SVF) for 1 – 12 voices, packed into SIMD lanes as the sampler runs it and
+// one voice at a time, reporting the cost per voice-sample of each.
+//
+// `HALO9_VoiceStress reverb [blockSize=128]` times H9FdnReverb at 4, 8 and
+// 16 lines on stereo noise, and again on silence once the tail has died.
+//
+// `HALO9_VoiceStress convolution [blockSize=128]` times H9PartitionedConvolver
+// with stereo impulse responses of 0.25 – 8 s, reporting the mean cost and
+// the worst block (the ones where a 4096-sample partition completes).
+//
+// `HALO9_VoiceStress tape [blockSize=128]` times H9TapeStage at 2× and 4×
+// oversampling, and bypassed, then checks a burst comes out at the stage's
+// reported latency at 2×, 4×, off and while fading in.
+//
+// `HALO9_VoiceStress slice [bars=4]` times H9OnsetDetector on a synthetic
+// 120 BPM drum loop (kick, snare, eighth-note hats) and checks every hit is
+// found, a little ahead of its attack. It then times the whole H9LoopSlicer
+// job on the same loop saved as a 44.1 kHz WAV — read, decode, SRC,
+// detection and snapping, slice() to onSliced — and fails over 100 ms.
+//
+// `HALO9_VoiceStress texture [blockSize=128] [voices=1]` plays a texture
+// pad through H9PadSampler at 25 – 4000 grains/s of 250 ms each, reporting
+// the grains sounding, the cost per grain-sample and per block, and any
+// grains the pool dropped. It then renders one cloud in 128- and 127-sample
+// blocks, unpitched and pitched, and fails unless both come out the same.
+//
+// `HALO9_VoiceStress sequencer [blockSize=128]` schedules a full 1/64
+// pattern (every step on every track) with H9StepSequencer through steady
+// tempos, a tempo sweep, a host cycle, jumps and a count-in, reporting the
+// cost per block and per hit, and checks every hit against a sample-by-
+// sample reference: none missing, none twice, none a sample out. It then
+// sets a pattern through the processor's setStepPattern(), as the editor's
+// grid does, plays the whole plugin from a host transport at 120 and
+// 97.3 BPM, and checks every step sounds on the sample it is due.
+//
+// `HALO9_VoiceStress latency [blockSize=512] [seconds=10]` runs the whole
+// processor on a real-time clock while another thread hits a pad through
+// triggerPadFromUI(), and checks every hit sounds at the sample offset the
+// FIFO mapping promises (within ±1 sample), after subtracting the chain's
+// delay measured with MIDI hits.
+//
+// `HALO9_VoiceStress rtcheck [blockSize=256] [seconds=5]` (sanitizer builds)
+// first runs four voice worker threads paced like audio callbacks, so every
+// block has to wake parked workers, then plays the processor in real time
+// with every stage on — sliced pads, MIDI and UI hits, the loop, the
+// sequencer, worker threads, tape and reverb switching — and fails if
+// H9RealtimeSanitizer caught anything on the audio thread or a worker.
+// ctest runs it.
+//
+// Build with -DHALO9_BUILD_VOICE_STRESS=ON.
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include "PluginProcessor.h"
+#include "Core/H9RealtimeSanitizer.h"
+#include "Audio/H9PadSampler.h"
+#include "Audio/H9VoiceKernels.h"
+#include "Audio/H9VoiceDsp.h"
+#include "Audio/H9GranularEngine.h"
+#include "Audio/H9FdnReverb.h"
+#include "Audio/H9PartitionedConvolver.h"
+#include "Audio/H9TapeStage.h"
+#include "Audio/H9OnsetDetector.h"
+#include "Audio/H9LoopSlicer.h"
+#include "Audio/H9StepSequencer.h"
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter();
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int    blockSize  = 128;
+
+    std::unique_ptr<H9SampleSet> makeKit(H9SampleStore::Format format)
+    {
+        auto set = std::make_unique<H9SampleSet>();
+        juce::Random rng(9);
+
+        for (int p = 0; p < H9SampleSet::numPads; ++p)
+        {
+            // Decaying noise, 0.25 – 2 s, so voices overlap heavily
+            const int frames = (int)(sampleRate * (0.25 + 0.25 * p));
+            juce::AudioBuffer<float> audio(2, frames);
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                auto* d = audio.getWritePointer(ch);
+                for (int i = 0; i < frames; ++i)
+                    d[i] = (rng.nextFloat() * 2.0f - 1.0f) * std::exp(-4.0f * (float)i / (float)frames);
+            }
+
+            auto& pad = set->pads[(size_t)p];
+            pad.store.build(audio, format);
+            pad.sampleRate = sampleRate;
+            pad.chokeGroup = (p == 3 || p == 4) ? 1 : 0;
+        }
+        return set;
+    }
+
+    double percentile(std::vector<double> v, double fraction)
+    {
+        if (v.empty()) return 0.0;
+        const auto k = (size_t)juce::jlimit(0.0, (double)v.size() - 1.0, std::ceil(fraction * (double)v.size()) - 1.0);
+        std::nth_element(v.begin(), v.begin() + (std::ptrdiff_t)k, v.end());
+        return v[k];
+    }
+
+    // ── Kernel benchmark ────────────────────────────────────────────────────
+
+    using namespace H9VoiceKernels;
+
+    // What the sampler's loop looked like before specialisation: one loop,
+    // every trait tested per sample
+    struct Traits { Interp interp; bool stereoSource, stereoOut, fading; };
+
+    Result renderGeneric(const Args& a, int n, const Traits& t) noexcept
+    {
+        float gain = a.gain, peak = 0.0f;
+        double p = a.position;
+
+        for (int i = 0; i < n; ++i)
+        {
+            const int   at   = (int)p;
+            const float frac = (float)(p - (double)at);
+            const float* srcR = t.stereoSource ? a.right : a.left;
+
+            float l = a.left[at], r = srcR[at];
+            if (t.interp == Interp::linear)
+            {
+                l += frac * (a.left[at + 1] - l);
+                r += frac * (srcR[at + 1] - r);
+            }
+            else if (t.interp == Interp::cubic)
+            {
+                l = detail::hermite(a.left + at, frac);
+                r = detail::hermite(srcR + at, frac);
+            }
+            else if (t.interp == Interp::sinc)
+            {
+                const float phase = frac * (float)sincPhases;
+                const int   row   = juce::jmin((int)phase, sincPhases - 1);
+                const float* c    = a.sinc + row * 2 * sincTaps;
+                l = r = 0.0f;
+                for (int k = 0; k < sincTaps; ++k)
+                {
+                    const float tap = c[k] + (phase - (float)row) * c[sincTaps + k];
+                    l += tap * a.left[at - (sincTaps / 2 - 1) + k];
+                    r += tap * srcR[at - (sincTaps / 2 - 1) + k];
+                }
+            }
+            l *= gain;
+            r *= gain;
+
+            if (t.stereoOut) { a.outL[i] += l; a.outR[i] += r; }
+            else             { a.outL[i] += 0.5f * (l + r); }
+
+            peak = juce::jmax(peak, std::abs(l), std::abs(r));
+            if (t.fading) gain -= a.gainStep;
+            p += t.interp == Interp::none ? 1.0 : a.increment;
+        }
+        return { p, gain, peak };
+    }
+
+    int benchmarkKernels()
+    {
+        constexpr int frames = 1 << 16, chunk = 256, passes = 200;
+
+        juce::AudioBuffer<float> source(2, frames + maxFramesAfter);
+        juce::Random rng(3);
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < source.getNumSamples(); ++i)
+                source.setSample(ch, i, rng.nextFloat() * 2.0f - 1.0f);
+
+        prepareTables();
+        const float* sinc = getSincTable(getSincBand(0.7937));
+
+        juce::AudioBuffer<float> out(2, chunk);
+        const double nsPerTick = 1.0e9 / (double)juce::Time::getHighResolutionTicksPerSecond();
+
+        // Traits come from a volatile so the compiler can't specialise the
+        // baseline behind our back
+        volatile int traitBits = 0;
+
+        std::cout << "kernel                          generic ns/smp  kernel ns/smp  speedup\n";
+
+        for (int interp = 0; interp < numInterp; ++interp)
+        {
+            for (int bits = 0; bits < 8; ++bits)
+            {
+                traitBits = bits;
+                const Traits t { (Interp)interp, (traitBits & 4) != 0, (traitBits & 2) != 0, (traitBits & 1) != 0 };
+                const auto kernel = get(t.interp, t.stereoSource, t.stereoOut, t.fading);
+                const double increment = t.interp == Interp::none ? 1.0 : 0.7937;   // -4 semitones
+
+                auto run = [&](auto&& fn)
+                {
+                    const auto start = juce::Time::getHighResolutionTicks();
+                    for (int pass = 0; pass < passes; ++pass)
+                    {
+                        double p = (double)maxFramesBefore;
+                        while (p + chunk * increment + 2.0 < frames)
+                        {
+                            Args a { source.getReadPointer(0), source.getReadPointer(t.stereoSource ? 1 : 0),
+                                     p, increment, 0.8f, t.fading ? 1.0e-6f : 0.0f,
+                                     out.getWritePointer(0), t.stereoOut ? out.getWritePointer(1) : nullptr,
+                                     sinc };
+                            p = fn(a, chunk).position;
+                        }
+                    }
+                    const auto samples = (double)passes * (double)frames / increment;
+                    return (double)(juce::Time::getHighResolutionTicks() - start) * nsPerTick / samples;
+                };
+
+                const double generic = run([&](const Args& a, int n) { return renderGeneric(a, n, t); });
+                const double special = run([&](const Args& a, int n) { return kernel(a, n); });
+
+                const juce::String name = juce::String(getInterpName(t.interp)).paddedRight(' ', 6)
+                                        + (t.stereoSource ? " stereo-src" : " mono-src  ")
+                                        + (t.stereoOut ? " stereo-out" : " mono-out  ")
+                                        + (t.fading ? " fade" : "     ");
+                std::cout << name.paddedRight(' ', 32)
+                          << juce::String(generic, 2).paddedLeft(' ', 14)
+                          << juce::String(special, 2).paddedLeft(' ', 15)
+                          << juce::String(generic / juce::jmax(1.0e-9, special), 2).paddedLeft(' ', 8) << "x\n";
+            }
+        }
+        return 0;
+    }
+
+    // ── Thread scaling ──────────────────────────────────────────────────────
+
+    int benchmarkThreads(int blockFrames, double seconds)
+    {
+        const double nsPerTick = 1.0e9 / (double)juce::Time::getHighResolutionTicksPerSecond();
+        const int numBlocks = juce::jmax(1, (int)(seconds * sampleRate / blockFrames));
+
+        std::cout << "HALO9 voice threads — " << blockFrames << "-sample blocks, "
+                  << juce::SystemStats::getNumCpus() << " CPUs\n\n"
+                  << "threads  us/block  speedup  mix\n";
+
+        juce::uint64 reference = 0;
+        double baseUs = 0.0;
+
+        for (int threads : { 1, 2, 4, 8, 16 })
+        {
+            H9RealtimeWorkers workers(threads);
+            H9PadSampler sampler;
+            sampler.prepare(sampleRate, blockFrames);
+            sampler.setInterpolation(Interp::sinc);
+            sampler.setSampleSet(makeKit(H9SampleStore::Format::float32));
+
+            juce::AudioBuffer<float> out(2, blockFrames);
+            juce::Random rng(7);
+            juce::uint64 hash = 14695981039346656037ull;   // FNV-1a over the raw mix
+            double totalUs = 0.0;
+
+            for (int b = 0; b < numBlocks; ++b)
+            {
+                sampler.beginBlock();
+                out.clear();
+
+                for (int hit = 0; hit < 4; ++hit)
+                    sampler.startVoice(rng.nextInt(H9SampleSet::numPads), 0.8f,
+                                       rng.nextInt(blockFrames), rng.nextFloat() * 12.0f - 6.0f);
+
+                const auto t0 = juce::Time::getHighResolutionTicks();
+                sampler.render(out, 0, blockFrames, &workers);
+                totalUs += (double)(juce::Time::getHighResolutionTicks() - t0) * nsPerTick * 1.0e-3;
+
+                for (int ch = 0; ch < 2; ++ch)
+                {
+                    const auto* d = out.getReadPointer(ch);
+                    for (int i = 0; i < blockFrames; ++i)
+                    {
+                        juce::uint32 bits;
+                        std::memcpy(&bits, d + i, sizeof(bits));
+                        hash = (hash ^ bits) * 1099511628211ull;
+                    }
+                }
+            }
+
+            const double us = totalUs / numBlocks;
+            if (threads == 1)
+            {
+                reference = hash;
+                baseUs = us;
+            }
+
+            std::cout << juce::String(threads).paddedLeft(' ', 7)
+                      << juce::String(us, 1).paddedLeft(' ', 10)
+                      << juce::String(baseUs / juce::jmax(1.0e-9, us), 2).paddedLeft(' ', 8) << "x"
+                      << (hash == reference ? "  identical\n" : "  DIFFERS\n");
+
+            if (hash != reference)
+                return 1;
+        }
+        return 0;
+    }
+
+    // ── Voice envelope / filter packing ─────────────────────────────────────
+
+    int benchmarkTone(int blockFrames)
+    {
+        juce::ScopedNoDenormals noDenormals;
+
+        const double nsPerTick = 1.0e9 / (double)juce::Time::getHighResolutionTicksPerSecond();
+        const int passes = juce::jmax(1, (1 << 22) / blockFrames);
+
+        std::cout << "HALO9 voice tone — envelope + stereo SVF, " << blockFrames << "-sample blocks\n\n"
+                  << "voices  packed ns/voice-smp  one-by-one ns/voice-smp  speedup\n";
+
+        for (int numVoices = 1; numVoices <= H9PadSampler::numSlots; ++numVoices)
+        {
+            H9VoiceDsp dsp;
+            dsp.prepare(sampleRate);
+
+            for (int pad = 0; pad < H9VoiceDsp::numPads; ++pad)
+            {
+                H9VoiceDsp::Tone tone;
+                tone.attackMs  = 2.0f;
+                tone.decayMs   = 400.0f;
+                tone.sustain   = 0.5f;
+                tone.filter    = (H9VoiceDsp::Filter)(1 + pad % 3);
+                tone.cutoffHz  = 800.0f + 400.0f * (float)pad;
+                tone.resonance = 0.5f;
+                dsp.setTone(pad, tone);
+            }
+
+            juce::AudioBuffer<float> bus(2 * numVoices, blockFrames);
+            juce::Random rng(5);
+            std::array<int, H9VoiceDsp::maxVoices> list {}, starts {};
+            std::array<float, H9VoiceDsp::maxVoices> peaks {};
+            for (int v = 0; v < numVoices; ++v)
+                list[(size_t)v] = v;
+
+            // Fresh noise every block, as the sampler's kernels would write
+            auto refill = [&]
+            {
+                for (int ch = 0; ch < bus.getNumChannels(); ++ch)
+                    for (int i = 0; i < blockFrames; ++i)
+                        bus.setSample(ch, i, rng.nextFloat() * 2.0f - 1.0f);
+            };
+
+            auto run = [&](bool packed)
+            {
+                for (int v = 0; v < numVoices; ++v)
+                    dsp.startVoice(v, v % H9VoiceDsp::numPads);
+
+                double ticks = 0.0;
+                for (int pass = 0; pass < passes; ++pass)
+                {
+                    refill();
+                    const auto t0 = juce::Time::getHighResolutionTicks();
+                    if (packed)
+                        dsp.process(list.data(), numVoices, bus.getArrayOfWritePointers(), true,
+                                    blockFrames, starts.data(), peaks.data());
+                    else
+                        for (int v = 0; v < numVoices; ++v)
+                            dsp.process(list.data() + v, 1, bus.getArrayOfWritePointers(), true,
+                                        blockFrames, starts.data(), peaks.data());
+                    ticks += (double)(juce::Time::getHighResolutionTicks() - t0);
+                }
+                return ticks * nsPerTick / ((double)passes * blockFrames * numVoices);
+            };
+
+            const double single = run(false);
+            const double packed = run(true);
+
+            std::cout << juce::String(numVoices).paddedLeft(' ', 6)
+                      << juce::String(packed, 2).paddedLeft(' ', 21)
+                      << juce::String(single, 2).paddedLeft(' ', 25)
+                      << juce::String(single / juce::jmax(1.0e-9, packed), 2).paddedLeft(' ', 8) << "x\n";
+        }
+        return 0;
+    }
+
+    // ── Atmosphere reverb tiers ─────────────────────────────────────────────
+
+    int benchmarkReverb(int blockFrames)
+    {
+        juce::ScopedNoDenormals noDenormals;
+
+        const double nsPerTick = 1.0e9 / (double)juce::Time::getHighResolutionTicksPerSecond();
+        const double deadlineNs = 1.0e9 * blockFrames / sampleRate;
+        const int passes = juce::jmax(1, (1 << 21) / blockFrames);
+
+        std::cout << "HALO9 reverb — FDN, room 0.85, " << blockFrames << "-sample blocks\n\n"
+                  << "lines  ns/smp  % of deadline  idle ns/smp\n";
+
+        juce::AudioBuffer<float> buffer(2, blockFrames);
+        juce::Random rng(3);
+
+        for (int lines = 4; lines <= H9FdnReverb::maxLines; lines *= 2)
+        {
+            H9FdnReverb reverb;
+            reverb.prepare(sampleRate);
+            reverb.setLines(lines);
+            reverb.setParameters(0.85f, 0.45f);
+
+            auto run = [&](bool noise)
+            {
+                double ticks = 0.0;
+                for (int pass = 0; pass < passes; ++pass)
+                {
+                    for (int ch = 0; ch < 2; ++ch)
+                        for (int i = 0; i < blockFrames; ++i)
+                            buffer.setSample(ch, i, noise ? rng.nextFloat() * 0.2f - 0.1f : 0.0f);
+
+                    const auto t0 = juce::Time::getHighResolutionTicks();
+                    reverb.process(buffer.getWritePointer(0), buffer.getWritePointer(1), blockFrames);
+                    ticks += (double)(juce::Time::getHighResolutionTicks() - t0);
+                }
+                return ticks * nsPerTick / ((double)passes * blockFrames);
+            };
+
+            const double active = run(true);
+
+            // Let the tail die out (room 0.85 is about 3.4 s), then time silence
+            for (int i = 0; i < (int)(5.0 * sampleRate) / blockFrames; ++i)
+            {
+                buffer.clear();
+                reverb.process(buffer.getWritePointer(0), buffer.getWritePointer(1), blockFrames);
+            }
+            const double idle = run(false);
+
+            std::cout << juce::String(lines).paddedLeft(' ', 5)
+                      << juce::String(active, 1).paddedLeft(' ', 8)
+                      << (juce::String(100.0 * active * blockFrames / deadlineNs, 2) + " %").paddedLeft(' ', 15)
+                      << juce::String(idle, 2).paddedLeft(' ', 13) << "\n";
+        }
+        return 0;
+    }
+
+    // ── Convolution cost by IR length ───────────────────────────────────────
+
+    int benchmarkConvolution(int blockFrames)
+    {
+        juce::ScopedNoDenormals noDenormals;
+
+        const double nsPerTick  = 1.0e9 / (double)juce::Time::getHighResolutionTicksPerSecond();
+        const double deadlineNs = 1.0e9 * blockFrames / sampleRate;
+        const int passes = juce::jmax(1, (1 << 20) / blockFrames);
+
+        std::cout << "HALO9 convolution — stereo IR, " << blockFrames << "-sample blocks\n\n"
+                  << "IR s  partitions  ns/smp  mean % deadline  worst block %\n";
+
+        juce::AudioBuffer<float> in(2, blockFrames), out(2, blockFrames);
+        juce::Random rng(11);
+
+        for (double seconds : { 0.25, 0.5, 1.0, 2.0, 4.0, 8.0 })
+        {
+            // Decaying noise, -60 dB at the end
+            juce::AudioBuffer<float> ir(2, (int)(seconds * sampleRate));
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < ir.getNumSamples(); ++i)
+                    ir.setSample(ch, i, (rng.nextFloat() * 2.0f - 1.0f)
+                                        * std::pow(0.001f, (float)i / (float)ir.getNumSamples()));
+
+            H9PartitionedConvolver convolver(ir);
+
+            double ticks = 0.0, worst = 0.0;
+            for (int pass = 0; pass < passes; ++pass)
+            {
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = 0; i < blockFrames; ++i)
+                        in.setSample(ch, i, rng.nextFloat() * 0.2f - 0.1f);
+
+                const auto t0 = juce::Time::getHighResolutionTicks();
+                convolver.process(in.getReadPointer(0), in.getReadPointer(1),
+                                  out.getWritePointer(0), out.getWritePointer(1), blockFrames);
+                const auto t = (double)(juce::Time::getHighResolutionTicks() - t0);
+                ticks += t;
+                worst  = juce::jmax(worst, t);
+            }
+
+            const double ns = ticks * nsPerTick / ((double)passes * blockFrames);
+            std::cout << juce::String(seconds, 2).paddedLeft(' ', 4)
+                      << juce::String(convolver.getNumPartitions()).paddedLeft(' ', 12)
+                      << juce::String(ns, 1).paddedLeft(' ', 8)
+                      << (juce::String(100.0 * ns * blockFrames / deadlineNs, 2) + " %").paddedLeft(' ', 17)
+                      << (juce::String(100.0 * worst * nsPerTick / deadlineNs, 1) + " %").paddedLeft(' ', 15) << "\n";
+        }
+        return 0;
+    }
+
+    // ── Tape stage by oversampling factor ───────────────────────────────────
+
+    int benchmarkTape(int blockFrames)
+    {
+        juce::ScopedNoDenormals noDenormals;
+
+        const double nsPerTick  = 1.0e9 / (double)juce::Time::getHighResolutionTicksPerSecond();
+        const double deadlineNs = 1.0e9 * blockFrames / sampleRate;
+        const int passes = juce::jmax(1, (1 << 21) / blockFrames);
+
+        std::cout << "HALO9 tape — drive 0.5, wow 0.5, flutter 0.5, " << blockFrames << "-sample blocks\n\n"
+                  << "mode      ns/smp  % of deadline\n";
+
+        juce::AudioBuffer<float> buffer(2, blockFrames);
+        juce::Random rng(5);
+
+        const std::pair<const char*, int> modes[] = { { "2x", 0 }, { "4x", 1 }, { "bypass", -1 } };
+        for (const auto& [name, factor] : modes)
+        {
+            H9TapeStage tape;
+            tape.prepare(sampleRate, blockFrames);
+
+            H9TapeStage::Settings s;
+            s.enabled = factor >= 0;
+            s.drive = s.wow = s.flutter = 0.5f;
+            s.oversampling = factor == 1 ? H9TapeStage::Oversampling::x4 : H9TapeStage::Oversampling::x2;
+            tape.setSettings(s);
+            tape.reset();   // skip the fade-in
+
+            double ticks = 0.0;
+            for (int pass = 0; pass < passes; ++pass)
+            {
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = 0; i < blockFrames; ++i)
+                        buffer.setSample(ch, i, rng.nextFloat() * 0.5f - 0.25f);
+
+                const auto t0 = juce::Time::getHighResolutionTicks();
+                tape.process(buffer, blockFrames);
+                ticks += (double)(juce::Time::getHighResolutionTicks() - t0);
+            }
+
+            const double ns = ticks * nsPerTick / ((double)passes * blockFrames);
+            std::cout << juce::String(name).paddedRight(' ', 8)
+                      << juce::String(ns, 2).paddedLeft(' ', 8)
+                      << (juce::String(100.0 * ns * blockFrames / deadlineNs, 2) + " %").paddedLeft(' ', 15) << "\n";
+        }
+        return 0;
+    }
+
+    // A 200 Hz burst through the stage at 2× and 4×, off, and while it fades
+    // in: each output has to line up with the input delayed by
+    // getLatencySamples(). Off is a plain delay, so exact; through the tape
+    // the oversampling filters' delay isn't a whole number of samples, so
+    // within one.
+    int checkTapeLatency(int blockFrames)
+    {
+        constexpr int frames = 8192, lead = 1024, burst = 4096, maxLag = 512;
+
+        std::vector<float> input((size_t)frames, 0.0f);
+        for (int i = 0; i < burst; ++i)
+            input[(size_t)(lead + i)] = 0.25f * std::sin(juce::MathConstants<float>::twoPi * 200.0f * (float)i / (float)sampleRate)
+                                      * (0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * (float)i / (float)burst));
+
+        struct Case { const char* name; bool enabled, fadeIn; H9TapeStage::Oversampling factor; };
+        const Case cases[] = {
+            { "2x",      true,  false, H9TapeStage::Oversampling::x2 },
+            { "4x",      true,  false, H9TapeStage::Oversampling::x4 },
+            { "off",     false, false, H9TapeStage::Oversampling::x2 },
+            { "fade-in", true,  true,  H9TapeStage::Oversampling::x2 },
+        };
+
+        std::cout << "\nmode      latency  burst at\n";
+
+        juce::AudioBuffer<float> buffer(2, blockFrames);
+        int failures = 0;
+
+        for (const auto& c : cases)
+        {
+            H9TapeStage tape;
+            tape.prepare(sampleRate, blockFrames);
+
+            H9TapeStage::Settings s;
+            s.enabled = c.enabled;
+            s.drive = s.wow = s.flutter = 0.0f;
+            s.oversampling = c.factor;
+            tape.setSettings(s);
+            if (!c.fadeIn)
+                tape.reset();
+
+            std::vector<float> output;
+            output.reserve((size_t)frames);
+            for (int pos = 0; pos < frames; pos += blockFrames)
+            {
+                const int n = juce::jmin(blockFrames, frames - pos);
+                for (int ch = 0; ch < 2; ++ch)
+                    buffer.copyFrom(ch, 0, input.data() + pos, n);
+
+                tape.process(buffer, n);
+                output.insert(output.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + n);
+            }
+
+            int lag = 0;
+            double best = -1.0;
+            for (int l = 0; l < maxLag; ++l)
+            {
+                double sum = 0.0;
+                for (int i = lead; i < lead + burst && i + l < frames; ++i)
+                    sum += (double)input[(size_t)i] * (double)output[(size_t)(i + l)];
+                if (sum > best)
+                {
+                    best = sum;
+                    lag  = l;
+                }
+            }
+
+            const int latency = tape.getLatencySamples();
+            const bool ok = std::abs(lag - latency) <= (c.enabled ? 1 : 0);
+            failures += ok ? 0 : 1;
+
+            std::cout << juce::String(c.name).paddedRight(' ', 8)
+                      << juce::String(latency).paddedLeft(' ', 9)
+                      << juce::String(lag).paddedLeft(' ', 10)
+                      << (ok ? "\n" : "  MISALIGNED\n");
+        }
+        return failures == 0 ? 0 : 1;
+    }
+
+    // ── Grain clouds on a texture pad ───────────────────────────────────────
+
+    // One 8 s stereo pad: tones under noise, so grains differ
+    std::unique_ptr<H9SampleSet> makeTexturePad()
+    {
+        const int frames = (int)(8.0 * sampleRate);
+        juce::AudioBuffer<float> audio(2, frames);
+        juce::Random rng(11);
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < frames; ++i)
+                audio.setSample(ch, i, 0.3f * std::sin(0.01f * (float)(ch + 2) * (float)i)
+                                           + 0.1f * (rng.nextFloat() * 2.0f - 1.0f));
+
+        auto set = std::make_unique<H9SampleSet>();
+        set->pads[0].store.build(audio, H9SampleStore::Format::float32);
+        set->pads[0].sampleRate = sampleRate;
+        return set;
+    }
+
+    int benchmarkTexture(int blockFrames, int numVoices)
+    {
+        juce::ScopedNoDenormals noDenormals;
+
+        const double nsPerTick  = 1.0e9 / (double)juce::Time::getHighResolutionTicksPerSecond();
+        const double deadlineNs = 1.0e9 * blockFrames / sampleRate;
+        const int warmup = (int)(0.5 * sampleRate) / blockFrames;    // clouds fill up
+        const int blocks = (int)(2.0 * sampleRate) / blockFrames;
+
+        std::cout << "HALO9 texture — " << numVoices << " voice(s), 250 ms Hann grains, "
+                  << blockFrames << "-sample blocks\n\n"
+                  << "grains/s  sounding  ns/grain-smp   us/block  % of deadline  dropped\n";
+
+        juce::AudioBuffer<float> out(2, blockFrames);
+
+        for (float density : { 25.0f, 100.0f, 400.0f, 1000.0f, 2000.0f, 4000.0f })
+        {
+            H9PadSampler sampler;
+            sampler.prepare(sampleRate, blockFrames);
+            sampler.setSampleSet(makeTexturePad());
+            sampler.beginBlock();
+
+            H9GranularEngine::Settings s;
+            s.density = density;
+            s.sizeMs  = 250.0f;
+            s.scan    = 0.25f;
+            s.spray   = 0.5f;
+            sampler.setPadTexture(0, true);
+            sampler.setTextureSettings(s);
+            sampler.setVoiceLimit(H9PadSampler::maxVoices);
+
+            for (int v = 0; v < numVoices; ++v)
+                sampler.startVoice(0, 1.0f, 0);
+
+            double ticks = 0.0, grainSamples = 0.0;
+            for (int b = 0; b < warmup + blocks; ++b)
+            {
+                sampler.beginBlock();
+                out.clear();
+
+                const auto t0 = juce::Time::getHighResolutionTicks();
+                sampler.render(out, 0, blockFrames);
+                const auto t1 = juce::Time::getHighResolutionTicks();
+
+                if (b >= warmup)
+                {
+                    ticks += (double)(t1 - t0);
+                    grainSamples += (double)sampler.getGrainStats().active * blockFrames;
+                }
+            }
+
+            const auto stats = sampler.getGrainStats();
+            const double blockNs = ticks * nsPerTick / blocks;
+            std::cout << juce::String(density, 0).paddedLeft(' ', 8)
+                      << juce::String(juce::roundToInt(grainSamples / ((double)blocks * blockFrames))).paddedLeft(' ', 10)
+                      << juce::String(ticks * nsPerTick / juce::jmax(1.0, grainSamples), 2).paddedLeft(' ', 14)
+                      << juce::String(blockNs * 1.0e-3, 1).paddedLeft(' ', 11)
+                      << (juce::String(100.0 * blockNs / deadlineNs, 1) + " %").paddedLeft(' ', 15)
+                      << juce::String((juce::int64)stats.dropped).paddedLeft(' ', 9) << "\n";
+        }
+        return 0;
+    }
+
+    // The same cloud in 128- and 127-sample blocks, at the sample's rate and
+    // pitched up. A block that ends part-way through a grain's four-sample
+    // register must not move the grain on. Grains that finish in different
+    // blocks are summed in a different order, so rounding is allowed.
+    int checkTextureBlockSizes()
+    {
+        juce::ScopedNoDenormals noDenormals;
+
+        const int frames = (int)(2.0 * sampleRate);
+
+        auto render = [&](int blockFrames, float semitones)
+        {
+            H9PadSampler sampler;
+            sampler.prepare(sampleRate, blockFrames);
+            sampler.setSampleSet(makeTexturePad());
+            sampler.beginBlock();
+
+            H9GranularEngine::Settings s;
+            s.density = 400.0f;
+            s.sizeMs  = 250.0f;
+            s.scan    = 0.25f;
+            s.spray   = 0.5f;
+            sampler.setPadTexture(0, true);
+            sampler.setTextureSettings(s);
+            sampler.startVoice(0, 1.0f, 0, semitones);
+
+            juce::AudioBuffer<float> out(2, blockFrames);
+            std::vector<float> rendered;
+            rendered.reserve((size_t)frames * 2);
+
+            for (int pos = 0; pos < frames; pos += blockFrames)
+            {
+                sampler.beginBlock();
+                out.clear();
+                sampler.render(out, 0, blockFrames);
+
+                for (int i = 0; i < juce::jmin(blockFrames, frames - pos); ++i)
+                {
+                    rendered.push_back(out.getSample(0, i));
+                    rendered.push_back(out.getSample(1, i));
+                }
+            }
+            return rendered;
+        };
+
+        std::cout << "\nblocks 128 / 127  max difference  peak\n";
+
+        int failures = 0;
+        for (float semitones : { 0.0f, 7.0f })
+        {
+            const auto a = render(128, semitones);
+            const auto b = render(127, semitones);
+
+            float diff = 0.0f, peak = 0.0f;
+            for (size_t i = 0; i < a.size(); ++i)
+            {
+                diff = juce::jmax(diff, std::abs(a[i] - b[i]));
+                peak = juce::jmax(peak, std::abs(a[i]));
+            }
+
+            const bool ok = peak > 0.0f && diff <= 1.0e-5f;
+            failures += ok ? 0 : 1;
+
+            std::cout << (juce::String(semitones, 0) + " semitones").paddedRight(' ', 17)
+                      << juce::String(diff, 7).paddedLeft(' ', 15)
+                      << juce::String(peak, 3).paddedLeft(' ', 6)
+                      << (ok ? "\n" : "  DIFFERS\n");
+        }
+        return failures == 0 ? 0 : 1;
+    }
+
+    // ── Onset detection for loop slicing ────────────────────────────────────
+
+    // A 120 BPM drum loop at `rate`: kick, snare and eighth-note hats.
+    // `hits` gets the frame each hit starts on.
+    std::vector<float> makeDrumLoop(int bars, double rate, std::vector<int>& hits)
+    {
+        const int hitFrames = (int)(0.25 * rate);   // eighth notes at 120 BPM
+        const int numHits   = bars * 8;
+
+        std::vector<float> mono((size_t)(numHits * hitFrames), 0.0f);
+        juce::Random rng(3);
+        hits.clear();
+
+        for (int h = 0; h < numHits; ++h)
+        {
+            const int  at    = h * hitFrames;
+            const bool kick  = h % 4 == 0;
+            const bool snare = h % 4 == 2;
+            hits.push_back(at);
+
+            for (int i = 0; i < hitFrames; ++i)
+            {
+                const double t = i / rate;
+                const float  noise = rng.nextFloat() * 2.0f - 1.0f;
+                float v;
+                if (kick)       v = 0.9f * (float)(std::sin(juce::MathConstants<double>::twoPi * (55.0 + 120.0 * std::exp(-30.0 * t)) * t)
+                                               * std::exp(-8.0 * t));
+                else if (snare) v = (float)((0.9 * noise + 0.3 * std::sin(juce::MathConstants<double>::twoPi * 190.0 * t)) * std::exp(-25.0 * t));
+                else            v = (float)(0.2 * noise * std::exp(-90.0 * t));
+                mono[(size_t)(at + i)] += v;
+            }
+        }
+        return mono;
+    }
+
+    int benchmarkSlicing(int bars)
+    {
+        std::vector<int> hits;
+        const auto mono    = makeDrumLoop(bars, sampleRate, hits);
+        const int  numHits = (int)hits.size();
+        const int  frames  = (int)mono.size();
+
+        const double nsPerTick = 1.0e9 / (double)juce::Time::getHighResolutionTicksPerSecond();
+        std::vector<H9OnsetDetector::Onset> onsets;
+        std::vector<int> starts;
+        double best = 1.0e30;
+
+        for (int pass = 0; pass < 10; ++pass)
+        {
+            const auto t0 = juce::Time::getHighResolutionTicks();
+            H9OnsetDetector detector(sampleRate);
+            onsets = detector.detect(mono.data(), frames);
+            starts = detector.pickSlices(onsets, H9SampleSet::numPads);
+            best = juce::jmin(best, (double)(juce::Time::getHighResolutionTicks() - t0) * nsPerTick * 1.0e-6);
+        }
+
+        // Found: an onset at most 5 ms ahead of the hit or 1 ms after it
+        int found = 0;
+        double lead = 0.0;
+        for (int at : hits)
+            for (auto& o : onsets)
+                if (o.frame > at - (int)(0.005 * sampleRate) && o.frame < at + (int)(0.001 * sampleRate))
+                {
+                    ++found;
+                    lead += at - o.frame;
+                    break;
+                }
+
+        std::cout << "HALO9 slicing — " << bars << " bars at 120 BPM, "
+                  << juce::String(frames / sampleRate, 1) << " s at " << sampleRate << " Hz\n\n"
+                  << "analysis   " << juce::String(best, 2) << " ms (best of 10)\n"
+                  << "hits found " << found << " / " << numHits << " (" << (int)onsets.size() << " onsets), "
+                  << juce::String(found > 0 ? 1000.0 * lead / found / sampleRate : 0.0, 2) << " ms ahead on average\n"
+                  << "slices    ";
+        for (int start : starts)
+            std::cout << " " << juce::String(start / sampleRate, 3);
+        std::cout << " s\n";
+
+        return found == numHits ? 0 : 1;
+    }
+
+    // ── Step sequencer scheduling ───────────────────────────────────────────
+
+    struct Hit
+    {
+        juce::int64 sample;
+        int track;
+        bool operator== (const Hit& o) const { return sample == o.sample && track == o.track; }
+    };
+
+    // The hits of one block found sample by sample: a step sounds on the
+    // sample whose position is at or less than a sample past it
+    void referenceHits(const H9StepPattern& pattern, const H9StepSequencer::Transport& t,
+                       int numSamples, juce::int64 first, std::vector<Hit>& hits)
+    {
+        constexpr double onSample = 1.0e-6;
+        const double samplesPerBeat = sampleRate * 60.0 / t.bpm;
+        const int    perBeat = pattern.stepsPerBeat;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            double position = t.beat + i / samplesPerBeat;
+            if (t.looping && i >= (t.loopEnd - t.beat) * samplesPerBeat - onSample)
+                position = t.loopStart + (position - t.loopEnd);
+
+            const auto below = (juce::int64)std::floor(position * perBeat);
+            for (auto n = below; n <= below + 1; ++n)
+            {
+                const double past = (position - (double)n / perBeat) * samplesPerBeat;
+                if (past < -onSample || past >= 1.0 - onSample)
+                    continue;
+
+                const int step = (int)(((n % pattern.numSteps) + pattern.numSteps) % pattern.numSteps);
+                for (int track = 0; track < H9StepPattern::numTracks; ++track)
+                    if (pattern.velocity[(size_t)track][(size_t)step] != 0)
+                        hits.push_back({ first + i, track });
+            }
+        }
+    }
+
+    int benchmarkSequencer(int blockFrames)
+    {
+        const double nsPerTick  = 1.0e9 / (double)juce::Time::getHighResolutionTicksPerSecond();
+        const double deadlineNs = 1.0e9 * blockFrames / sampleRate;
+        const int blocks = (int)(120.0 * sampleRate) / blockFrames;
+
+        H9StepPattern pattern;
+        pattern.stepsPerBeat = 16;
+        pattern.numSteps     = H9StepPattern::maxSteps;
+        for (auto& track : pattern.velocity)
+            track.fill(100);
+
+        std::cout << "HALO9 sequencer — 8 tracks x 64 steps at 1/64, all on, "
+                  << blockFrames << "-sample blocks, 120 s each\n\n"
+                  << "host          hits   ns/block   ns/hit  % of deadline  wrong\n";
+
+        enum Host { steady120, steady300, sweep, cycle, jumps, countIn };
+        const std::pair<const char*, Host> hosts[] = {
+            { "120 BPM", steady120 }, { "300 BPM", steady300 }, { "60-300 BPM", sweep },
+            { "cycle", cycle }, { "jumps", jumps }, { "count-in", countIn } };
+
+        int wrong = 0;
+        for (const auto& [name, host] : hosts)
+        {
+            H9StepSequencer sequencer;
+            sequencer.prepare(sampleRate);
+            sequencer.setPattern(pattern);
+
+            juce::Random rng(7);
+            std::vector<Hit> got, expected;
+            got.reserve((size_t)blocks * 16);
+            expected.reserve(got.capacity());
+
+            H9StepSequencer::Transport t;
+            t.playing = true;
+            t.beat    = host == countIn ? -8.0 : 0.0;
+            t.looping = host == cycle;
+            t.loopStart = 2.0;
+            t.loopEnd   = 5.5;     // off the bar, so steps land anywhere in a block
+
+            double ticks = 0.0;
+            for (int b = 0; b < blocks; ++b)
+            {
+                t.bpm = host == steady300 ? 300.0
+                      : host == sweep     ? 180.0 + 120.0 * std::sin(b * 0.003)
+                                          : 120.0;
+
+                const bool jumped = host == jumps && b % 50 == 49;
+                if (jumped)
+                    t.beat = rng.nextDouble() * 64.0 - 4.0;
+
+                // Host positions are rounded: past the first block (or a
+                // jump), report the transport's position up to 0.1 sample off
+                auto reported = t;
+                if (b > 0 && !jumped)
+                    reported.beat += (rng.nextDouble() - 0.5) * 0.2 * t.bpm / (60.0 * sampleRate);
+
+                const auto t0 = juce::Time::getHighResolutionTicks();
+                const int n = sequencer.schedule(reported, blockFrames);
+                ticks += (double)(juce::Time::getHighResolutionTicks() - t0);
+
+                const juce::int64 first = (juce::int64)b * blockFrames;
+                for (int e = 0; e < n; ++e)
+                    got.push_back({ first + sequencer.getEvents()[e].sampleOffset, sequencer.getEvents()[e].track });
+                referenceHits(pattern, t, blockFrames, first, expected);
+
+                // Wrapping as the reference does, on the loop end or a hair before
+                t.beat += blockFrames * t.bpm / (60.0 * sampleRate);
+                if (t.looping && (t.beat - t.loopEnd) * sampleRate * 60.0 / t.bpm >= -1.0e-6)
+                    t.beat = t.loopStart + (t.beat - t.loopEnd);
+            }
+
+            std::sort(got.begin(), got.end(), [](const Hit& a, const Hit& b)
+                      { return a.sample != b.sample ? a.sample < b.sample : a.track < b.track; });
+
+            int mismatches = (int)std::abs((double)got.size() - (double)expected.size());
+            for (size_t i = 0; i < juce::jmin(got.size(), expected.size()); ++i)
+                if (!(got[i] == expected[i]))
+                    ++mismatches;
+            wrong += mismatches;
+
+            const double blockNs = ticks * nsPerTick / blocks;
+            std::cout << juce::String(name).paddedRight(' ', 11)
+                      << juce::String((juce::int64)got.size()).paddedLeft(' ', 7)
+                      << juce::String(blockNs, 1).paddedLeft(' ', 11)
+                      << juce::String(ticks * nsPerTick / juce::jmax<double>(1.0, (double)got.size()), 1).paddedLeft(' ', 9)
+                      << (juce::String(100.0 * blockNs / deadlineNs, 3) + " %").paddedLeft(' ', 15)
+                      << juce::String(mismatches).paddedLeft(' ', 7) << "\n";
+        }
+
+        return wrong == 0 ? 0 : 1;
+    }
+
+    // ── Processor harness ───────────────────────────────────────────────────
+    // The modes below drive the whole plugin: this thread stands in for the
+    // host's audio device while main() runs the message loop, so background
+    // loads are delivered and the processor's timer runs as in a host.
+
+    template <typename Fn>
+    void callOnMessageThread(Fn&& fn)
+    {
+        juce::WaitableEvent done;
+        juce::MessageManager::callAsync([&] { fn(); done.signal(); });
+        done.wait();
+    }
+
+    int runWithMessageLoop(std::function<int()> body)
+    {
+        juce::ScopedJuceInitialiser_GUI juce;
+        int result = 1;
+
+        std::thread device([&]
+        {
+            result = body();
+            juce::MessageManager::getInstance()->stopDispatchLoop();
+        });
+
+        juce::MessageManager::getInstance()->runDispatchLoop();
+        device.join();
+        return result;
+    }
+
+    struct ProcessorHandle
+    {
+        ProcessorHandle()
+        {
+            callOnMessageThread([this]
+            {
+                processor.reset(static_cast<HALO9PlayerAudioProcessor*>(createPluginFilter()));
+            });
+        }
+
+        ~ProcessorHandle()
+        {
+            callOnMessageThread([this] { processor.reset(); });
+        }
+
+        HALO9PlayerAudioProcessor* operator->() const { return processor.get(); }
+        HALO9PlayerAudioProcessor& operator*()  const { return *processor; }
+
+        void setParameter(const juce::String& id, float value) const
+        {
+            auto* param = processor->getAPVTS().getParameter(id);
+            jassert(param != nullptr);
+            param->setValueNotifyingHost(param->convertTo0to1(value));
+        }
+
+        std::unique_ptr<HALO9PlayerAudioProcessor> processor;
+    };
+
+    // Slices `file` across the pads and waits, running blocks, until the
+    // audio thread has the slices. False after 10 s.
+    bool loadSlices(ProcessorHandle& p, const juce::File& file, int blockFrames)
+    {
+        callOnMessageThread([&] { p->sliceLoopToPads(file); });
+
+        juce::AudioBuffer<float> buffer(2, blockFrames);
+        juce::MidiBuffer midi;
+        const auto deadline = juce::Time::getMillisecondCounter() + 10000;
+
+        while (juce::Time::getMillisecondCounter() < deadline)
+        {
+            if (!p->isLoadingSamples() && p->getSliceInfo().slices > 0)
+            {
+                p->processBlock(buffer, midi);   // adopts the new set
+                return true;
+            }
+            p->processBlock(buffer, midi);
+            juce::Thread::sleep(5);
+        }
+        return false;
+    }
+
+    // A mono WAV: `burstFrames` of DC at the start, then silence
+    std::unique_ptr<juce::TemporaryFile> writeBurst(int burstFrames, double seconds)
+    {
+        auto file = std::make_unique<juce::TemporaryFile>(".wav");
+        const int frames = (int)(seconds * sampleRate);
+
+        juce::AudioBuffer<float> audio(1, frames);
+        audio.clear();
+        for (int i = 0; i < burstFrames; ++i)
+            audio.setSample(0, i, 0.5f);
+
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(
+            wav.createWriterFor(new juce::FileOutputStream(file->getFile()), sampleRate, 1, 24, {}, 0));
+        if (writer == nullptr || !writer->writeFromAudioSampleBuffer(audio, 0, frames))
+            return {};
+        return file;
+    }
+
+    // Rising edges in a pad-hit recording: above `on` after at least
+    // `quiet` samples below `off`
+    std::vector<juce::int64> findEdges(const std::vector<float>& signal, int quiet = 64,
+                                       float on = 0.05f, float off = 0.01f)
+    {
+        std::vector<juce::int64> edges;
+        int below = quiet;
+        for (size_t i = 0; i < signal.size(); ++i)
+        {
+            const float a = std::abs(signal[i]);
+            if (a > on && below >= quiet)
+                edges.push_back((juce::int64)i);
+            below = a < off ? below + 1 : 0;
+        }
+        return edges;
+    }
+
+    // A host transport from bar 1 in 4/4
+    struct TestPlayHead : juce::AudioPlayHead
+    {
+        double bpm     { 120.0 };
+        double ppq     { 0.0 };
+        bool   playing { true };
+
+        juce::Optional<PositionInfo> getPosition() const override
+        {
+            PositionInfo info;
+            const double bar = std::floor(ppq / 4.0);
+            info.setBpm(bpm);
+            info.setPpqPosition(ppq);
+            info.setIsPlaying(playing);
+            info.setTimeSignature(TimeSignature {});
+            info.setBarCount((juce::int64)bar);
+            info.setPpqPositionOfLastBarStart(bar * 4.0);
+            return info;
+        }
+
+        void advance(int frames) noexcept
+        {
+            if (playing)
+                ppq += frames * bpm / (60.0 * sampleRate);
+        }
+    };
+
+    // The chain's own delay, from MIDI hits on pad 1 at known offsets. The
+    // processor must be dry, flat and stopped, with a burst on pad 1.
+    bool measureChainDelay(ProcessorHandle& p, int blockFrames, juce::int64& chainDelay)
+    {
+        juce::AudioBuffer<float> buffer(2, blockFrames);
+        juce::MidiBuffer midi;
+        std::vector<float> recorded;
+        std::vector<juce::int64> midiAt;
+
+        for (int b = 0; b < 32; ++b)
+        {
+            midi.clear();
+            if (b % 4 == 1)
+            {
+                const int offset = (b * 37) % blockFrames;
+                midi.addEvent(juce::MidiMessage::noteOn(1, HALO9PlayerAudioProcessor::PAD_BASE_NOTE, 1.0f), offset);
+                midiAt.push_back((juce::int64)b * blockFrames + offset);
+            }
+            p->processBlock(buffer, midi);
+            recorded.insert(recorded.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + blockFrames);
+        }
+
+        const auto midiEdges = findEdges(recorded);
+        if (midiEdges.size() != midiAt.size())
+        {
+            std::cerr << "calibration: " << midiEdges.size() << " edges for " << midiAt.size() << " MIDI hits\n";
+            return false;
+        }
+
+        chainDelay = midiEdges.front() - midiAt.front();
+        for (size_t i = 0; i < midiAt.size(); ++i)
+            if (midiEdges[i] - midiAt[i] != chainDelay)
+            {
+                std::cerr << "calibration: MIDI hits land " << chainDelay << " and "
+                          << (midiEdges[i] - midiAt[i]) << " samples late\n";
+                return false;
+            }
+        return true;
+    }
+
+    // ── Loop slicing, whole job ─────────────────────────────────────────────
+
+    // Times H9LoopSlicer from slice() to onSliced on the message thread:
+    // reading and hashing the file, decoding, SRC from 44.1 kHz, onset
+    // detection, picking and snapping the slices, and the hand-back
+    int benchmarkSliceJob(int bars)
+    {
+        constexpr double fileRate = 44100.0;
+        constexpr double budgetMs = 100.0;
+        constexpr int    passes   = 10;
+
+        std::vector<int> hits;
+        const auto mono = makeDrumLoop(bars, fileRate, hits);
+
+        juce::TemporaryFile loop(".wav");
+        {
+            juce::AudioBuffer<float> audio(2, (int)mono.size());
+            for (int ch = 0; ch < 2; ++ch)
+                audio.copyFrom(ch, 0, mono.data(), (int)mono.size());
+
+            juce::WavAudioFormat wav;
+            std::unique_ptr<juce::AudioFormatWriter> writer(
+                wav.createWriterFor(new juce::FileOutputStream(loop.getFile()), fileRate, 2, 24, {}, 0));
+            if (writer == nullptr || !writer->writeFromAudioSampleBuffer(audio, 0, audio.getNumSamples()))
+            {
+                std::cerr << "could not write the test loop\n";
+                return 1;
+            }
+        }
+
+        return runWithMessageLoop([&]
+        {
+            std::unique_ptr<H9LoopSlicer> slicer;
+            juce::WaitableEvent sliced;
+            juce::int64 doneTicks = 0;
+            H9LoopSlicer::Result result;
+
+            callOnMessageThread([&]
+            {
+                slicer = std::make_unique<H9LoopSlicer>();
+                slicer->onSliced = [&](H9LoopSlicer::Result&& r)
+                {
+                    doneTicks = juce::Time::getHighResolutionTicks();
+                    result = std::move(r);
+                    sliced.signal();
+                };
+            });
+
+            std::vector<double> totalMs, analysisMs;
+            bool lost = false;
+
+            for (int pass = 0; pass < passes && !lost; ++pass)
+            {
+                sliced.reset();
+                const auto t0 = juce::Time::getHighResolutionTicks();
+                callOnMessageThread([&] { slicer->slice(loop.getFile(), sampleRate); });
+
+                if (!sliced.wait(10000) || result.set == nullptr)
+                {
+                    lost = true;
+                    break;
+                }
+
+                totalMs.push_back(juce::Time::highResolutionTicksToSeconds(doneTicks - t0) * 1000.0);
+                analysisMs.push_back(result.analysisMs);
+            }
+
+            const int slices = (int)result.starts.size();
+            callOnMessageThread([&] { slicer.reset(); });
+
+            if (lost)
+            {
+                std::cerr << "the slicer never delivered\n";
+                return 1;
+            }
+
+            const double worst = *std::max_element(totalMs.begin(), totalMs.end());
+            const double best  = *std::min_element(totalMs.begin(), totalMs.end());
+            const double worstAnalysis = *std::max_element(analysisMs.begin(), analysisMs.end());
+
+            std::cout << "\nWhole slicing job — " << bars << "-bar stereo 24-bit WAV at "
+                      << fileRate << " Hz, sliced at " << sampleRate << " Hz, " << passes << " passes\n\n"
+                      << "slice() → onSliced  best " << juce::String(best, 2) << " ms, worst "
+                      << juce::String(worst, 2) << " ms (budget " << budgetMs << " ms)\n"
+                      << "  of which analysis worst " << juce::String(worstAnalysis, 2)
+                      << " ms; read, decode and SRC the rest\n"
+                      << "slices " << slices << " / " << H9SampleSet::numPads << "\n";
+
+            return worst <= budgetMs && slices == H9SampleSet::numPads ? 0 : 1;
+        });
+    }
+
+    // ── UI trigger timing ───────────────────────────────────────────────────
+
+    int benchmarkLatency(int blockFrames, double seconds)
+    {
+        auto burst = writeBurst(240, 1.0);
+        if (burst == nullptr)
+        {
+            std::cerr << "could not write the test sample\n";
+            return 1;
+        }
+
+        return runWithMessageLoop([&]
+        {
+            ProcessorHandle p;
+
+            // Dry and flat, so every hit is one clean edge
+            p.setParameter("atmosphere", 0.0f);
+            p.setParameter("lowpass_cutoff", 20000.0f);
+            p.setParameter("tape_enabled", 0.0f);
+            p.setParameter("seq_enabled", 0.0f);
+
+            p->prepareToPlay(sampleRate, blockFrames);
+
+            if (!loadSlices(p, burst->getFile(), blockFrames))
+            {
+                std::cerr << "the test sample never reached the pads\n";
+                return 1;
+            }
+
+            juce::AudioBuffer<float> buffer(2, blockFrames);
+            juce::MidiBuffer midi;
+
+            juce::int64 chainDelay = 0;
+            if (!measureChainDelay(p, blockFrames, chainDelay))
+                return 1;
+
+            // ── UI hits in real time ─────────────────────────────────────────
+            // The device thread (this one) runs blocks on the clock; a second
+            // thread, the only producer as the editor would be, hits pad 1
+            // every 15 – 40 ms and notes when
+            const int numBlocks = (int)(seconds * sampleRate / blockFrames);
+            std::vector<double> blockStartMs((size_t)numBlocks, 0.0);
+            std::vector<double> hitMs;
+            std::atomic<bool> running { true };
+            std::vector<float> recorded((size_t)numBlocks * (size_t)blockFrames, 0.0f);
+
+            std::thread ui([&]
+            {
+                juce::Random rng(29);
+                while (running.load())
+                {
+                    juce::Thread::sleep(15 + rng.nextInt(26));
+                    if (!running.load()) break;
+                    hitMs.push_back(juce::Time::getMillisecondCounterHiRes());
+                    p->triggerPadFromUI(0, 1.0f);
+                }
+            });
+
+            const double periodMs = 1000.0 * blockFrames / sampleRate;
+            const double startMs  = juce::Time::getMillisecondCounterHiRes();
+
+            for (int b = 0; b < numBlocks; ++b)
+            {
+                const double due = startMs + b * periodMs;
+                while (juce::Time::getMillisecondCounterHiRes() < due)
+                    juce::Thread::sleep(due - juce::Time::getMillisecondCounterHiRes() > 1.5 ? 1 : 0);
+
+                blockStartMs[(size_t)b] = juce::Time::getMillisecondCounterHiRes();
+                p->processBlock(buffer, midi);
+                std::copy(buffer.getReadPointer(0), buffer.getReadPointer(0) + blockFrames,
+                          recorded.begin() + (std::ptrdiff_t)b * blockFrames);
+            }
+
+            running.store(false);
+            ui.join();
+
+            auto edges = findEdges(recorded);
+            for (auto& e : edges) e -= chainDelay;
+
+            const size_t n = juce::jmin(edges.size(), hitMs.size());
+            int worst = 0, wrong = 0;
+            double errorSum = 0.0, latencyMin = 1.0e30, latencyMax = 0.0, latencySum = 0.0;
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                // Expected: as far into its block as the hit came after the
+                // previous block started
+                const int block  = (int)(edges[i] / blockFrames);
+                const int offset = (int)(edges[i] % blockFrames);
+                if (block == 0) { ++wrong; continue; }
+
+                const int expected = juce::jlimit(0, blockFrames - 1,
+                    (int)((hitMs[i] - blockStartMs[(size_t)block - 1]) * sampleRate * 0.001));
+                const int error = offset - expected;
+
+                worst = std::abs(error) > std::abs(worst) ? error : worst;
+                errorSum += std::abs(error);
+                if (std::abs(error) > 1) ++wrong;
+
+                const double latency = blockStartMs[(size_t)block] + 1000.0 * offset / sampleRate - hitMs[i];
+                latencyMin = juce::jmin(latencyMin, latency);
+                latencyMax = juce::jmax(latencyMax, latency);
+                latencySum += latency;
+            }
+
+            // Hits made after the last block started may still be queued
+            const auto due = (size_t)std::count_if(hitMs.begin(), hitMs.end(),
+                                                   [&](double t) { return t < blockStartMs.back(); });
+            const size_t queued = hitMs.size() - n;
+            const bool   lost   = n < due;
+
+            std::cout << "HALO9 UI trigger timing — block " << blockFrames << " at " << sampleRate << " Hz ("
+                      << juce::String(periodMs, 2) << " ms), " << seconds << " s\n\n"
+                      << "hits:          " << hitMs.size() << " (" << queued << " still queued at the end"
+                      << (lost ? ", some never played" : "") << ")\n"
+                      << "chain delay:   " << chainDelay << " samples (from MIDI hits)\n"
+                      << "offset error:  mean " << juce::String(errorSum / (double)juce::jmax((size_t)1, n), 2)
+                      << "  worst " << worst << " samples, " << wrong << " beyond ±1\n"
+                      << "hit → sample:  " << juce::String(latencySum / (double)juce::jmax((size_t)1, n), 2)
+                      << " ms mean, " << juce::String(latencyMin, 2) << " – " << juce::String(latencyMax, 2)
+                      << " ms (one block = " << juce::String(periodMs, 2) << " ms)\n";
+
+            return wrong == 0 && !lost ? 0 : 1;
+        });
+    }
+
+    // ── Step sequencer through the processor ────────────────────────────────
+
+    // Sets a pattern the way the editor's grid does (setStepPattern on the
+    // message thread), turns seq_enabled on and plays the processor from a
+    // host transport, then checks every step sounds on the first sample at
+    // or after its position once the chain's delay is taken off
+    int checkSequencerInProcessor(int blockFrames)
+    {
+        constexpr int bars = 8;
+        auto burst = writeBurst(240, 1.0);
+        if (burst == nullptr)
+        {
+            std::cerr << "could not write the test sample\n";
+            return 1;
+        }
+
+        // Sliced, the burst plays on pad 1: only track 1 has steps
+        H9StepPattern pattern;
+        for (int step : { 0, 2, 3, 5, 8, 11, 12, 14 })
+            pattern.velocity[0][(size_t)step] = 100;
+
+        std::cout << "\nSequencer through the processor — track 1, " << bars << " bars, "
+                  << blockFrames << "-sample blocks\n\n"
+                  << "host         hits  missing  extra  wrong\n";
+
+        return runWithMessageLoop([&]
+        {
+            int failures = 0;
+
+            for (double bpm : { 120.0, 97.3 })
+            {
+                ProcessorHandle p;
+
+                p.setParameter("atmosphere", 0.0f);
+                p.setParameter("lowpass_cutoff", 20000.0f);
+                p.setParameter("tape_enabled", 0.0f);
+                p.setParameter("seq_enabled", 0.0f);
+
+                p->prepareToPlay(sampleRate, blockFrames);
+
+                juce::int64 chainDelay = 0;
+                if (!loadSlices(p, burst->getFile(), blockFrames)
+                    || !measureChainDelay(p, blockFrames, chainDelay))
+                {
+                    std::cerr << "the test sample never reached the pads\n";
+                    return 1;
+                }
+
+                callOnMessageThread([&] { p->setStepPattern(pattern); });
+                p.setParameter("seq_enabled", 1.0f);
+
+                TestPlayHead playHead;
+                playHead.bpm = bpm;
+                p->setPlayHead(&playHead);
+
+                const double samplesPerStep = sampleRate * 60.0 / bpm / pattern.stepsPerBeat;
+                const int numBlocks = (int)std::ceil(bars * 4 * pattern.stepsPerBeat * samplesPerStep / blockFrames);
+
+                juce::AudioBuffer<float> buffer(2, blockFrames);
+                juce::MidiBuffer midi;
+                std::vector<float> recorded;
+                recorded.reserve((size_t)numBlocks * (size_t)blockFrames);
+
+                for (int b = 0; b < numBlocks; ++b)
+                {
+                    p->processBlock(buffer, midi);
+                    recorded.insert(recorded.end(), buffer.getReadPointer(0), buffer.getReadPointer(0) + blockFrames);
+                    playHead.advance(blockFrames);
+                }
+                p->setPlayHead(nullptr);
+
+                std::vector<juce::int64> expected;
+                for (int n = 0; n * samplesPerStep < (double)recorded.size(); ++n)
+                    if (pattern.velocity[0][(size_t)(n % pattern.numSteps)] != 0)
+                        expected.push_back((juce::int64)std::ceil(n * samplesPerStep - 1.0e-6));
+
+                auto edges = findEdges(recorded);
+                for (auto& e : edges) e -= chainDelay;
+
+                // Hits the recording cut off can't be heard
+                const auto audible = (juce::int64)recorded.size() - chainDelay;
+                expected.erase(std::remove_if(expected.begin(), expected.end(),
+                                              [&](juce::int64 at) { return at >= audible; }),
+                               expected.end());
+
+                int missing = 0, wrong = 0;
+                for (auto at : expected)
+                {
+                    const auto it = std::lower_bound(edges.begin(), edges.end(), at - 2);
+                    if (it == edges.end() || *it > at + 2) ++missing;
+                    else if (*it != at)                    ++wrong;
+                }
+                const int extra = juce::jmax(0, (int)edges.size() - ((int)expected.size() - missing));
+                failures += missing + extra + wrong;
+
+                std::cout << (juce::String(bpm, 1) + " BPM").paddedRight(' ', 11)
+                          << juce::String((int)edges.size()).paddedLeft(' ', 6)
+                          << juce::String(missing).paddedLeft(' ', 9)
+                          << juce::String(extra).paddedLeft(' ', 7)
+                          << juce::String(wrong).paddedLeft(' ', 7) << "\n";
+            }
+
+            return failures == 0 ? 0 : 1;
+        });
+    }
+
+    // ── Real-time safety of processBlock ────────────────────────────────────
+
+    void sleepUntil(double timeMs)
+    {
+        while (juce::Time::getMillisecondCounterHiRes() < timeMs)
+            juce::Thread::sleep(timeMs - juce::Time::getMillisecondCounterHiRes() > 1.5 ? 1 : 0);
+    }
+
+   #if HALO9_RT_SANITIZER
+    // The voice workers on their own, paced like audio callbacks so they
+    // park between blocks and every block has to wake them from the audio
+    // thread. Fails on any violation, or if no task ever ran on a worker
+    // while there was a second core for it.
+    int checkWorkerWakeups(int blockFrames, double seconds)
+    {
+        constexpr int numThreads = 4;
+
+        H9RealtimeWorkers workers(numThreads);
+        H9PadSampler sampler;
+        sampler.prepare(sampleRate, blockFrames);
+        sampler.setSampleSet(makeKit(H9SampleStore::Format::float32));
+
+        juce::AudioBuffer<float> out(2, blockFrames);
+        juce::Random rng(41);
+        std::array<std::atomic<int>, numThreads> tasksRun {};
+
+        const int numBlocks = (int)(seconds * sampleRate / blockFrames);
+        const double periodMs = 1000.0 * blockFrames / sampleRate;
+        const double startMs  = juce::Time::getMillisecondCounterHiRes();
+
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            sleepUntil(startMs + b * periodMs);
+
+            H9_RT_SCOPE;
+            sampler.beginBlock();
+            out.clear();
+
+            for (int hit = 0; hit < 4; ++hit)
+                sampler.startVoice(rng.nextInt(H9SampleSet::numPads), 0.8f,
+                                   rng.nextInt(blockFrames), rng.nextFloat() * 12.0f - 6.0f);
+
+            sampler.render(out, 0, blockFrames, &workers);
+
+            // Voices only go parallel above a few at once; these always do
+            workers.run(4 * numThreads, [&](int, int thread)
+            {
+                tasksRun[(size_t)thread].fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+
+        int onWorkers = 0;
+        for (int t = 1; t < numThreads; ++t)
+            onWorkers += tasksRun[(size_t)t].load();
+
+        const int violations = H9RealtimeSanitizer::getNumViolations();
+
+        std::cout << "HALO9 worker wake-ups — " << numBlocks << " blocks of " << blockFrames
+                  << ", " << numThreads << " threads\n\n"
+                  << "tasks:       " << tasksRun[0].load() << " audio thread, " << onWorkers << " workers\n"
+                  << "violations:  " << violations << "\n\n";
+
+        if (violations > 0)
+        {
+            H9RealtimeSanitizer::printReport();
+            H9RealtimeSanitizer::reset();
+            return 1;
+        }
+
+        if (onWorkers == 0 && juce::SystemStats::getNumCpus() > 1)
+        {
+            std::cerr << "no task ran on a worker thread\n";
+            return 1;
+        }
+        return 0;
+    }
+   #endif
+
+    int checkRealtimeSafety(int blockFrames, double seconds)
+    {
+       #if ! HALO9_RT_SANITIZER
+        juce::ignoreUnused(blockFrames, seconds);
+        std::cerr << "built without HALO9_RT_SANITIZER — configure with -DHALO9_RT_SANITIZER=ON\n";
+        return 1;
+       #else
+        if (checkWorkerWakeups(blockFrames, juce::jmin(seconds, 2.0)) != 0)
+            return 1;
+
+        auto burst = writeBurst(2400, 2.0);
+        if (burst == nullptr)
+        {
+            std::cerr << "could not write the test sample\n";
+            return 1;
+        }
+
+        return runWithMessageLoop([&]
+        {
+            ProcessorHandle p;
+            TestPlayHead playHead;
+
+            // Every stage on: worker threads, tape at 4×, sequencer, profiler
+            p.setParameter("voice_threads", 1.0f);
+            p.setParameter("tape_enabled", 1.0f);
+            p.setParameter("tape_oversampling", 1.0f);
+            p.setParameter("seq_enabled", 1.0f);
+            p->getProfiler().setEnabled(true);
+
+            p->setPlayHead(&playHead);
+            p->prepareToPlay(sampleRate, blockFrames);
+
+            if (!loadSlices(p, burst->getFile(), blockFrames))
+            {
+                std::cerr << "the test sample never reached the pads\n";
+                return 1;
+            }
+
+            H9StepPattern pattern;
+            for (int track = 0; track < H9StepPattern::numTracks; ++track)
+                for (int step = track % 3; step < pattern.numSteps; step += 3)
+                    pattern.velocity[(size_t)track][(size_t)step] = (juce::uint8)(60 + 8 * track);
+
+            callOnMessageThread([&]
+            {
+                p->loadLoop(burst->getFile());
+                p->setStepPattern(pattern);
+            });
+
+            juce::AudioBuffer<float> buffer(2, blockFrames);
+            juce::MidiBuffer midi;
+            juce::Random rng(30);
+
+            const int numBlocks = (int)(seconds * sampleRate / blockFrames);
+            const double periodMs = 1000.0 * blockFrames / sampleRate;
+            const double startMs  = juce::Time::getMillisecondCounterHiRes();
+            juce::int64 midiHits = 0, uiHits = 0;
+
+            for (int b = 0; b < numBlocks; ++b)
+            {
+                // Host automation, a stop and a relocation now and then
+                if (b % 200 == 0)
+                {
+                    p.setParameter("atmosphere", rng.nextFloat());
+                    p.setParameter("reverb_lines", (float)rng.nextInt(3));
+                    p.setParameter("reverb_type", (float)rng.nextInt(2));
+                }
+                if (b % 500 == 250) playHead.playing = false;
+                if (b % 500 == 300) { playHead.playing = true; playHead.ppq = 4.0 * rng.nextInt(16); }
+
+                midi.clear();
+                for (int i = rng.nextInt(4); --i >= 0;)
+                {
+                    const int note = rng.nextBool()
+                        ? HALO9PlayerAudioProcessor::PAD_BASE_NOTE + rng.nextInt(HALO9PlayerAudioProcessor::NUM_PADS)
+                        : HALO9PlayerAudioProcessor::KEYS_LOW_NOTE
+                              + rng.nextInt(HALO9PlayerAudioProcessor::KEYS_HIGH_NOTE - HALO9PlayerAudioProcessor::KEYS_LOW_NOTE + 1);
+                    midi.addEvent(juce::MidiMessage::noteOn(1, note, 0.3f + 0.7f * rng.nextFloat()),
+                                  rng.nextInt(blockFrames));
+                    ++midiHits;
+                }
+
+                if (b % 7 == 0)
+                {
+                    p->triggerPadFromUI(rng.nextInt(HALO9PlayerAudioProcessor::NUM_PADS), 1.0f);
+                    ++uiHits;
+                }
+
+                sleepUntil(startMs + b * periodMs);
+                p->processBlock(buffer, midi);
+                playHead.advance(blockFrames);
+            }
+
+            const int violations = H9RealtimeSanitizer::getNumViolations();
+            const auto seq = p->getSequencerStats();
+
+            std::cout << "HALO9 real-time check — " << numBlocks << " blocks of " << blockFrames
+                      << " at " << sampleRate << " Hz\n\n"
+                      << "hits:        " << midiHits << " MIDI, " << uiHits << " UI, "
+                      << seq.events << " sequenced\n"
+                      << "loop:        " << juce::String(p->getLoopPlayer().getInfo().seconds, 2) << " s\n"
+                      << "violations:  " << violations << "\n";
+
+            if (violations > 0)
+            {
+                // Reported here rather than by the exit hook, with the numbers above
+                H9RealtimeSanitizer::printReport();
+                H9RealtimeSanitizer::reset();
+                return 1;
+            }
+            return 0;
+        });
+       #endif
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && juce::String(argv[1]) == "kernels")
+        return benchmarkKernels();
+
+    if (argc > 1 && juce::String(argv[1]) == "tone")
+        return benchmarkTone(argc > 2 ? juce::jlimit(16, 1 << 16, juce::String(argv[2]).getIntValue()) : 128);
+
+    if (argc > 1 && juce::String(argv[1]) == "reverb")
+        return benchmarkReverb(argc > 2 ? juce::jlimit(16, 1 << 16, juce::String(argv[2]).getIntValue()) : 128);
+
+    if (argc > 1 && juce::String(argv[1]) == "convolution")
+        return benchmarkConvolution(argc > 2 ? juce::jlimit(16, 1 << 16, juce::String(argv[2]).getIntValue()) : 128);
+
+    if (argc > 1 && juce::String(argv[1]) == "tape")
+    {
+        const int blockFrames = argc > 2 ? juce::jlimit(16, 1 << 16, juce::String(argv[2]).getIntValue()) : 128;
+        const int result = benchmarkTape(blockFrames);
+        return checkTapeLatency(blockFrames) != 0 ? 1 : result;
+    }
+
+    if (argc > 1 && juce::String(argv[1]) == "slice")
+    {
+        const int bars  = argc > 2 ? juce::jlimit(1, 64, juce::String(argv[2]).getIntValue()) : 4;
+        const int found = benchmarkSlicing(bars);
+        return benchmarkSliceJob(bars) != 0 ? 1 : found;
+    }
+
+    if (argc > 1 && juce::String(argv[1]) == "texture")
+    {
+        const int result = benchmarkTexture(argc > 2 ? juce::jlimit(16, 1 << 16, juce::String(argv[2]).getIntValue()) : 128,
+                                            argc > 3 ? juce::jlimit(1, H9PadSampler::maxVoices, juce::String(argv[3]).getIntValue()) : 1);
+        return checkTextureBlockSizes() != 0 ? 1 : result;
+    }
+
+    if (argc > 1 && juce::String(argv[1]) == "sequencer")
+    {
+        const int blockFrames = argc > 2 ? juce::jlimit(16, 1 << 16, juce::String(argv[2]).getIntValue()) : 128;
+        const int scheduled   = benchmarkSequencer(blockFrames);
+        return checkSequencerInProcessor(blockFrames) != 0 ? 1 : scheduled;
+    }
+
+    if (argc > 1 && juce::String(argv[1]) == "latency")
+        return benchmarkLatency(argc > 2 ? juce::jlimit(32, 8192, juce::String(argv[2]).getIntValue()) : 512,
+                                argc > 3 ? juce::jmax(1.0, juce::String(argv[3]).getDoubleValue()) : 10.0);
+
+    if (argc > 1 && juce::String(argv[1]) == "rtcheck")
+        return checkRealtimeSafety(argc > 2 ? juce::jlimit(32, 8192, juce::String(argv[2]).getIntValue()) : 256,
+                                   argc > 3 ? juce::jmax(1.0, juce::String(argv[3]).getDoubleValue()) : 5.0);
+
+    if (argc > 1 && juce::String(argv[1]) == "threads")
+        return benchmarkThreads(argc > 2 ? juce::jlimit(32, 1 << 16, juce::String(argv[2]).getIntValue()) : 4096,
+                                argc > 3 ? juce::jmax(1.0, juce::String(argv[3]).getDoubleValue()) : 10.0);
+
+    const double hitsPerSecond = argc > 1 ? juce::jmax(1.0, juce::String(argv[1]).getDoubleValue()) : 1000.0;
+    const double seconds       = argc > 2 ? juce::jmax(1.0, juce::String(argv[2]).getDoubleValue()) : 30.0;
+    const auto   storage       = H9SampleStore::parseFormat(argc > 3 ? juce::String(argv[3]) : juce::String());
+
+    H9PadSampler sampler;
+    sampler.prepare(sampleRate, blockSize);
+    sampler.setSampleSet(makeKit(storage));
+
+    juce::AudioBuffer<float> out(2, blockSize);
+    juce::Random rng(42);
+
+    const double nsPerTick = 1.0e9 / (double)juce::Time::getHighResolutionTicksPerSecond();
+    const int numBlocks = (int)(seconds * sampleRate / blockSize);
+
+    std::vector<double> renderUs;
+    renderUs.reserve((size_t)numBlocks);
+    double maxHitNs = 0.0, totalHitNs = 0.0;
+    juce::int64 hits = 0;
+    double hitClock = 0.0;   // fractional hits carried between blocks
+
+    for (int b = 0; b < numBlocks; ++b)
+    {
+        sampler.beginBlock();
+        out.clear();
+
+        hitClock += hitsPerSecond * blockSize / sampleRate;
+        for (; hitClock >= 1.0; hitClock -= 1.0)
+        {
+            const int pad    = rng.nextInt(H9SampleSet::numPads);
+            const int offset = rng.nextInt(blockSize);
+
+            const auto t0 = juce::Time::getHighResolutionTicks();
+            sampler.startVoice(pad, 0.5f + 0.5f * rng.nextFloat(), offset);
+            const double ns = (double)(juce::Time::getHighResolutionTicks() - t0) * nsPerTick;
+
+            maxHitNs = juce::jmax(maxHitNs, ns);
+            totalHitNs += ns;
+            ++hits;
+        }
+
+        const auto t0 = juce::Time::getHighResolutionTicks();
+        sampler.render(out, 0, blockSize);
+        renderUs.push_back((double)(juce::Time::getHighResolutionTicks() - t0) * nsPerTick * 1.0e-3);
+
+        sampler.collectGarbage();
+    }
+
+    const double deadlineUs = 1.0e6 * blockSize / sampleRate;
+    const double p99 = percentile(renderUs, 0.99);
+
+    std::cout << "HALO9 voice stress — " << hitsPerSecond << " hits/s for " << seconds << " s, "
+              << H9SampleStore::getFormatName(storage) << ", "
+              << H9PadSampler::maxVoices << " voices + " << H9PadSampler::maxReleasing << " fade slots\n\n"
+              << "hits:          " << hits << "\n"
+              << "startVoice:    mean " << juce::String(totalHitNs / (double)juce::jmax((juce::int64)1, hits), 0)
+              << " ns  max " << juce::String(maxHitNs, 0) << " ns\n"
+              << "render/block:  p50 " << juce::String(percentile(renderUs, 0.50), 1)
+              << " us  p99 " << juce::String(p99, 1)
+              << " us  max " << juce::String(*std::max_element(renderUs.begin(), renderUs.end()), 1)
+              << " us  (deadline " << juce::String(deadlineUs, 0) << " us, p99 "
+              << juce::String(100.0 * p99 / deadlineUs, 1) << "%)\n";
+    return 0;
+}
@@ -4,6 +4,7 @@
 # Usage:
 #   ./build.sh                  Build Release (Xcode on macOS, Makefiles on Linux)
 #   ./build.sh debug            Build Debug
+#   ./build.sh rtsan            Build Debug with the real-time safety sanitizer
 #   ./build.sh clean            Remove build dir and start fresh
 #   ./build.sh xcode            Generate Xcode project only (don't build)
 #   ./build.sh install          Build Release + install VST3 to system folder
@@ -76,7 +77,7 @@ fi
 if [ "$(uname)" = "Darwin" ]; then
     check_tool xcodebuild
     GENERATOR="Xcode"
-    if [ "$CONFIG" = "debug" ]; then
+    if [ "$CONFIG" = "debug" ] || [ "$CONFIG" = "rtsan" ]; then
         BUILD_CONFIG="Debug"
     else
         BUILD_CONFIG="Release"
@@ -87,7 +88,7 @@ else
     else
         GENERATOR="Unix Makefiles"
     fi
-    if [ "$CONFIG" = "debug" ]; then
+    if [ "$CONFIG" = "debug" ] || [ "$CONFIG" = "rtsan" ]; then
         BUILD_CONFIG="Debug"
     else
         BUILD_CONFIG="Release"
@@ -102,6 +103,15 @@ if [ -n "${JUCE_DIR:-}" ]; then
     CMAKE_EXTRA_ARGS+=("-DJUCE_DIR=${JUCE_DIR}")
 fi
 
+# ── Optional: real-time safety sanitizer ───────────────────────────────────
+
+if [ "$CONFIG" = "rtsan" ]; then
+    cyan "Real-time sanitizer enabled (HALO9_RT_SANITIZER=ON)"
+    CMAKE_EXTRA_ARGS+=("-DHALO9_RT_SANITIZER=ON")
+else
+    CMAKE_EXTRA_ARGS+=("-DHALO9_RT_SANITIZER=OFF")
+fi
+
 # ── "xcode" command: generate only, don't build ─────────────────────────────
 
 if [ "$CONFIG" = "xcode" ]; then
@@ -139,6 +149,14 @@ fi
 cyan "Building ${BUILD_CONFIG}..."
 cmake --build "${BUILD_DIR}" --config "${BUILD_CONFIG}" --parallel
 
+# ── "rtsan": drive processBlock under the sanitizer ─────────────────────────
+
+if [ "$CONFIG" = "rtsan" ]; then
+    cyan "Running the real-time safety check..."
+    ctest --test-dir "${BUILD_DIR}" -C "${BUILD_CONFIG}" --output-on-failure \
+        || die "Real-time safety check failed"
+fi
+
 # ── Report output paths ─────────────────────────────────────────────────────
 
 ARTEFACTS="${BUILD_DIR}/HALO9_Player_artefacts/${BUILD_CONFIG}"